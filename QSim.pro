@@ -159,6 +159,8 @@ HEADERS  += ./QSimSourceCode/QSimToolBarGeometry.h
 HEADERS  += ./QSimSourceCode/QSimRigidBodyTabWidget.h
 HEADERS  += ./QSimSourceCode/QImageViewerDialog.h
 HEADERS  += ./QSimSourceCode/QImageViewerLabel.h
+HEADERS  += ./QSimSourceCode/QSimThumbnailCache.h
+HEADERS  += ./QSimSourceCode/QSimResourcePack.h
 HEADERS  += ./QSimSourceCode/QSimRigidBodyGeometryDialog.h
 HEADERS  += ./QSimSourceCode/QSimRigidBodyPositionDialog.h
 HEADERS  += ./QSimSourceCode/QSimRigidBodyVelocityDialog.h
@@ -176,15 +178,47 @@ SOURCES  += ./QSimSourceCode/QSimMainWindow.cpp
 SOURCES  += ./QSimSourceCode/QSimRigidBodyTabWidget.cpp
 SOURCES  += ./QSimSourceCode/QImageViewerDialog.cpp
 SOURCES  += ./QSimSourceCode/QImageViewerLabel.cpp
+SOURCES  += ./QSimSourceCode/QSimThumbnailCache.cpp
+SOURCES  += ./QSimSourceCode/QSimResourcePack.cpp
 SOURCES  += ./QSimSourceCode/QSimRigidBodyPositionDialog.cpp
 
 #--------------------------------------------------------------------
-# Resources that are compiled into the binary executable.
-# Info:  http://doc.qt.nokia.com/latest/resources.html
+# Resources are not compiled into the binary executable.  They are packed into an external binary resource file
+# (QSimResources.rcc, next to the executable) that QSimResourcePack memory-maps at startup, so images are only read when used.
+# To make it by hand:  rcc -binary QSimResources/QSimResourceCollectionFile.qrc -o QSimResources.rcc
+# Note: The pack is remade when the .qrc file or any of its images changes.
+# Info:  http://doc.qt.nokia.com/latest/resources.html  (External Binary Resources)
 # Public domain icons: http://www.apache.org/icons/
 # Public domain icons: http://tango.freedesktop.org/Tango_Desktop_Project
 #--------------------------------------------------------------------
-RESOURCES += ./QSimResources/QSimResourceCollectionFile.qrc
+QSIM_RESOURCE_COLLECTION  = $$PWD/QSimResources/QSimResourceCollectionFile.qrc
+QSIM_RESOURCE_IMAGES      = $$PWD/QSimApplicationIconC.ico
+QSIM_RESOURCE_IMAGES     += $$files($$PWD/QSimResources/ApachePublicDomainImages/*)
+QSIM_RESOURCE_IMAGES     += $$files($$PWD/QSimResources/MiscImages/*)
+QSIM_RESOURCE_IMAGES     += $$files($$PWD/QSimResources/TangoPublicDomainImages/*)
+QSIM_RESOURCE_IMAGES     += $$files($$PWD/QSimResources/TextureGraphics/*)
+
+# Visual Studio projects ignore extra compilers without a link step, so there the images are compiled into the program
+# (QSimResourcePack then uses them without a pack).  To use a pack with Visual Studio, make it by hand (see above).
+contains( TEMPLATE, vc.* ){
+   RESOURCES += $$QSIM_RESOURCE_COLLECTION
+   DEFINES   += QSIM_RESOURCES_COMPILED_IN
+}
+else{
+   qsimResourcePack.input     = QSIM_RESOURCE_COLLECTION
+   qsimResourcePack.output    = QSimResources.rcc
+   qsimResourcePack.depends   = $$QSIM_RESOURCE_IMAGES
+   qsimResourcePack.commands  = $$QMAKE_RCC -binary ${QMAKE_FILE_IN} -o ${QMAKE_FILE_OUT}
+   qsimResourcePack.CONFIG   += no_link target_predeps
+   QMAKE_EXTRA_COMPILERS     += qsimResourcePack
+
+   # A Macintosh bundle keeps the pack in Contents/Resources (where QSimResourcePack looks for it).
+   macx{
+      qsimResourcePackBundleData.files  = $$OUT_PWD/QSimResources.rcc
+      qsimResourcePackBundleData.path   = Contents/Resources
+      QMAKE_BUNDLE_DATA                += qsimResourcePackBundleData
+   }
+}
 
 #--------------------------------------------------------------------
 # List of additional include and library paths for Simbody.
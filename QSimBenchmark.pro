@@ -0,0 +1,60 @@
+#    File:  QSimBenchmark.pro
+# Purpose: Creates compiler files for the QSimBenchmark rendering benchmark (a console program).
+#    Info: http://doc.trolltech.com/4.2/qmake-tutorial.html
+# ----------------------------------------------------------------------------- 
+# QSim was developed with support from Simbios (NIH Center for Physics-Based    
+# Simulation of Biological Structures at Stanford) under NIH Roadmap for        
+# Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation 
+# in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   
+#                                                                               
+# To the extent possible under law, the author(s) and contributor(s) have       
+# dedicated all copyright and related and neighboring rights to this software   
+# to the public domain worldwide. This software is distributed without warranty.
+#                                                                               
+# Authors: Paul Mitiguy (2011)                                                  
+# Contributors: Ayman Habib, Michael Sherman                                    
+#                                                                               
+# Permission is granted, free of charge, to any person obtaining a copy of this 
+# software and associated documentation files (the "Software"), to deal in the  
+# Software without restriction, including without limitation the rights to use, 
+# copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   
+# the Software and to permit persons to whom the Software is furnished to do so.
+#                                                                               
+# Include this sentence, the above public domain and permission notices, and the
+# following disclaimer in all copies or substantial portions of the Software.   
+#                                                                               
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      
+# FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  
+# AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  
+# IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+# ----------------------------------------------------------------------------- 
+#   Usage:  qmake QSimBenchmark.pro,  build,  then run  QSimBenchmark [resultsFilename.json]
+#           The program renders synthetic scenes offscreen (no window) and writes frame times and memory use as JSON.
+#--------------------------------------------------------------------
+# Same source code, settings, and libraries as QSim, but with a different main function.
+#--------------------------------------------------------------------
+include(QSim.pro)
+TARGET  = QSimBenchmark
+SOURCES -= ./QSimSourceCode/QSimMain.cpp
+
+HEADERS  += ./QSimSourceCode/QSimRenderingBenchmark.h
+SOURCES  += ./QSimSourceCode/QSimRenderingBenchmark.cpp
+HEADERS  += ./QSimSourceCode/QSimBenchmarkSelfChecks.h
+SOURCES  += ./QSimSourceCode/QSimBenchmarkSelfChecks.cpp
+SOURCES  += ./QSimSourceCode/QSimBenchmarkMain.cpp
+
+#--------------------------------------------------------------------
+# Results are printed to the console, so build a console program (not a Windows application or Macintosh bundle).
+#--------------------------------------------------------------------
+CONFIG  -= windows
+CONFIG  += console
+macx{
+   CONFIG -= app_bundle
+}
+
+# GetProcessMemoryInfo (process memory use on Windows).
+win32{
+   LIBS += psapi.lib
+}
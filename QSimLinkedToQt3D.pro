@@ -38,10 +38,46 @@
 #--------------------------------------------------------------------
 HEADERS += ./QSimSourceCode/QSimMaterialType.h
 SOURCES += ./QSimSourceCode/QSimMaterialType.cpp
+HEADERS += ./QSimSourceCode/QSimMaterialLibrary.h
+SOURCES += ./QSimSourceCode/QSimMaterialLibrary.cpp
 HEADERS += ./QSimSourceCode/QSimGLViewWidget.h
 SOURCES += ./QSimSourceCode/QSimGLViewWidget.cpp
 HEADERS += ./QSimSourceCode/QSimSceneNode.h
 SOURCES += ./QSimSourceCode/QSimSceneNode.cpp
+HEADERS += ./QSimSourceCode/QSimBlockPool.h
+HEADERS += ./QSimSourceCode/QSimSceneFile.h
+HEADERS += ./QSimSourceCode/QSimMeshImporter.h
+HEADERS += ./QSimSourceCode/QSimMeshSceneNode.h
+HEADERS += ./QSimSourceCode/QSimClusteredMesh.h
+HEADERS += ./QSimSourceCode/QSimCompactMesh.h
+HEADERS += ./QSimSourceCode/QSimLevelOfDetailMesh.h
+HEADERS += ./QSimSourceCode/QSimMeshSimplifier.h
+HEADERS += ./QSimSourceCode/QSimTetrahedralMesh.h
+HEADERS += ./QSimSourceCode/QGLExtrudedPolygon.h
+HEADERS += ./QSimSourceCode/QSimSceneStore.h
+SOURCES += ./QSimSourceCode/QSimBlockPool.cpp
+SOURCES += ./QSimSourceCode/QSimSceneFile.cpp
+SOURCES += ./QSimSourceCode/QSimMeshImporter.cpp
+SOURCES += ./QSimSourceCode/QSimMeshSceneNode.cpp
+SOURCES += ./QSimSourceCode/QSimClusteredMesh.cpp
+SOURCES += ./QSimSourceCode/QSimCompactMesh.cpp
+SOURCES += ./QSimSourceCode/QSimLevelOfDetailMesh.cpp
+SOURCES += ./QSimSourceCode/QSimMeshSimplifier.cpp
+SOURCES += ./QSimSourceCode/QSimTetrahedralMesh.cpp
+SOURCES += ./QSimSourceCode/QGLExtrudedPolygon.cpp
+SOURCES += ./QSimSourceCode/QSimSceneStore.cpp
+HEADERS += ./QSimSourceCode/QSimSceneSelection.h
+SOURCES += ./QSimSourceCode/QSimSceneSelection.cpp
+HEADERS += ./QSimSourceCode/QSimRenderQueue.h
+SOURCES += ./QSimSourceCode/QSimRenderQueue.cpp
+HEADERS += ./QSimSourceCode/QSimTextureManager.h
+SOURCES += ./QSimSourceCode/QSimTextureManager.cpp
+HEADERS += ./QSimSourceCode/QSimOffscreenRenderer.h
+SOURCES += ./QSimSourceCode/QSimOffscreenRenderer.cpp
+HEADERS += ./QSimSourceCode/QSimFrameSequenceExporter.h
+SOURCES += ./QSimSourceCode/QSimFrameSequenceExporter.cpp
+HEADERS += ./QSimSourceCode/QSimFrameProfiler.h
+SOURCES += ./QSimSourceCode/QSimFrameProfiler.cpp
 HEADERS += ./QSimSourceCode/QGLRectangularBox.h
 SOURCES += ./QSimSourceCode/QGLRectangularBox.cpp
 HEADERS += ./QSimSourceCode/QGLEllipsoid.h
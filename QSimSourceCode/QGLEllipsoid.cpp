@@ -1,150 +1,232 @@
-//-----------------------------------------------------------------------------
-// File:     QGLEllipsoid.cpp
-// Class:    QGLEllipsoid
-// Parents:  None
-// Purpose:  Makes an ellipsoid for Qt/3D and OpenGL
-/* ---------------------------------------------------------------------------- *
-* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
-* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
-* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
-* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
-*                                                                               *
-* To the extent possible under law, the author(s) and contributor(s) have       *
-* dedicated all copyright and related and neighboring rights to this software   *
-* to the public domain worldwide. This software is distributed without warranty.*
-*                                                                               *
-* Authors: Paul Mitiguy (2011)                                                  *
-* Contributors: Ayman Habib, Michael Sherman                                    *
-*                                                                               *
-* Permission is granted, free of charge, to any person obtaining a copy of this *
-* software and associated documentation files (the "Software"), to deal in the  *
-* Software without restriction, including without limitation the rights to use, *
-* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
-* the Software and to permit persons to whom the Software is furnished to do so.*
-*                                                                               *
-* Include this sentence, the above public domain and permission notices, and the*
-* following disclaimer in all copies or substantial portions of the Software.   *
-*                                                                               *
-* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
-* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
-* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
-* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
-* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
-* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
-* ----------------------------------------------------------------------------- */
-#include "QGLEllipsoid.h"
-#include "qvector3darray.h"
-#include <QtCore/qmath.h>
-
-
-//------------------------------------------------------------------------------
-namespace QSim {
-
-
-//------------------------------------------------------------------------------
-QGLBuilder&  operator << ( QGLBuilder& builder, const QGLEllipsoid& ellipsoid )
-{
-   // Determine the number of slices and stacks to generate.
-   static int const numberOfSlicesForSubdivisionDepth[] = { 8, 8, 16, 16, 32, 32, 64, 64, 128, 128 };
-   static int const numberOfStacksForSubdivisionDepth[] = { 4, 8,  8, 16, 16, 32, 32, 64,  64, 128 };
-   const unsigned int numberOfSlices = numberOfSlicesForSubdivisionDepth[ ellipsoid.GetSubdivisionDepth() - 1 ];
-   const unsigned int numberOfStacks = numberOfStacksForSubdivisionDepth[ ellipsoid.GetSubdivisionDepth() - 1 ];
-
-   // Precompute sin/cos values for the slices.
-   const unsigned int maxSlices = 128 + 1;
-   const unsigned int maxStacks = 128 + 1;
-   qreal sliceSin[ maxSlices ];
-   qreal sliceCos[ maxSlices ];
-   for( unsigned int slice = 0;  slice < numberOfSlices;  ++slice )
-   {
-       const qreal angle = 2 * M_PI * (numberOfSlices - 1 - slice) / numberOfSlices;
-       sliceSin[slice] = qFastSin(angle);
-       sliceCos[slice] = qFastCos(angle);
-   }
-   // Join first and last slice.
-   sliceSin[numberOfSlices] = sliceSin[0];
-   sliceCos[numberOfSlices] = sliceCos[0];
-
-
-   // Precompute sin/cos values for the stacks.
-   qreal stackSin[ maxStacks ];
-   qreal stackCos[ maxStacks ];
-   for( unsigned int stack = 0;  stack <= numberOfStacks;  ++stack )
-   {
-       // Efficiently handle end-points which also ensure geometry comes to a point at the poles (no round-off).
-       if(      stack == 0 )               { stackSin[stack] = 0.0f;  stackCos[stack] =  1.0f; }
-       else if( stack == numberOfStacks )  { stackSin[stack] = 0.0f;  stackCos[stack] = -1.0f; }
-       else
-       {
-          const qreal angle = M_PI * stack / numberOfStacks;
-          stackSin[stack] = qFastSin(angle);
-          stackCos[stack] = qFastCos(angle);
-       }
-   }
-
-   // Half the dimensions of the ellipsoid for calculations below (centroid of ellipsoid is 0, 0, 0.)
-   const qreal xRadius = 0.5 * ellipsoid.GetXDiameter();
-   const qreal yRadius = 0.5 * ellipsoid.GetYDiameter();
-   const qreal zRadius = 0.5 * ellipsoid.GetZDiameter();
-   const qreal oneOverXRadiusSquared = 1.0 / (xRadius * xRadius);
-   const qreal oneOverYRadiusSquared = 1.0 / (yRadius * yRadius);
-   const qreal oneOverZRadiusSquared = 1.0 / (zRadius * zRadius);
-
-
-   // Create the stacks.
-   for( unsigned int stack = 0;  stack < numberOfStacks;  ++stack )
-   {
-      QGeometryData quadStrip;
-      for( unsigned int slice = 0;  slice <= numberOfSlices; ++slice )
-      {
-          // Equation for ellipsoid surface is x^2/xRadius^2 + y^2/yRadius^2 + z^2/zRadius^2 = 1
-          // Location of vertices can be specified in terms of "polar coordinates".
-          const qreal nextx = xRadius * stackSin[stack+1] * sliceSin[slice];
-          const qreal nexty = yRadius * stackSin[stack+1] * sliceCos[slice];
-          const qreal nextz = zRadius * stackCos[stack+1];
-          quadStrip.appendVertex( QVector3D( nextx, nexty, nextz) );
-
-          // Equation for ellipsoid surface is  Surface = x^2/xRadius^2 + y^2/yRadius^2 + z^2/zRadius^2 - 1
-          // Gradient for ellipsoid is  x/xRadius^2*Nx>  +  y/yRadius^2*Ny>  +  z/zRadius^2*Nz>
-          // Gradient for sphere simplifies to  x*Nx> + y*Ny> + z*Nz>
-          // const qreal nextGradientx =  stackSin[stack+1] * sliceSin[slice];
-          // const qreal nextGradienty =  stackSin[stack+1] * sliceCos[slice];
-          // const qreal nextGradientz =  stackCos[stack+1];
-          const qreal nextGradientx = nextx * oneOverXRadiusSquared;
-          const qreal nextGradienty = nexty * oneOverYRadiusSquared;
-          const qreal nextGradientz = nextz * oneOverZRadiusSquared;
-          const qreal nextGradientMagSquared = nextGradientx * nextGradientx + nextGradienty * nextGradienty + nextGradientz * nextGradientz;
-          const qreal oneOverNextGradientMagnitude = 1.0 / sqrt( nextGradientMagSquared );
-          quadStrip.appendNormal( oneOverNextGradientMagnitude * QVector3D( nextGradientx,  nextGradienty, nextGradientz ) );
-          quadStrip.appendTexCoord( QVector2D(1.0f - qreal(slice) / numberOfSlices, 1.0f - qreal(stack + 1) / numberOfStacks) );
-
-          const qreal x = xRadius * stackSin[stack] * sliceSin[slice];
-          const qreal y = yRadius * stackSin[stack] * sliceCos[slice];
-          const qreal z = zRadius * stackCos[stack];
-          quadStrip.appendVertex( QVector3D( x, y, z) );
-
-          // const qreal gradientx =  stackSin[stack] * sliceSin[slice];
-          // const qreal gradienty =  stackSin[stack] * sliceCos[slice];
-          // const qreal gradientz =  stackCos[stack];
-          const qreal gradientx = x * oneOverXRadiusSquared;
-          const qreal gradienty = y * oneOverYRadiusSquared;
-          const qreal gradientz = z * oneOverZRadiusSquared;
-          const qreal gradientMagSquared = gradientx * gradientx + gradienty * gradienty + gradientz * gradientz;
-          const qreal oneOverGradientMagnitude = 1.0 / sqrt( gradientMagSquared );
-          quadStrip.appendNormal( oneOverGradientMagnitude * QVector3D(  gradientx, gradienty, gradientz) );
-          quadStrip.appendTexCoord( QVector2D(1.0f - qreal(slice) / numberOfSlices,  1.0f - qreal(stack) / numberOfStacks) );
-      }
-
-      // The quad strip stretches from pole to pole.
-      builder.addQuadStrip( quadStrip );
-   }
-
-
-   return builder;
-}
-
-
-//------------------------------------------------------------------------------
-}  // End of namespace QSim
-
-
+//-----------------------------------------------------------------------------
+// File:     QGLEllipsoid.cpp
+// Class:    QGLEllipsoid
+// Parents:  None
+// Purpose:  Makes an ellipsoid for Qt/3D and OpenGL
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QGLEllipsoid.h"
+#include "qvector3darray.h"
+#include <QtCore/qmath.h>
+#include <cmath>
+
+// Use SSE to calculate 4 vertices at once (SSE is always available on x86-64).
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+   #define  QGLELLIPSOID_USE_SSE
+   #include <xmmintrin.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+static int const numberOfSlicesForSubdivisionDepth[] = { 8, 8, 16, 16, 32, 32, 64, 64, 128, 128 };
+static int const numberOfStacksForSubdivisionDepth[] = { 4, 8,  8, 16, 16, 32, 32, 64,  64, 128 };
+unsigned int  QGLEllipsoid::GetNumberOfSlices() const  { return numberOfSlicesForSubdivisionDepth[ this->GetSubdivisionDepth() - 1 ]; }
+unsigned int  QGLEllipsoid::GetNumberOfStacks() const  { return numberOfStacksForSubdivisionDepth[ this->GetSubdivisionDepth() - 1 ]; }
+
+
+//------------------------------------------------------------------------------
+void  QGLEllipsoid::CreatePackedMesh( QGLEllipsoidPackedMesh& packedMesh ) const
+{
+   // Determine the number of slices and stacks to generate.
+   const unsigned int numberOfSlices = this->GetNumberOfSlices();
+   const unsigned int numberOfStacks = this->GetNumberOfStacks();
+   const unsigned int numberOfVerticesPerRow = numberOfSlices + 1;
+
+   // Each row is stored as structure-of-arrays (one array for each of x, y, nx, ny, nz, u) so 4 vertices can be calculated at once.
+   // Arrays are padded to a multiple of 4 (the padding is calculated but not used).
+   const unsigned int maxVerticesPerRowPadded = 128 + 4;
+   const unsigned int numberOfVerticesPerRowPadded = (numberOfVerticesPerRow + 3) & ~3u;
+
+   // Precompute sin/cos values for the slices (and join first and last slice), and the u texture coordinate of each slice.
+   float sliceSin[ maxVerticesPerRowPadded ];
+   float sliceCos[ maxVerticesPerRowPadded ];
+   float sliceU[ maxVerticesPerRowPadded ];
+   for( unsigned int slice = 0;  slice < numberOfVerticesPerRowPadded;  ++slice )
+   {
+      const unsigned int sliceModulo = slice % numberOfSlices;
+      const qreal angle = 2 * M_PI * (numberOfSlices - 1 - sliceModulo) / numberOfSlices;
+      sliceSin[slice] = (float)qFastSin(angle);
+      sliceCos[slice] = (float)qFastCos(angle);
+      sliceU[slice] = 1.0f - float(slice) / numberOfSlices;
+   }
+
+   // Half the dimensions of the ellipsoid for calculations below (centroid of ellipsoid is 0, 0, 0.)
+   const float xRadius = 0.5f * (float)this->GetXDiameter();
+   const float yRadius = 0.5f * (float)this->GetYDiameter();
+   const float zRadius = 0.5f * (float)this->GetZDiameter();
+   const float oneOverXRadiusSquared = 1.0f / (xRadius * xRadius);
+   const float oneOverYRadiusSquared = 1.0f / (yRadius * yRadius);
+   const float oneOverZRadiusSquared = 1.0f / (zRadius * zRadius);
+
+   // Size the packed buffers once (no per-vertex appends).
+   const int numberOfFloatsPerVertex = QGLEllipsoidPackedMesh::GetNumberOfFloatsPerVertex();
+   packedMesh.myInterleavedVertices.resize( (numberOfStacks + 1) * numberOfVerticesPerRow * numberOfFloatsPerVertex );
+   float* packedVertex = packedMesh.myInterleavedVertices.data();
+
+   // Rows go from the north pole (stack 0) to the south pole (stack numberOfStacks).
+   float rowX[ maxVerticesPerRowPadded ],  rowY[ maxVerticesPerRowPadded ];
+   float rowNx[ maxVerticesPerRowPadded ], rowNy[ maxVerticesPerRowPadded ], rowNz[ maxVerticesPerRowPadded ];
+   for( unsigned int stack = 0;  stack <= numberOfStacks;  ++stack )
+   {
+      // Efficiently handle end-points which also ensure geometry comes to a point at the poles (no round-off).
+      float stackSin, stackCos;
+      if(      stack == 0 )               { stackSin = 0.0f;  stackCos =  1.0f; }
+      else if( stack == numberOfStacks )  { stackSin = 0.0f;  stackCos = -1.0f; }
+      else
+      {
+         const qreal angle = M_PI * stack / numberOfStacks;
+         stackSin = (float)qFastSin(angle);
+         stackCos = (float)qFastCos(angle);
+      }
+
+      // Equation for ellipsoid surface is x^2/xRadius^2 + y^2/yRadius^2 + z^2/zRadius^2 = 1
+      // Location of vertices can be specified in terms of "polar coordinates".  z is the same for every vertex in a row.
+      // Gradient for ellipsoid is  x/xRadius^2*Nx>  +  y/yRadius^2*Ny>  +  z/zRadius^2*Nz>  (normalized to get the unit normal).
+      const float z = zRadius * stackCos;
+      const float gradientz = z * oneOverZRadiusSquared;
+#ifdef QGLELLIPSOID_USE_SSE
+      const __m128 xRadiusTimesStackSin = _mm_set1_ps( xRadius * stackSin );
+      const __m128 yRadiusTimesStackSin = _mm_set1_ps( yRadius * stackSin );
+      const __m128 oneOverXRadiusSquared4 = _mm_set1_ps( oneOverXRadiusSquared );
+      const __m128 oneOverYRadiusSquared4 = _mm_set1_ps( oneOverYRadiusSquared );
+      const __m128 gradientz4 = _mm_set1_ps( gradientz );
+      const __m128 gradientzSquared4 = _mm_mul_ps( gradientz4, gradientz4 );
+      const __m128 one4 = _mm_set1_ps( 1.0f );
+      for( unsigned int slice = 0;  slice < numberOfVerticesPerRowPadded;  slice += 4 )
+      {
+         const __m128 x = _mm_mul_ps( xRadiusTimesStackSin, _mm_loadu_ps( sliceSin + slice ) );
+         const __m128 y = _mm_mul_ps( yRadiusTimesStackSin, _mm_loadu_ps( sliceCos + slice ) );
+         const __m128 gradientx = _mm_mul_ps( x, oneOverXRadiusSquared4 );
+         const __m128 gradienty = _mm_mul_ps( y, oneOverYRadiusSquared4 );
+         const __m128 gradientMagSquared = _mm_add_ps( _mm_add_ps( _mm_mul_ps( gradientx, gradientx ), _mm_mul_ps( gradienty, gradienty ) ), gradientzSquared4 );
+         const __m128 oneOverGradientMagnitude = _mm_div_ps( one4, _mm_sqrt_ps( gradientMagSquared ) );
+         _mm_storeu_ps( rowX + slice, x );
+         _mm_storeu_ps( rowY + slice, y );
+         _mm_storeu_ps( rowNx + slice, _mm_mul_ps( gradientx, oneOverGradientMagnitude ) );
+         _mm_storeu_ps( rowNy + slice, _mm_mul_ps( gradienty, oneOverGradientMagnitude ) );
+         _mm_storeu_ps( rowNz + slice, _mm_mul_ps( gradientz4, oneOverGradientMagnitude ) );
+      }
+#else
+      for( unsigned int slice = 0;  slice < numberOfVerticesPerRowPadded;  ++slice )
+      {
+         const float x = xRadius * stackSin * sliceSin[slice];
+         const float y = yRadius * stackSin * sliceCos[slice];
+         const float gradientx = x * oneOverXRadiusSquared;
+         const float gradienty = y * oneOverYRadiusSquared;
+         const float oneOverGradientMagnitude = 1.0f / std::sqrt( gradientx * gradientx + gradienty * gradienty + gradientz * gradientz );
+         rowX[slice] = x;
+         rowY[slice] = y;
+         rowNx[slice] = gradientx * oneOverGradientMagnitude;
+         rowNy[slice] = gradienty * oneOverGradientMagnitude;
+         rowNz[slice] = gradientz * oneOverGradientMagnitude;
+      }
+#endif
+
+      // Interleave the row into the packed buffer.
+      const float v = 1.0f - float(stack) / numberOfStacks;
+      for( unsigned int slice = 0;  slice < numberOfVerticesPerRow;  ++slice )
+      {
+         packedVertex[0] = rowX[slice];   packedVertex[1] = rowY[slice];   packedVertex[2] = z;
+         packedVertex[3] = rowNx[slice];  packedVertex[4] = rowNy[slice];  packedVertex[5] = rowNz[slice];
+         packedVertex[6] = sliceU[slice]; packedVertex[7] = v;
+         packedVertex += numberOfFloatsPerVertex;
+      }
+   }
+
+   // Each quad between two rows is two triangles.
+   // At the poles, one triangle of each quad has zero area (two of its vertices are at the pole) and is skipped.
+   packedMesh.myIndices.resize( 6 * numberOfSlices * (numberOfStacks - 1) );
+   quint32* index = packedMesh.myIndices.data();
+   for( unsigned int stack = 0;  stack < numberOfStacks;  ++stack )
+   {
+      const quint32 firstIndexInRow     = stack * numberOfVerticesPerRow;
+      const quint32 firstIndexInNextRow = firstIndexInRow + numberOfVerticesPerRow;
+      for( unsigned int slice = 0;  slice < numberOfSlices;  ++slice )
+      {
+         const quint32 current = firstIndexInRow + slice;
+         const quint32 next    = firstIndexInNextRow + slice;
+         if( stack != 0 )                  { index[0] = next;  index[1] = current;      index[2] = current + 1;  index += 3; }
+         if( stack != numberOfStacks - 1 ) { index[0] = next;  index[1] = current + 1;  index[2] = next + 1;     index += 3; }
+      }
+   }
+}
+
+
+//------------------------------------------------------------------------------
+QGLBuilder&  operator << ( QGLBuilder& builder, const QGLEllipsoid& ellipsoid )
+{
+   // Create a shared pool of (numberOfStacks+1) rows of (numberOfSlices+1) vertices, where row 0 is the north pole and the last row is the south pole.
+   // Each interior vertex is computed once and shared by the (up to 6) triangles that touch it.
+   // The first and last vertex of each row are at the same location, but remain separate because their texture coordinates differ (u=1 and u=0).
+   // Similarly, the vertices at each pole have different texture coordinates so the texture is not pinched to one point.
+   QGLEllipsoidPackedMesh packedMesh;
+   ellipsoid.CreatePackedMesh( packedMesh );
+
+   // Copy the packed data into arrays sized once (rather than appending each vertex individually).
+   const int numberOfVertices = packedMesh.GetNumberOfVertices();
+   const int numberOfFloatsPerVertex = QGLEllipsoidPackedMesh::GetNumberOfFloatsPerVertex();
+   QVector3DArray positions, normals;
+   QVector2DArray textureCoordinates;
+   QVector3D* position = positions.extend( numberOfVertices );
+   QVector3D* normal = normals.extend( numberOfVertices );
+   QVector2D* textureCoordinate = textureCoordinates.extend( numberOfVertices );
+   const float* packedVertex = packedMesh.myInterleavedVertices.constData();
+   for( int i = 0;  i < numberOfVertices;  ++i, packedVertex += numberOfFloatsPerVertex )
+   {
+      position[i] = QVector3D( packedVertex[0], packedVertex[1], packedVertex[2] );
+      normal[i] = QVector3D( packedVertex[3], packedVertex[4], packedVertex[5] );
+      textureCoordinate[i] = QVector2D( packedVertex[6], packedVertex[7] );
+   }
+
+   QGL::IndexArray indices;
+   const int numberOfIndices = packedMesh.myIndices.count();
+   indices.reserve( numberOfIndices );
+   for( int i = 0;  i < numberOfIndices;  ++i ) indices.append( packedMesh.myIndices[i] );
+
+   QGeometryData geometryData;
+   geometryData.appendVertexArray( positions );
+   geometryData.appendNormalArray( normals );
+   geometryData.appendTexCoordArray( textureCoordinates );
+   geometryData.appendIndices( indices );
+
+   // The builder uses the indices (rather than treating each group of 3 vertices as a triangle).
+   builder.addTriangles( geometryData );
+   return builder;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+
+
@@ -0,0 +1,571 @@
+//-----------------------------------------------------------------------------
+// File:     QGLExtrudedPolygon.cpp
+// Class:    QGLExtrudedPolygon
+// Parents:  None
+// Purpose:  Makes an extrusion or sweep of a 2D profile (with holes) along a path for Qt/3D and OpenGL
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <math.h>
+#include <QtGui/qquaternion.h>
+#include "QGLExtrudedPolygon.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+// The points of all loops of a polygon with holes, oriented so the interior is to the left of each edge (outer loop counter-clockwise, holes clockwise).
+// Edge i goes from point i to point myNext[i].  A point is above another if its y is greater, or its y is equal and its x is smaller, as if the plane
+// were slightly sheared.  So no two points are at the same height, and the sweep handles horizontal edges like any other (shearing does not change
+// the sign of Orientation, so every other test is exact).
+struct QSimPolygonWithHoles
+{
+   QVector<double>  myX, myY;
+   QVector<int>     myPrevious, myNext;
+
+   bool    IsAbove( const int a, const int b ) const                      { return myY[a] > myY[b] || ( myY[a] == myY[b] && myX[a] < myX[b] ); }
+   double  Orientation( const int a, const int b, const int c ) const     { return (myX[b]-myX[a])*(myY[c]-myY[a]) - (myY[b]-myY[a])*(myX[c]-myX[a]); }  // Positive if a, b, c turn left.
+   int     GetUpperPointOfEdge( const int edge ) const                    { return this->IsAbove( edge, myNext[edge] ) ? edge : myNext[edge]; }
+   int     GetLowerPointOfEdge( const int edge ) const                    { return this->IsAbove( edge, myNext[edge] ) ? myNext[edge] : edge; }
+};
+
+
+//------------------------------------------------------------------------------
+struct QSimPointIsAbove
+{
+   const QSimPolygonWithHoles*  myPolygon;
+   const int*                   myPointOfKey;   // Keys are points, or positions in a list of points.
+   bool  operator()( const int a, const int b ) const  { return myPointOfKey ? myPolygon->IsAbove( myPointOfKey[a], myPointOfKey[b] ) : myPolygon->IsAbove( a, b ); }
+};
+
+
+//------------------------------------------------------------------------------
+// Orders the edges crossed by the sweep line from left to right.  Key -1 stands for the query point, so the status can be searched for the edge left of it.
+// Edges in the status do not cross, so of two edges the upper point of the one that starts lower is tested against the other (or its lower point if the
+// upper points are shared).
+struct QSimSweepEdgeIsLeftOf
+{
+   const QSimPolygonWithHoles*  myPolygon;
+   const int*                   myQueryPoint;
+
+   bool  operator()( const int a, const int b ) const
+   {
+      const QSimPolygonWithHoles& polygon = *myPolygon;
+      if( a == b ) return false;
+      if( b < 0 )  return polygon.Orientation( polygon.GetLowerPointOfEdge(a), polygon.GetUpperPointOfEdge(a), *myQueryPoint ) < 0;
+      if( a < 0 )  return polygon.Orientation( polygon.GetLowerPointOfEdge(b), polygon.GetUpperPointOfEdge(b), *myQueryPoint ) > 0;
+      const int upperA = polygon.GetUpperPointOfEdge(a),  lowerA = polygon.GetLowerPointOfEdge(a);
+      const int upperB = polygon.GetUpperPointOfEdge(b),  lowerB = polygon.GetLowerPointOfEdge(b);
+      if( polygon.IsAbove( upperB, upperA ) )
+      {
+         double side = polygon.Orientation( lowerB, upperB, upperA );
+         if( side == 0 ) side = polygon.Orientation( lowerB, upperB, lowerA );
+         return side > 0;
+      }
+      double side = polygon.Orientation( lowerA, upperA, upperB );
+      if( side == 0 ) side = polygon.Orientation( lowerA, upperA, lowerB );
+      return side < 0;
+   }
+};
+
+
+//------------------------------------------------------------------------------
+// Triangulates a polygon with holes: a sweep from top to bottom adds diagonals that split it into y-monotone polygons, then each is triangulated.
+class QSimPolygonTriangulation
+{
+public:
+   QSimPolygonTriangulation( const QSimPolygonWithHoles& polygon ) : myPolygon(polygon), mySweepStatus(NULL), myQueryPoint(-1)  {;}
+
+   void  Triangulate( QVector<int>& triangleIndices );
+
+private:
+   typedef std::set<int,QSimSweepEdgeIsLeftOf>  QSimSweepStatus;
+
+   void  SweepToAddDiagonals();
+   void  AddDiagonal( const int a, const int helper );
+   void  InsertEdgeInSweepStatus( const int edge )  { myEdgesInSweepStatus[edge] = mySweepStatus->insert( edge ).first;  myHelperOfEdges[edge] = edge; }
+   void  RemoveEdgeFromSweepStatus( const int edge );
+   int   FindEdgeLeftOfPoint( const int point );
+   bool  HelperOfEdgeIsMergePoint( const int edge ) const  { return edge >= 0 && myHelperOfEdges[edge] >= 0 && myIsMergePoint[ myHelperOfEdges[edge] ]; }
+
+   int   GetNextPositionInFace( const int from, const int to ) const;
+   void  TriangulateMonotonePolygon( const QVector<int>& face, QVector<int>& triangleIndices ) const;
+   void  AppendTriangle( const int a, const int b, const int c, QVector<int>& triangleIndices ) const;
+
+   const QSimPolygonWithHoles&  myPolygon;
+
+   // Sweep status: the edges crossed by the sweep line (those going down, with the interior to their right), and each one's helper
+   // (the lowest point above the sweep line that can be connected to the edge's right without crossing an edge).
+   QSimSweepStatus*                           mySweepStatus;
+   int                                        myQueryPoint;
+   std::vector<QSimSweepStatus::iterator>     myEdgesInSweepStatus;
+   QVector<int>                               myHelperOfEdges;
+   QVector<bool>                              myIsMergePoint;
+
+   // Edges leaving each point (its boundary edge, then diagonals in both directions), and whether each has been walked as part of a face.
+   QVector< QVector<int> >   myEdgesLeavingPoints;
+   QVector< QVector<bool> >  myEdgesLeavingPointsAreInFace;
+};
+
+
+//------------------------------------------------------------------------------
+void  QSimPolygonTriangulation::Triangulate( QVector<int>& triangleIndices )
+{
+   const int numberOfPoints = myPolygon.myX.count();
+   myEdgesLeavingPoints.resize( numberOfPoints );
+   for( int i = 0;  i < numberOfPoints;  i++ )  myEdgesLeavingPoints[i].append( myPolygon.myNext[i] );
+   this->SweepToAddDiagonals();
+
+   // Walk each face of the boundary edges and diagonals (a monotone polygon, counter-clockwise) and triangulate it.
+   myEdgesLeavingPointsAreInFace.resize( numberOfPoints );
+   for( int i = 0;  i < numberOfPoints;  i++ )  myEdgesLeavingPointsAreInFace[i].fill( false, myEdgesLeavingPoints[i].count() );
+   QVector<int> face;
+   for( int i = 0;  i < numberOfPoints;  i++ )
+   {
+      for( int j = 0;  j < myEdgesLeavingPoints[i].count();  j++ )
+      {
+         face.clear();
+         int point = i, position = j;
+         while( position >= 0 && !myEdgesLeavingPointsAreInFace[point][position] )
+         {
+            myEdgesLeavingPointsAreInFace[point][position] = true;
+            face.append( point );
+            const int nextPoint = myEdgesLeavingPoints[point][position];
+            position = this->GetNextPositionInFace( point, nextPoint );
+            point = nextPoint;
+         }
+         if( face.count() >= 3 ) this->TriangulateMonotonePolygon( face, triangleIndices );
+      }
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimPolygonTriangulation::SweepToAddDiagonals()
+{
+   const int numberOfPoints = myPolygon.myX.count();
+   QVector<int> pointsFromTopToBottom( numberOfPoints );
+   for( int i = 0;  i < numberOfPoints;  i++ )  pointsFromTopToBottom[i] = i;
+   QSimPointIsAbove isAbove = { &myPolygon, NULL };
+   std::sort( pointsFromTopToBottom.begin(), pointsFromTopToBottom.end(), isAbove );
+
+   QSimSweepEdgeIsLeftOf isLeftOf = { &myPolygon, &myQueryPoint };
+   QSimSweepStatus sweepStatus( isLeftOf );
+   mySweepStatus = &sweepStatus;
+   myEdgesInSweepStatus.assign( numberOfPoints, sweepStatus.end() );
+   myHelperOfEdges.fill( -1, numberOfPoints );
+   myIsMergePoint.fill( false, numberOfPoints );
+
+   for( int i = 0;  i < numberOfPoints;  i++ )
+   {
+      // Edge "point" leaves the point and edge "previous" arrives at it.
+      const int point = pointsFromTopToBottom[i];
+      const int previous = myPolygon.myPrevious[point];
+      const int next = myPolygon.myNext[point];
+      const bool previousIsAbove = myPolygon.IsAbove( previous, point );
+      const bool nextIsAbove = myPolygon.IsAbove( next, point );
+      const bool isConvex = myPolygon.Orientation( previous, point, next ) > 0;
+
+      if( !previousIsAbove && !nextIsAbove )
+      {
+         // Split point (a reflex point with both edges below) is connected to the helper of the edge left of it.  Start points need no diagonal.
+         if( !isConvex )
+         {
+            const int leftEdge = this->FindEdgeLeftOfPoint( point );
+            if( leftEdge >= 0 ) { this->AddDiagonal( point, myHelperOfEdges[leftEdge] );  myHelperOfEdges[leftEdge] = point; }
+         }
+         this->InsertEdgeInSweepStatus( point );
+      }
+      else if( previousIsAbove && nextIsAbove )
+      {
+         // End or merge point (a reflex point with both edges above).  A merge point becomes the helper of the edge left of it, to be connected downward later.
+         if( this->HelperOfEdgeIsMergePoint( previous ) ) this->AddDiagonal( point, myHelperOfEdges[previous] );
+         this->RemoveEdgeFromSweepStatus( previous );
+         if( !isConvex )
+         {
+            myIsMergePoint[point] = true;
+            const int leftEdge = this->FindEdgeLeftOfPoint( point );
+            if( leftEdge >= 0 )
+            {
+               if( this->HelperOfEdgeIsMergePoint( leftEdge ) ) this->AddDiagonal( point, myHelperOfEdges[leftEdge] );
+               myHelperOfEdges[leftEdge] = point;
+            }
+         }
+      }
+      else if( previousIsAbove )
+      {
+         // Regular point on a chain going down, with the interior to its right.
+         if( this->HelperOfEdgeIsMergePoint( previous ) ) this->AddDiagonal( point, myHelperOfEdges[previous] );
+         this->RemoveEdgeFromSweepStatus( previous );
+         this->InsertEdgeInSweepStatus( point );
+      }
+      else
+      {
+         // Regular point on a chain going up, with the interior to its left.
+         const int leftEdge = this->FindEdgeLeftOfPoint( point );
+         if( leftEdge >= 0 )
+         {
+            if( this->HelperOfEdgeIsMergePoint( leftEdge ) ) this->AddDiagonal( point, myHelperOfEdges[leftEdge] );
+            myHelperOfEdges[leftEdge] = point;
+         }
+      }
+   }
+   mySweepStatus = NULL;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimPolygonTriangulation::AddDiagonal( const int a, const int helper )
+{
+   // Ignore diagonals that would repeat a boundary edge (only possible for degenerate input).
+   if( helper < 0 || helper == a || helper == myPolygon.myNext[a] || helper == myPolygon.myPrevious[a] ) return;
+   myEdgesLeavingPoints[a].append( helper );
+   myEdgesLeavingPoints[helper].append( a );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimPolygonTriangulation::RemoveEdgeFromSweepStatus( const int edge )
+{
+   if( myEdgesInSweepStatus[edge] == mySweepStatus->end() ) return;
+   mySweepStatus->erase( myEdgesInSweepStatus[edge] );
+   myEdgesInSweepStatus[edge] = mySweepStatus->end();
+}
+
+
+//------------------------------------------------------------------------------
+int  QSimPolygonTriangulation::FindEdgeLeftOfPoint( const int point )
+{
+   // The first edge that is not left of the point follows the one that is directly left of it (none if the input is not a valid polygon).
+   myQueryPoint = point;
+   QSimSweepStatus::iterator edgeNotLeftOfPoint = mySweepStatus->lower_bound( -1 );
+   if( edgeNotLeftOfPoint == mySweepStatus->begin() ) return -1;
+   return *(--edgeNotLeftOfPoint);
+}
+
+
+//------------------------------------------------------------------------------
+int  QSimPolygonTriangulation::GetNextPositionInFace( const int from, const int to ) const
+{
+   // With the face to the left, the next edge is the first one clockwise around "to" from the edge back to "from".
+   const QVector<int>& edgesLeavingTo = myEdgesLeavingPoints[to];
+   if( edgesLeavingTo.count() == 1 ) return 0;
+   const double angleBack = atan2( myPolygon.myY[from] - myPolygon.myY[to], myPolygon.myX[from] - myPolygon.myX[to] );
+   int nextPosition = -1;
+   double smallestClockwiseAngle = 0;
+   for( int i = 0;  i < edgesLeavingTo.count();  i++ )
+   {
+      const int point = edgesLeavingTo[i];
+      double clockwiseAngle = angleBack - atan2( myPolygon.myY[point] - myPolygon.myY[to], myPolygon.myX[point] - myPolygon.myX[to] );
+      while( clockwiseAngle <= 0 ) clockwiseAngle += 2*M_PI;
+      if( nextPosition < 0 || clockwiseAngle < smallestClockwiseAngle ) { nextPosition = i;  smallestClockwiseAngle = clockwiseAngle; }
+   }
+   return nextPosition;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimPolygonTriangulation::TriangulateMonotonePolygon( const QVector<int>& face, QVector<int>& triangleIndices ) const
+{
+   const int numberOfPoints = face.count();
+   if( numberOfPoints == 3 ) { this->AppendTriangle( face[0], face[1], face[2], triangleIndices );  return; }
+
+   // Counter-clockwise from the top point, the left chain goes down to the bottom point and the right chain comes back up.
+   QVector<int> positionsFromTopToBottom( numberOfPoints );
+   for( int i = 0;  i < numberOfPoints;  i++ )  positionsFromTopToBottom[i] = i;
+   QSimPointIsAbove isAbove = { &myPolygon, face.constData() };
+   std::sort( positionsFromTopToBottom.begin(), positionsFromTopToBottom.end(), isAbove );
+   const int top = positionsFromTopToBottom.first(),  bottom = positionsFromTopToBottom.last();
+   QVector<bool> isOnLeftChain( numberOfPoints, false );
+   for( int i = (top + 1) % numberOfPoints;  i != bottom;  i = (i + 1) % numberOfPoints )  isOnLeftChain[i] = true;
+
+   // Points not yet triangulated form a reflex chain on the stack.  A point on the other chain sees the whole stack.
+   // A point on the same chain sees stacked points while the chain turns convex.
+   QVector<int> stack;
+   stack.append( positionsFromTopToBottom[0] );
+   stack.append( positionsFromTopToBottom[1] );
+   for( int j = 2;  j < numberOfPoints - 1;  j++ )
+   {
+      const int position = positionsFromTopToBottom[j];
+      if( isOnLeftChain[position] != isOnLeftChain[ stack.last() ] )
+      {
+         while( stack.count() > 1 )
+         {
+            const int popped = stack.last();  stack.pop_back();
+            this->AppendTriangle( face[position], face[popped], face[ stack.last() ], triangleIndices );
+         }
+         stack.clear();
+         stack.append( positionsFromTopToBottom[j-1] );
+         stack.append( position );
+      }
+      else
+      {
+         int popped = stack.last();  stack.pop_back();
+         while( !stack.isEmpty() )
+         {
+            const double turn = myPolygon.Orientation( face[ stack.last() ], face[position], face[popped] );
+            if( isOnLeftChain[position] ? turn >= 0 : turn <= 0 ) break;
+            this->AppendTriangle( face[position], face[popped], face[ stack.last() ], triangleIndices );
+            popped = stack.last();  stack.pop_back();
+         }
+         stack.append( popped );
+         stack.append( position );
+      }
+   }
+   while( stack.count() > 1 )
+   {
+      const int popped = stack.last();  stack.pop_back();
+      this->AppendTriangle( face[bottom], face[popped], face[ stack.last() ], triangleIndices );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimPolygonTriangulation::AppendTriangle( const int a, const int b, const int c, QVector<int>& triangleIndices ) const
+{
+   const double orientation = myPolygon.Orientation( a, b, c );
+   if( orientation == 0 ) return;
+   triangleIndices.append( a );
+   triangleIndices.append( orientation > 0 ? b : c );
+   triangleIndices.append( orientation > 0 ? c : b );
+}
+
+
+//------------------------------------------------------------------------------
+static double  CalculateTwiceSignedArea( const QVector2DArray& loop )
+{
+   double twiceSignedArea = 0;
+   for( int i = 0, j = loop.count() - 1;  i < loop.count();  j = i++ )
+      twiceSignedArea += (double)loop[j].x() * loop[i].y() - (double)loop[i].x() * loop[j].y();
+   return twiceSignedArea;
+}
+
+
+//------------------------------------------------------------------------------
+static QVector2DArray  GetLoopWithOrientation( const QVector2DArray& loop, const bool isCounterClockwise )
+{
+   const bool isReversed = isCounterClockwise ? CalculateTwiceSignedArea(loop) < 0 : CalculateTwiceSignedArea(loop) > 0;
+   if( !isReversed ) return loop;
+   QVector2DArray reversedLoop;
+   reversedLoop.reserve( loop.count() );
+   for( int i = loop.count() - 1;  i >= 0;  i-- )  reversedLoop.append( loop[i] );
+   return reversedLoop;
+}
+
+
+//------------------------------------------------------------------------------
+bool  QGLExtrudedPolygon::TriangulatePolygonWithHoles( const QList<QVector2DArray>& loops, QVector<int>& triangleIndices )
+{
+   triangleIndices.clear();
+   if( loops.isEmpty() ) return false;
+
+   // Concatenate the loops, linking each one's points so the interior is to the left of every edge.
+   QSimPolygonWithHoles polygon;
+   for( int l = 0;  l < loops.count();  l++ )
+   {
+      const QVector2DArray& loop = loops[l];
+      const int numberOfPointsInLoop = loop.count();
+      if( numberOfPointsInLoop < 3 ) return false;
+      const bool isReversed = ( l == 0 ) ? CalculateTwiceSignedArea(loop) < 0 : CalculateTwiceSignedArea(loop) > 0;
+      const int first = polygon.myX.count();
+      for( int i = 0;  i < numberOfPointsInLoop;  i++ )
+      {
+         const int previous = first + (i + numberOfPointsInLoop - 1) % numberOfPointsInLoop;
+         const int next = first + (i + 1) % numberOfPointsInLoop;
+         polygon.myX.append( loop[i].x() );
+         polygon.myY.append( loop[i].y() );
+         polygon.myPrevious.append( isReversed ? next : previous );
+         polygon.myNext.append( isReversed ? previous : next );
+      }
+   }
+
+   QSimPolygonTriangulation triangulation( polygon );
+   triangulation.Triangulate( triangleIndices );
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+QVector2DArray  QGLExtrudedPolygon::CreateCircularLoop( const QVector2D& center, const qreal radius, const int numberOfPoints )
+{
+   QVector2DArray loop;
+   loop.reserve( numberOfPoints );
+   for( int i = 0;  i < numberOfPoints;  i++ )
+   {
+      const qreal angle = 2 * M_PI * i / numberOfPoints;
+      loop.append( center + radius * QVector2D( cos(angle), sin(angle) ) );
+   }
+   return loop;
+}
+
+
+//------------------------------------------------------------------------------
+QGeometryData  QGLExtrudedPolygon::CreateGeometryData() const
+{
+   QGeometryData geometry;
+   const int numberOfStations = myPath.count();
+   if( numberOfStations < 2 ) return geometry;
+
+   // Outer boundary counter-clockwise and holes clockwise, so the outward side of every profile edge is to its right.
+   QList<QVector2DArray> loops;
+   loops.append( GetLoopWithOrientation( myOuterBoundary, true ) );
+   for( int i = 0;  i < myHoles.count();  i++ )  loops.append( GetLoopWithOrientation( myHoles[i], false ) );
+   QVector<int> capTriangleIndices;
+   if( myHasCaps && !TriangulatePolygonWithHoles( loops, capTriangleIndices ) ) return geometry;
+   QVector2DArray profile;
+   QVector<int> nextInLoop;
+   for( int l = 0;  l < loops.count();  l++ )
+   {
+      const int first = profile.count(),  numberOfPointsInLoop = loops[l].count();
+      if( numberOfPointsInLoop < 3 ) return geometry;
+      profile.append( loops[l].constData(), numberOfPointsInLoop );
+      for( int i = 0;  i < numberOfPointsInLoop;  i++ )  nextInLoop.append( first + (i + 1) % numberOfPointsInLoop );
+   }
+   const int numberOfProfilePoints = profile.count();
+
+   // Each profile point has one wall vertex per station if the wall is smooth there, otherwise one for each adjacent edge.
+   QVector<int> previousInLoop( numberOfProfilePoints );
+   for( int i = 0;  i < numberOfProfilePoints;  i++ )  previousInLoop[ nextInLoop[i] ] = i;
+   QVector2DArray edgeNormals;
+   edgeNormals.resize( numberOfProfilePoints );
+   for( int i = 0;  i < numberOfProfilePoints;  i++ )
+   {
+      const QVector2D edge = profile[ nextInLoop[i] ] - profile[i];
+      edgeNormals[i] = QVector2D( edge.y(), -edge.x() ).normalized();
+   }
+   const qreal cosineOfSmoothingAngle = cos( mySmoothingAngleInDegrees * M_PI / 180.0 );
+   QVector<int> slotArriving( numberOfProfilePoints ), slotLeaving( numberOfProfilePoints );
+   QVector2DArray normalArriving, normalLeaving;
+   normalArriving.resize( numberOfProfilePoints );
+   normalLeaving.resize( numberOfProfilePoints );
+   int numberOfVerticesPerStation = 0;
+   for( int i = 0;  i < numberOfProfilePoints;  i++ )
+   {
+      const QVector2D& normalOfEdgeArriving = edgeNormals[ previousInLoop[i] ];
+      const QVector2D& normalOfEdgeLeaving = edgeNormals[i];
+      const bool isSmooth = QVector2D::dotProduct( normalOfEdgeArriving, normalOfEdgeLeaving ) >= cosineOfSmoothingAngle;
+      slotArriving[i] = numberOfVerticesPerStation++;
+      slotLeaving[i] = isSmooth ? slotArriving[i] : numberOfVerticesPerStation++;
+      normalArriving[i] = isSmooth ? (normalOfEdgeArriving + normalOfEdgeLeaving).normalized() : normalOfEdgeArriving;
+      normalLeaving[i] = isSmooth ? normalArriving[i] : normalOfEdgeLeaving;
+   }
+
+   // Frame at each station: the tangent bisects the path's direction, and the profile's axes are rotated from the previous station by the
+   // smallest rotation between tangents (parallel transport), so the profile does not twist.
+   QVector3DArray tangents, xAxes, yAxes;
+   tangents.resize( numberOfStations );
+   xAxes.resize( numberOfStations );
+   yAxes.resize( numberOfStations );
+   for( int k = 0;  k < numberOfStations;  k++ )
+   {
+      const QVector3D direction = myPath[ qMin(k+1, numberOfStations-1) ] - myPath[ qMax(k-1, 0) ];
+      tangents[k] = direction.isNull() ? ( k > 0 ? tangents[k-1] : QVector3D(0,0,1) ) : direction.normalized();
+   }
+   QVector3D xAxis = QVector3D(1,0,0) - QVector3D::dotProduct( QVector3D(1,0,0), tangents[0] ) * tangents[0];
+   if( xAxis.lengthSquared() < 1.0E-6 ) xAxis = QVector3D(0,1,0) - QVector3D::dotProduct( QVector3D(0,1,0), tangents[0] ) * tangents[0];
+   for( int k = 0;  k < numberOfStations;  k++ )
+   {
+      if( k > 0 )
+      {
+         const QVector3D axis = QVector3D::crossProduct( tangents[k-1], tangents[k] );
+         const qreal sine = axis.length(),  cosine = QVector3D::dotProduct( tangents[k-1], tangents[k] );
+         if( sine > 1.0E-9 ) xAxis = QQuaternion::fromAxisAndAngle( axis / sine, atan2(sine, cosine) * 180.0 / M_PI ).rotatedVector( xAxis );
+         xAxis -= QVector3D::dotProduct( xAxis, tangents[k] ) * tangents[k];
+      }
+      xAxes[k] = xAxis = xAxis.normalized();
+      yAxes[k] = QVector3D::crossProduct( tangents[k], xAxis );
+   }
+
+   // Walls, written straight into the vertex and index arrays.
+   const int numberOfCapVertices = myHasCaps ? 2 * numberOfProfilePoints : 0;
+   QVector3DArray positions, normals;
+   positions.reserve( numberOfStations * numberOfVerticesPerStation + numberOfCapVertices );
+   normals.reserve( numberOfStations * numberOfVerticesPerStation + numberOfCapVertices );
+   for( int k = 0;  k < numberOfStations;  k++ )
+   {
+      for( int i = 0;  i < numberOfProfilePoints;  i++ )
+      {
+         const QVector3D position = myPath[k] + profile[i].x() * xAxes[k] + profile[i].y() * yAxes[k];
+         positions.append( position );
+         normals.append( normalArriving[i].x() * xAxes[k] + normalArriving[i].y() * yAxes[k] );
+         if( slotLeaving[i] == slotArriving[i] ) continue;
+         positions.append( position );
+         normals.append( normalLeaving[i].x() * xAxes[k] + normalLeaving[i].y() * yAxes[k] );
+      }
+   }
+   QGL::IndexArray indices;
+   indices.reserve( 6 * (numberOfStations - 1) * numberOfProfilePoints + 2 * capTriangleIndices.count() );
+   for( int k = 0;  k < numberOfStations - 1;  k++ )
+   {
+      const int station = k * numberOfVerticesPerStation,  nextStation = station + numberOfVerticesPerStation;
+      for( int i = 0;  i < numberOfProfilePoints;  i++ )
+      {
+         const int a0 = station + slotLeaving[i],      b0 = station + slotArriving[ nextInLoop[i] ];
+         const int a1 = nextStation + slotLeaving[i],  b1 = nextStation + slotArriving[ nextInLoop[i] ];
+         indices.append( a0, b0, b1 );
+         indices.append( a0, b1, a1 );
+      }
+   }
+
+   // Caps at both ends (counter-clockwise in the profile is counter-clockwise viewed from ahead of the path, so the first cap is reversed).
+   if( myHasCaps )
+   {
+      const int firstCap = positions.count(),  lastCap = firstCap + numberOfProfilePoints;
+      const int lastStation = numberOfStations - 1;
+      for( int i = 0;  i < numberOfProfilePoints;  i++ )
+      {
+         positions.append( myPath[0] + profile[i].x() * xAxes[0] + profile[i].y() * yAxes[0] );
+         normals.append( -tangents[0] );
+      }
+      for( int i = 0;  i < numberOfProfilePoints;  i++ )
+      {
+         positions.append( myPath[lastStation] + profile[i].x() * xAxes[lastStation] + profile[i].y() * yAxes[lastStation] );
+         normals.append( tangents[lastStation] );
+      }
+      for( int i = 0;  i + 2 < capTriangleIndices.count();  i += 3 )
+      {
+         indices.append( firstCap + capTriangleIndices[i], firstCap + capTriangleIndices[i+2], firstCap + capTriangleIndices[i+1] );
+         indices.append( lastCap + capTriangleIndices[i], lastCap + capTriangleIndices[i+1], lastCap + capTriangleIndices[i+2] );
+      }
+   }
+
+   geometry.appendVertexArray( positions );
+   geometry.appendNormalArray( normals );
+   geometry.appendIndices( indices );
+   return geometry;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
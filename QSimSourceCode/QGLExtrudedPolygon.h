@@ -0,0 +1,101 @@
+//-----------------------------------------------------------------------------
+// File:     QGLExtrudedPolygon.h
+// Class:    QGLExtrudedPolygon
+// Parents:  None
+// Purpose:  Makes an extrusion or sweep of a 2D profile (with holes) along a path for Qt/3D and OpenGL
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QGLEXTRUDEDPOLYGON_H__
+#define  QGLEXTRUDEDPOLYGON_H__
+#include "qt3dglobal.h"
+#include <QtGui/qvector2d.h>
+#include "qvector2darray.h"
+#include "qvector3darray.h"
+#include "qgeometrydata.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+class QGLExtrudedPolygon
+{
+
+public:
+   // Constructors and destructors.  The profile is a closed loop of 2D points (the last point is not a repeat of the first), either orientation.
+   // The path has at least 2 points.  At each path point the profile's x and y axes are perpendicular to the path (its z axis is the path's direction),
+   // and they are carried along the path without twisting.  A path from (0,0,0) to (0,0,h) is a plain extrusion whose x and y axes are the profile's.
+   QGLExtrudedPolygon( const QVector2DArray& outerBoundary, const QVector3DArray& path ) : myOuterBoundary(outerBoundary), myPath(path), mySmoothingAngleInDegrees(30), myHasCaps(true) {;}
+
+   // Holes are closed loops inside the outer boundary (either orientation) that do not touch it or each other.
+   void  AddHole( const QVector2DArray& hole )  { myHoles.append( hole ); }
+
+   // Set/Get the profile, holes, and path.
+   const QVector2DArray&         GetOuterBoundary() const  { return myOuterBoundary; }
+   const QList<QVector2DArray>&  GetHoles() const          { return myHoles; }
+   const QVector3DArray&         GetPath() const           { return myPath; }
+
+   // Walls are smooth shaded across profile corners of less than this angle (default 30 degrees), so finely sampled curves look round.
+   void   SetSmoothingAngleInDegrees( const qreal smoothingAngleInDegrees )  { mySmoothingAngleInDegrees = smoothingAngleInDegrees; }
+   qreal  GetSmoothingAngleInDegrees() const                                { return mySmoothingAngleInDegrees; }
+
+   // Whether the ends of the sweep are closed by the triangulated profile (default is true).
+   void  SetHasCaps( const bool hasCaps )  { myHasCaps = hasCaps; }
+   bool  GetHasCaps() const                { return myHasCaps; }
+
+   // Create the walls and caps as indexed triangles with normals (outward, counter-clockwise when viewed from outside).
+   // Returns empty geometry if the profile, a hole, or the path has too few points.
+   QGeometryData  CreateGeometryData() const;
+
+   // Triangulate the region inside the first loop and outside the others in O(n log n) time for n points: a plane sweep splits the region
+   // into y-monotone polygons (adding diagonals at split and merge vertices), and each is triangulated in linear time.
+   // Indices refer to the points of all loops in order.  Triangles are counter-clockwise.  Returns false if a loop has fewer than 3 points.
+   static bool  TriangulatePolygonWithHoles( const QList<QVector2DArray>& loops, QVector<int>& triangleIndices );
+
+   // Points evenly spaced counter-clockwise around a circle (a profile or hole).
+   static QVector2DArray  CreateCircularLoop( const QVector2D& center, const qreal radius, const int numberOfPoints );
+
+private:
+   // Profile, holes, and path.
+   QVector2DArray         myOuterBoundary;
+   QList<QVector2DArray>  myHoles;
+   QVector3DArray         myPath;
+   qreal                  mySmoothingAngleInDegrees;
+   bool                   myHasCaps;
+
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QGLEXTRUDEDPOLYGON_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+//-----------------------------------------------------------------------------
+// File:     QSimBenchmarkMain.cpp
+// Class:    None
+// Parents:  None
+// Purpose:  Entry point for the QSimBenchmark program (see QSimBenchmark.pro), which writes rendering benchmark results as JSON.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <QtCore>
+#include <QtGui>
+#include "CppStandardHeaders.h"
+#include "QSimRenderingBenchmark.h"
+#include "QSimBenchmarkSelfChecks.h"
+#include "QSimResourcePack.h"
+
+
+//-----------------------------------------------------------------------------
+// Usage:  QSimBenchmark [resultsFilename.json]
+//-----------------------------------------------------------------------------
+int  main( int numberOfCommandLineArguments, char *arrayOfCommandLineArguments[] )
+{
+   // QApplication is needed for OpenGL (rendering is offscreen, so no window is shown).
+   QApplication app( numberOfCommandLineArguments, arrayOfCommandLineArguments );
+   const QString jsonFilename = numberOfCommandLineArguments > 1 ? QString( arrayOfCommandLineArguments[1] ) : QString( "QSimBenchmarkResults.json" );
+
+   // The built-in textures are in the resource pack (without it, the textured scenes cannot be measured).
+   if( !QSim::QSimResourcePack::GetQSimResourcePack().OpenDefaultResourcePack() )
+   {
+      QTextStream( stdout ) << "Cannot open the resource pack " << QSim::QSimResourcePack::GetDefaultResourcePackFilename() << " (it must be next to the program or in its parent folder)\n";
+      return 1;
+   }
+
+   // Scene files must keep every object where it was drawn and profiles must be triangulated exactly, so a failure of these checks is also a failure of the program.
+   QString errorMessage;
+   if( !QSim::QSimBenchmarkSelfChecks::CheckSceneFileRoundTrip( errorMessage ) )
+   {
+      QTextStream( stdout ) << "Scene file check failed: " << errorMessage << "\n";
+      return 1;
+   }
+   if( !QSim::QSimBenchmarkSelfChecks::CheckPolygonTriangulation( errorMessage ) )
+   {
+      QTextStream( stdout ) << "Polygon triangulation check failed: " << errorMessage << "\n";
+      return 1;
+   }
+
+   // The value returned by the main function is the exit status of the program (0 means success).
+   QSim::QSimRenderingBenchmark renderingBenchmark;
+   const bool benchmarkSucceeded = renderingBenchmark.RunAllRenderingBenchmarks( jsonFilename );
+   QTextStream( stdout ) << ( benchmarkSucceeded ? "Wrote " + jsonFilename : QString("Benchmark failed (offscreen rendering is unavailable, a texture cannot be decoded, or the results file cannot be written)") ) << "\n";
+   return benchmarkSucceeded ? 0 : 1;
+}
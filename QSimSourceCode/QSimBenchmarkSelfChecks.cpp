@@ -0,0 +1,194 @@
+//-----------------------------------------------------------------------------
+// File:     QSimBenchmarkSelfChecks.cpp
+// Class:    QSimBenchmarkSelfChecks
+// Parents:  None
+// Purpose:  Checks run by QSimBenchmark before measuring (results that are wrong make the measurements meaningless).
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimBenchmarkSelfChecks.h"
+#include "QSimGLViewWidget.h"
+#include "QSimSceneNode.h"
+#include "QSimSceneFile.h"
+#include "QGLExtrudedPolygon.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+void  QSimBenchmarkSelfChecks::UniteWorldBoundingBoxOfVertices( const QGLSceneNode& sceneNode, const QMatrix4x4& transform, QBox3D& boundingBox )
+{
+   // transform is the matrix this QGLSceneNode's vertices are drawn with (including its own transform).
+   const QGeometryData geometry = sceneNode.geometry();
+   const QGL::IndexArray indices = geometry.indices();
+   for( int i = sceneNode.start();  i >= 0 && i < sceneNode.start() + sceneNode.count();  i++ )
+   {
+      const int vertexIndex = indices.count() > 0 ? ( i < indices.count() ? (int)indices.at(i) : -1 ) : i;
+      if( vertexIndex >= 0 && vertexIndex < geometry.count() ) boundingBox.unite( transform.map( geometry.vertexAt( vertexIndex ) ) );
+   }
+   const QList<QGLSceneNode*> childSceneNodes = sceneNode.children();
+   for( QList<QGLSceneNode*>::const_iterator it = childSceneNodes.constBegin();  it != childSceneNodes.constEnd();  ++it )
+      if( QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( **it ) == NULL ) QSimBenchmarkSelfChecks::UniteWorldBoundingBoxOfVertices( **it, transform * (*it)->transform(), boundingBox );
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimBenchmarkSelfChecks::CheckSceneFileRoundTrip( QString& errorMessage )
+{
+   // A rotated and scaled box whose QGLSceneNode also has a local transform (as an importer may set), and a rotated tetrahedron
+   // attached to the box through a QGLSceneNode that is rotated and moved (the tetrahedron is not symmetric, so any lost rotation shows).
+   QSimGLViewWidget writtenGLViewWidget( NULL, false );
+   QSimSceneNode* box = writtenGLViewWidget.AddSceneNodeGeometryRectangularBox( writtenGLViewWidget.GetMostParentSceneNode(), false, 1.0, 0.5, 0.25 );
+   box->SetRotationAngleInDegreesAndVector( 30.0, QVector3D(0,0,1) );
+   box->SetPosition( QVector3D(1,2,3) );
+   box->SetScale( 2.0 );
+   QMatrix4x4 boxLocalTransform;
+   boxLocalTransform.rotate( 20.0, QVector3D(1,0,0) );
+   QSimSceneNode::SetLocalTransformOfQGLSceneNode( box->GetQGLSceneNode(), boxLocalTransform );
+   QGLSceneNode* transformSceneNode = new QGLSceneNode;
+   QMatrix4x4 transformFromBox;
+   transformFromBox.translate( 0.5, 0.0, -1.0 );
+   transformFromBox.rotate( 45.0, QVector3D(0,1,0) );
+   QSimSceneNode::SetLocalTransformOfQGLSceneNode( *transformSceneNode, transformFromBox );
+   box->GetQGLSceneNode().addNode( transformSceneNode );
+   QSimSceneNode* tetrahedron = writtenGLViewWidget.AddSceneNodeGeometryTetrahedron( *transformSceneNode, false, QVector3D(0,0,0), QVector3D(1,0,0), QVector3D(0,1,0), QVector3D(0,0,1) );
+   tetrahedron->SetRotationAngleInDegreesAndVector( 60.0, QVector3D(1,1,0) );
+   tetrahedron->SetPosition( QVector3D(0,1,0) );
+
+   // Write and read the scene (parents are before children in both, so the objects are in the same order).
+   const QString filename = QDir::temp().absoluteFilePath( "QSimSceneFileRoundTripCheck." + QSimSceneFile::GetSceneFileSuffix() );
+   QSimGLViewWidget readGLViewWidget( NULL, false );
+   QSimSceneFile writtenSceneFile( writtenGLViewWidget ),  readSceneFile( readGLViewWidget );
+   const bool isFileWrittenAndRead = writtenSceneFile.WriteSceneFile( filename, NULL ) && readSceneFile.ReadSceneFile( filename, NULL );
+   QFile::remove( filename );
+   if( !isFileWrittenAndRead ) { errorMessage = QObject::tr("Cannot write or read %1.").arg( filename );  return false; }
+   QList<QSimSceneNode*> writtenSceneNodes, readSceneNodes;
+   QList<int> writtenParentObjectIndices, readParentObjectIndices;
+   QSimSceneFile::AppendQSimSceneNodesParentsFirst( writtenGLViewWidget.GetMostParentSceneNode(), -1, writtenSceneNodes, writtenParentObjectIndices );
+   QSimSceneFile::AppendQSimSceneNodesParentsFirst( readGLViewWidget.GetMostParentSceneNode(), -1, readSceneNodes, readParentObjectIndices );
+   if( readSceneNodes.count() != writtenSceneNodes.count() || readParentObjectIndices != writtenParentObjectIndices ) { errorMessage = QObject::tr("The objects or their parents changed.");  return false; }
+
+   // Each object's vertices must be drawn in the same place (its world matrix followed by its QGLSceneNode's own transform).
+   for( int i=0;  i < writtenSceneNodes.count();  i++ )
+   {
+      QBox3D writtenBoundingBox, readBoundingBox;
+      const QGLSceneNode& writtenSceneNode = writtenSceneNodes[i]->GetQGLSceneNode();
+      const QGLSceneNode& readSceneNode = readSceneNodes[i]->GetQGLSceneNode();
+      QSimBenchmarkSelfChecks::UniteWorldBoundingBoxOfVertices( writtenSceneNode, writtenSceneNodes[i]->GetWorldMatrix() * writtenSceneNode.transform(), writtenBoundingBox );
+      QSimBenchmarkSelfChecks::UniteWorldBoundingBoxOfVertices( readSceneNode, readSceneNodes[i]->GetWorldMatrix() * readSceneNode.transform(), readBoundingBox );
+      const qreal tolerance = 1.0E-4;
+      if( writtenBoundingBox.isNull() || (readBoundingBox.minimum() - writtenBoundingBox.minimum()).length() > tolerance || (readBoundingBox.maximum() - writtenBoundingBox.maximum()).length() > tolerance )
+      {
+         errorMessage = QObject::tr("Object %1 (%2) moved when its scene was written and read.").arg(i).arg( writtenSceneNodes[i]->objectName() );
+         return false;
+      }
+   }
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+static double  CalculateAreaOfLoop( const QVector2DArray& loop )
+{
+   double twiceSignedArea = 0;
+   for( int i = 0, j = loop.count() - 1;  i < loop.count();  j = i++ )
+      twiceSignedArea += (double)loop[j].x() * loop[i].y() - (double)loop[i].x() * loop[j].y();
+   return 0.5 * fabs( twiceSignedArea );
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimBenchmarkSelfChecks::CheckPolygonTriangulation( QString& errorMessage )
+{
+   // A star (every other point is indented, so most points are reflex) around two round holes, one of them clockwise, and a square hole
+   // whose horizontal edges test points at the same height.
+   QList<QVector2DArray> loops;
+   QVector2DArray star;
+   for( int i = 0;  i < 40;  i++ )
+   {
+      const qreal angle = 2 * M_PI * i / 40,  radius = ( i % 2 == 0 ) ? 1.0 : 0.6;
+      star.append( radius * cos(angle), radius * sin(angle) );
+   }
+   loops.append( star );
+   loops.append( QGLExtrudedPolygon::CreateCircularLoop( QVector2D( 0.25, 0 ), 0.15, 24 ) );
+   const QVector2DArray roundHole = QGLExtrudedPolygon::CreateCircularLoop( QVector2D( -0.25, 0 ), 0.15, 24 );
+   QVector2DArray clockwiseRoundHole;
+   for( int i = roundHole.count() - 1;  i >= 0;  i-- ) clockwiseRoundHole.append( roundHole[i] );
+   loops.append( clockwiseRoundHole );
+   QVector2DArray squareHole;
+   squareHole.append( -0.05, 0.2 );
+   squareHole.append(  0.05, 0.2 );
+   squareHole.append(  0.05, 0.3 );
+   squareHole.append( -0.05, 0.3 );
+   loops.append( squareHole );
+
+   int numberOfPoints = 0;
+   double expectedArea = CalculateAreaOfLoop( loops[0] );
+   QVector2DArray points;
+   for( int l = 0;  l < loops.count();  l++ )
+   {
+      numberOfPoints += loops[l].count();
+      if( l > 0 ) expectedArea -= CalculateAreaOfLoop( loops[l] );
+      for( int i = 0;  i < loops[l].count();  i++ ) points.append( loops[l][i] );
+   }
+
+   QVector<int> triangleIndices;
+   if( !QGLExtrudedPolygon::TriangulatePolygonWithHoles( loops, triangleIndices ) ) { errorMessage = QObject::tr("the polygon was not triangulated");  return false; }
+   const int numberOfHoles = loops.count() - 1;
+   const int expectedNumberOfTriangles = numberOfPoints + 2 * numberOfHoles - 2;
+   if( triangleIndices.count() != 3 * expectedNumberOfTriangles )
+   {
+      errorMessage = QObject::tr("%1 triangles instead of %2").arg( triangleIndices.count() / 3.0 ).arg( expectedNumberOfTriangles );
+      return false;
+   }
+
+   // Triangles are counter-clockwise, so each one's signed area is positive.
+   double area = 0;
+   for( int i = 0;  i + 2 < triangleIndices.count();  i += 3 )
+   {
+      for( int j = 0;  j < 3;  j++ )
+         if( triangleIndices[i+j] < 0 || triangleIndices[i+j] >= numberOfPoints ) { errorMessage = QObject::tr("triangle %1 has an index out of range").arg( i/3 );  return false; }
+      const QVector2D a = points[ triangleIndices[i] ],  b = points[ triangleIndices[i+1] ],  c = points[ triangleIndices[i+2] ];
+      const double twiceSignedArea = (double)(b.x()-a.x()) * (c.y()-a.y()) - (double)(b.y()-a.y()) * (c.x()-a.x());
+      if( twiceSignedArea <= 0 ) { errorMessage = QObject::tr("triangle %1 is not counter-clockwise").arg( i/3 );  return false; }
+      area += 0.5 * twiceSignedArea;
+   }
+   if( fabs( area - expectedArea ) > 1.0E-5 * expectedArea )
+   {
+      errorMessage = QObject::tr("the triangles' area is %1 instead of %2").arg( area ).arg( expectedArea );
+      return false;
+   }
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
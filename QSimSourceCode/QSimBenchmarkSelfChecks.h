@@ -0,0 +1,73 @@
+//-----------------------------------------------------------------------------
+// File:     QSimBenchmarkSelfChecks.h
+// Class:    QSimBenchmarkSelfChecks
+// Parents:  None
+// Purpose:  Checks run by QSimBenchmark before measuring (results that are wrong make the measurements meaningless).
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMBENCHMARKSELFCHECKS_H__
+#define  QSIMBENCHMARKSELFCHECKS_H__
+#include <QtCore>
+#include <QtGui>
+#include "qglscenenode.h"
+#include "qbox3d.h"
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+class QSimBenchmarkSelfChecks
+{
+public:
+   // Write a small scene of rotated objects (one attached to another through a transformed QGLSceneNode), read it into another
+   // view widget, and check that every object's vertices are drawn in the same place.  Returns false and a message if not.
+   static bool  CheckSceneFileRoundTrip( QString& errorMessage );
+
+   // Triangulate a star-shaped polygon with round and square holes, and check that there are n + 2h - 2 triangles (n points, h holes), all
+   // counter-clockwise, whose areas add up to the outer area minus the hole areas.  Returns false and a message if not.
+   static bool  CheckPolygonTriangulation( QString& errorMessage );
+
+private:
+   // Box around an object's vertices (its QGLSceneNode and descendants that are not other objects) where they are drawn in the world.
+   static void  UniteWorldBoundingBoxOfVertices( const QGLSceneNode& sceneNode, const QMatrix4x4& transform, QBox3D& boundingBox );
+
+   // Only static functions.
+   QSimBenchmarkSelfChecks();
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMBENCHMARKSELFCHECKS_H__
+//--------------------------------------------------------------------------
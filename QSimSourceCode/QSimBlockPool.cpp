@@ -0,0 +1,101 @@
+//-----------------------------------------------------------------------------
+// File:     QSimBlockPool.cpp
+// Class:    QSimBlockPool
+// Parents:  None
+// Purpose:  Allocates equal-size blocks of memory from large chunks, reusing freed blocks (fast, and memory does not fragment).
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimBlockPool.h"
+#include <new>        // std::bad_alloc
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimBlockPool::QSimBlockPool( const size_t blockSizeInBytes, const int numberOfBlocksPerChunk )
+{
+   // Round the block size up to a multiple of the alignment (and large enough to hold the free-list pointer).
+   const size_t alignment = QSimBlockPool::GetBlockAlignmentInBytes();
+   const size_t minimumBlockSize = blockSizeInBytes > sizeof(void*) ? blockSizeInBytes : sizeof(void*);
+   myBlockSizeInBytes = ( (minimumBlockSize + alignment - 1) / alignment ) * alignment;
+   myNumberOfBlocksPerChunk = numberOfBlocksPerChunk > 0 ? numberOfBlocksPerChunk : 1;
+   myFirstFreeBlockOrNull = NULL;
+   myNumberOfBlocksInUse = 0;
+}
+
+
+//------------------------------------------------------------------------------
+QSimBlockPool::~QSimBlockPool()
+{
+   for( int i=0;  i < myChunks.count();  i++ ) qFreeAligned( myChunks[i] );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimBlockPool::AllocateChunk()
+{
+   // Thread every block in the new chunk onto the free list (in address order, so consecutive allocations are adjacent in memory).
+   char* chunk = static_cast<char*>( qMallocAligned( myBlockSizeInBytes * myNumberOfBlocksPerChunk, QSimBlockPool::GetBlockAlignmentInBytes() ) );
+   if( chunk == NULL ) throw std::bad_alloc();
+   myChunks.append( chunk );
+   for( int i = myNumberOfBlocksPerChunk - 1;  i >= 0;  i-- )
+   {
+      void* block = chunk + i * myBlockSizeInBytes;
+      *static_cast<void**>( block ) = myFirstFreeBlockOrNull;
+      myFirstFreeBlockOrNull = block;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void*  QSimBlockPool::AllocateBlock()
+{
+   if( myFirstFreeBlockOrNull == NULL ) this->AllocateChunk();
+   void* block = myFirstFreeBlockOrNull;
+   myFirstFreeBlockOrNull = *static_cast<void**>( block );
+   ++myNumberOfBlocksInUse;
+   return block;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimBlockPool::FreeBlock( void* block )
+{
+   if( block == NULL ) return;
+   *static_cast<void**>( block ) = myFirstFreeBlockOrNull;
+   myFirstFreeBlockOrNull = block;
+   --myNumberOfBlocksInUse;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// File:     QSimBlockPool.h
+// Class:    QSimBlockPool
+// Parents:  None
+// Purpose:  Allocates equal-size blocks of memory from large chunks, reusing freed blocks (fast, and memory does not fragment).
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMBLOCKPOOL_H__
+#define  QSIMBLOCKPOOL_H__
+#include <QtCore>
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+class QSimBlockPool
+{
+public:
+   // Constructors and destructors.  Every block must be freed before the pool is destroyed (the destructor frees all chunks).
+   QSimBlockPool( const size_t blockSizeInBytes, const int numberOfBlocksPerChunk );
+  ~QSimBlockPool();
+
+   // Allocate and free one block in constant time (only from the GUI thread).  Freed blocks are reused before a new chunk is allocated.
+   void*  AllocateBlock();
+   void   FreeBlock( void* block );
+
+   // Memory use (e.g., for profiling).
+   size_t        GetBlockSizeInBytes() const       { return myBlockSizeInBytes; }
+   unsigned int  GetNumberOfBlocksInUse() const    { return myNumberOfBlocksInUse; }
+   qint64        GetNumberOfBytesReserved() const  { return (qint64)myChunks.count() * myNumberOfBlocksPerChunk * myBlockSizeInBytes; }
+
+private:
+   // Blocks are aligned for any member type (e.g., double).  A free block holds a pointer to the next free block.
+   static size_t  GetBlockAlignmentInBytes()  { return 16; }
+   size_t         myBlockSizeInBytes;
+   int            myNumberOfBlocksPerChunk;
+   QVector<void*> myChunks;
+   void*          myFirstFreeBlockOrNull;
+   unsigned int   myNumberOfBlocksInUse;
+   void           AllocateChunk();
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMBLOCKPOOL_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,440 @@
+//-----------------------------------------------------------------------------
+// File:     QSimClusteredMesh.cpp
+// Class:    QSimClusteredMesh
+// Parents:  QGLSceneNode
+// Purpose:  Very large triangle mesh split into spatial clusters in a memory-mapped file, streamed to the GPU as clusters become visible.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <QtConcurrentRun>
+#include <algorithm>
+#include <cstring>
+#include "QSimClusteredMesh.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+// Layout of a clustered mesh file (written and mapped as is, so every field is naturally aligned and there is no padding).
+// Each cluster's data is its vertex positions, then its vertex normals (3 floats each), then its 16-bit indices (padded to 4 bytes).
+struct QSimClusteredMeshFileHeader
+{
+   quint32  myMagicNumber;
+   quint32  myVersion;
+   quint32  myIsLittleEndian;
+   quint32  myNumberOfClusters;
+   quint64  myNumberOfTriangles;
+   float    myBoundingBoxMinimum[3];
+   float    myBoundingBoxMaximum[3];
+};
+struct QSimClusteredMeshFileCluster
+{
+   float    myBoundingBoxMinimum[3];
+   float    myBoundingBoxMaximum[3];
+   quint32  myNumberOfVertices;
+   quint32  myNumberOfIndices;
+   quint64  myByteOffset;
+};
+static const quint32  QSimClusteredMeshFileMagicNumber = 0x434D5351;   // "QSMC"
+static const quint32  QSimClusteredMeshFileVersion = 1;
+
+
+//------------------------------------------------------------------------------
+static qint64  GetNumberOfBytesInClusterData( const quint32 numberOfVertices, const quint32 numberOfIndices )
+{
+   return numberOfVertices * (qint64)( 2 * sizeof(QVector3D) ) + ( ( numberOfIndices * (qint64)sizeof(ushort) + 3 ) & ~(qint64)3 );
+}
+
+
+//------------------------------------------------------------------------------
+static void  SetBoundingBoxInFile( const QBox3D& boundingBox, float* minimum, float* maximum )
+{
+   minimum[0] = boundingBox.minimum().x();  minimum[1] = boundingBox.minimum().y();  minimum[2] = boundingBox.minimum().z();
+   maximum[0] = boundingBox.maximum().x();  maximum[1] = boundingBox.maximum().y();  maximum[2] = boundingBox.maximum().z();
+}
+
+
+//------------------------------------------------------------------------------
+// Orders triangles by one coordinate of their centroids (for the median split).
+struct QSimTriangleCentroidIsLess
+{
+   const QVector3D*  myCentroids;
+   int               myAxis;
+   qreal  GetCoordinate( const int triangle ) const  { const QVector3D& c = myCentroids[triangle];  return myAxis == 0 ? c.x() : ( myAxis == 1 ? c.y() : c.z() ); }
+   bool   operator()( const int a, const int b ) const  { return this->GetCoordinate(a) < this->GetCoordinate(b); }
+};
+
+
+//------------------------------------------------------------------------------
+QSimClusteredMesh::QSimClusteredMesh( QObject* parent ) : QSimMeshSceneNode(parent)
+{
+   myFileContents = NULL;
+   myNumberOfTriangles = 0;
+
+   // Default budget is 256 MB of GPU memory for this mesh.
+   myClusterMemoryBudgetInBytes = 256 * 1024 * 1024;
+   myResidentClusterMemoryInBytes = 0;
+   myNumberOfClustersBeingDecoded = 0;
+   myCurrentFrameNumber = 0;
+   myNumberOfClustersDrawnInLastFrame = 0;
+}
+
+
+//------------------------------------------------------------------------------
+QSimClusteredMesh::~QSimClusteredMesh()
+{
+   this->CloseClusteredMeshFile();
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimClusteredMesh::WriteClusteredMeshFile( const QString& filename, const QVector3DArray& positions, const QVector3DArray& normals, const QVector<int>& vertexIndexOfCorners, QString& errorMessage )
+{
+   // Split the triangles at the median of their centroids along the longest axis until each cluster is small enough.
+   // Ranges are split depth first, so neighboring clusters are also near each other in the file.
+   const int numberOfTriangles = vertexIndexOfCorners.count() / 3;
+   const int numberOfVertices = positions.count();
+   QVector<QVector3D> centroids( numberOfTriangles );
+   for( int t=0;  t < numberOfTriangles;  t++ ) centroids[t] = positions.at( vertexIndexOfCorners[3*t] ) + positions.at( vertexIndexOfCorners[3*t+1] ) + positions.at( vertexIndexOfCorners[3*t+2] );
+   QVector<int> triangleOrder( numberOfTriangles );
+   for( int t=0;  t < numberOfTriangles;  t++ ) triangleOrder[t] = t;
+   QVector< QPair<int,int> > clusterRanges, rangesToSplit;
+   rangesToSplit.append( qMakePair( 0, numberOfTriangles ) );
+   while( !rangesToSplit.isEmpty() )
+   {
+      const QPair<int,int> range = rangesToSplit.last();
+      rangesToSplit.pop_back();
+      if( range.second - range.first <= QSimClusteredMesh::GetMaximumNumberOfTrianglesPerCluster() ) { clusterRanges.append( range );  continue; }
+      QBox3D centroidBox;
+      for( int i = range.first;  i < range.second;  i++ ) centroidBox.unite( centroids[ triangleOrder[i] ] );
+      const QVector3D size = centroidBox.size();
+      QSimTriangleCentroidIsLess isLess;
+      isLess.myCentroids = centroids.constData();
+      isLess.myAxis = ( size.x() >= size.y() && size.x() >= size.z() ) ? 0 : ( size.y() >= size.z() ? 1 : 2 );
+      const int middle = range.first + ( range.second - range.first ) / 2;
+      std::nth_element( triangleOrder.begin() + range.first, triangleOrder.begin() + middle, triangleOrder.begin() + range.second, isLess );
+      rangesToSplit.append( qMakePair( middle, range.second ) );
+      rangesToSplit.append( qMakePair( range.first, middle ) );
+   }
+   centroids.clear();
+
+   // Write to a temporary file first, so an existing file is only replaced by a complete one.
+   const QString temporaryFilename = filename + ".part";
+   QFile file( temporaryFilename );
+   if( !file.open( QFile::WriteOnly | QFile::Truncate ) ) { errorMessage = tr("Cannot write file %1:\n%2.").arg(temporaryFilename).arg(file.errorString());  return false; }
+   QBox3D meshBoundingBox;
+   for( int i=0;  i < numberOfVertices;  i++ ) meshBoundingBox.unite( positions.at(i) );
+   QSimClusteredMeshFileHeader header;
+   header.myMagicNumber = QSimClusteredMeshFileMagicNumber;
+   header.myVersion = QSimClusteredMeshFileVersion;
+   header.myIsLittleEndian = ( Q_BYTE_ORDER == Q_LITTLE_ENDIAN ) ? 1 : 0;
+   header.myNumberOfClusters = clusterRanges.count();
+   header.myNumberOfTriangles = numberOfTriangles;
+   SetBoundingBoxInFile( meshBoundingBox, header.myBoundingBoxMinimum, header.myBoundingBoxMaximum );
+   QVector<QSimClusteredMeshFileCluster> clusterTable( clusterRanges.count() );
+   bool isFileWritten = file.write( reinterpret_cast<const char*>( &header ), sizeof(header) ) == sizeof(header);
+   isFileWritten = isFileWritten && file.write( QByteArray( clusterTable.count() * sizeof(QSimClusteredMeshFileCluster), 0 ) ) == (qint64)( clusterTable.count() * sizeof(QSimClusteredMeshFileCluster) );
+
+   // Each cluster's vertices are numbered from 0 (a vertex shared by neighboring clusters is written once in each).
+   QVector<int> clusterIndexOfVertices( numberOfVertices, -1 );
+   QVector<int> verticesInCluster;
+   QVector3DArray clusterPositions, clusterNormals;
+   QArray<ushort> clusterIndices;
+   for( int c=0;  c < clusterRanges.count() && isFileWritten;  c++ )
+   {
+      verticesInCluster.resize( 0 );
+      clusterIndices.resize( 0 );
+      for( int i = clusterRanges[c].first;  i < clusterRanges[c].second;  i++ )
+      {
+         for( int k=0;  k < 3;  k++ )
+         {
+            const int vertex = vertexIndexOfCorners[ 3 * triangleOrder[i] + k ];
+            if( clusterIndexOfVertices[vertex] < 0 ) { clusterIndexOfVertices[vertex] = verticesInCluster.count();  verticesInCluster.append( vertex ); }
+            clusterIndices.append( (ushort)clusterIndexOfVertices[vertex] );
+         }
+      }
+      clusterPositions.resize( 0 );
+      clusterNormals.resize( 0 );
+      QBox3D clusterBoundingBox;
+      for( int j=0;  j < verticesInCluster.count();  j++ )
+      {
+         const int vertex = verticesInCluster[j];
+         clusterPositions.append( positions.at(vertex) );
+         clusterNormals.append( normals.at(vertex) );
+         clusterBoundingBox.unite( positions.at(vertex) );
+         clusterIndexOfVertices[vertex] = -1;
+      }
+
+      QSimClusteredMeshFileCluster& cluster = clusterTable[c];
+      SetBoundingBoxInFile( clusterBoundingBox, cluster.myBoundingBoxMinimum, cluster.myBoundingBoxMaximum );
+      cluster.myNumberOfVertices = verticesInCluster.count();
+      cluster.myNumberOfIndices = clusterIndices.count();
+      cluster.myByteOffset = file.pos();
+      const qint64 numberOfPositionBytes = clusterPositions.count() * (qint64)sizeof(QVector3D);
+      const qint64 numberOfIndexBytes = clusterIndices.count() * (qint64)sizeof(ushort);
+      const qint64 numberOfPaddingBytes = GetNumberOfBytesInClusterData( cluster.myNumberOfVertices, cluster.myNumberOfIndices ) - 2 * numberOfPositionBytes - numberOfIndexBytes;
+      isFileWritten = file.write( reinterpret_cast<const char*>( clusterPositions.constData() ), numberOfPositionBytes ) == numberOfPositionBytes
+                   && file.write( reinterpret_cast<const char*>( clusterNormals.constData() ), numberOfPositionBytes ) == numberOfPositionBytes
+                   && file.write( reinterpret_cast<const char*>( clusterIndices.constData() ), numberOfIndexBytes ) == numberOfIndexBytes
+                   && file.write( QByteArray( numberOfPaddingBytes, 0 ) ) == numberOfPaddingBytes;
+   }
+
+   // The table (now that each cluster's position in the file is known).
+   isFileWritten = isFileWritten && file.seek( sizeof(header) );
+   isFileWritten = isFileWritten && file.write( reinterpret_cast<const char*>( clusterTable.constData() ), clusterTable.count() * sizeof(QSimClusteredMeshFileCluster) ) == (qint64)( clusterTable.count() * sizeof(QSimClusteredMeshFileCluster) );
+   isFileWritten = isFileWritten && file.flush();
+   file.close();
+   if( !isFileWritten || !ReplaceFileWithTemporaryFile( temporaryFilename, filename ) )
+   {
+      QFile::remove( temporaryFilename );
+      errorMessage = tr("Cannot write file %1.").arg(filename);
+      return false;
+   }
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimClusteredMesh::OpenClusteredMeshFile( const QString& filename, QString& errorMessage )
+{
+   // Map the whole file (cluster data is only read from disk when a cluster is first visible).
+   this->CloseClusteredMeshFile();
+   myFile.setFileName( filename );
+   if( !myFile.open( QFile::ReadOnly ) ) { errorMessage = tr("Cannot read file %1:\n%2.").arg(filename).arg(myFile.errorString());  return false; }
+   const qint64 numberOfBytesInFile = myFile.size();
+   myFileContents = numberOfBytesInFile >= (qint64)sizeof(QSimClusteredMeshFileHeader) ? myFile.map( 0, numberOfBytesInFile ) : NULL;
+   if( myFileContents == NULL ) { errorMessage = tr("Cannot map file %1 into memory.").arg(filename);  this->CloseClusteredMeshFile();  return false; }
+
+   // Check the header and the table's size.
+   QSimClusteredMeshFileHeader header;
+   memcpy( &header, myFileContents, sizeof(header) );
+   const qint64 numberOfBytesInTable = header.myNumberOfClusters * (qint64)sizeof(QSimClusteredMeshFileCluster);
+   if( header.myMagicNumber != QSimClusteredMeshFileMagicNumber )                     errorMessage = tr("%1 is not a clustered mesh file.").arg(filename);
+   else if( header.myVersion > QSimClusteredMeshFileVersion )                         errorMessage = tr("%1 was written by a newer version of QSim.").arg(filename);
+   else if( header.myIsLittleEndian != ( Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? 1u : 0u ) ) errorMessage = tr("%1 was written on a computer with a different byte order.").arg(filename);
+   else if( (qint64)sizeof(header) + numberOfBytesInTable > numberOfBytesInFile )    errorMessage = tr("File %1 is damaged.").arg(filename);
+   if( !errorMessage.isEmpty() ) { this->CloseClusteredMeshFile();  return false; }
+
+   // Copy the table, checking each cluster's data is within the file (so a damaged file cannot cause reads outside it).
+   myClusterEntries.resize( header.myNumberOfClusters );
+   for( quint32 c=0;  c < header.myNumberOfClusters;  c++ )
+   {
+      QSimClusteredMeshFileCluster cluster;
+      memcpy( &cluster, myFileContents + sizeof(header) + c * sizeof(cluster), sizeof(cluster) );
+      const bool isClusterValid = cluster.myNumberOfVertices <= 65536 && cluster.myNumberOfIndices <= 3u * QSimClusteredMesh::GetMaximumNumberOfTrianglesPerCluster() && cluster.myNumberOfIndices % 3 == 0
+                               && cluster.myByteOffset % 4 == 0 && cluster.myByteOffset + GetNumberOfBytesInClusterData( cluster.myNumberOfVertices, cluster.myNumberOfIndices ) <= (quint64)numberOfBytesInFile;
+      if( !isClusterValid ) { errorMessage = tr("File %1 is damaged.").arg(filename);  myClusterEntries.clear();  this->CloseClusteredMeshFile();  return false; }
+      QSimClusterEntry& entry = myClusterEntries[c];
+      entry.myBoundingBox = QBox3D( QVector3D( cluster.myBoundingBoxMinimum[0], cluster.myBoundingBoxMinimum[1], cluster.myBoundingBoxMinimum[2] ), QVector3D( cluster.myBoundingBoxMaximum[0], cluster.myBoundingBoxMaximum[1], cluster.myBoundingBoxMaximum[2] ) );
+      entry.myNumberOfVertices = cluster.myNumberOfVertices;
+      entry.myNumberOfIndices = cluster.myNumberOfIndices;
+      entry.myByteOffset = cluster.myByteOffset;
+      entry.myDecodeWatcherOrNull = NULL;
+      entry.myIsDecoded = false;
+      entry.myIsDamaged = false;
+      entry.myVertexBundleOrNull = NULL;
+      entry.myIndexBufferOrNull = NULL;
+      entry.myClusterMemoryInBytes = QSimClusteredMesh::GetClusterMemoryInBytes( entry );
+      entry.myLastFrameNumberUsed = 0;
+   }
+   myBoundingBox = QBox3D( QVector3D( header.myBoundingBoxMinimum[0], header.myBoundingBoxMinimum[1], header.myBoundingBoxMinimum[2] ), QVector3D( header.myBoundingBoxMaximum[0], header.myBoundingBoxMaximum[1], header.myBoundingBoxMaximum[2] ) );
+   myNumberOfTriangles = header.myNumberOfTriangles;
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimClusteredMesh::CloseClusteredMeshFile()
+{
+   // Clusters being read on worker threads read the mapped file, so they are finished before it is unmapped.
+   // The GPU memory of resident clusters is freed (QGLBuffer makes its OpenGL context current if necessary).
+   const int numberOfClusters = myClusterEntries.count();
+   for( int c=0;  c < numberOfClusters;  c++ )
+   {
+      QSimClusterEntry& entry = myClusterEntries[c];
+      if( entry.myDecodeWatcherOrNull ) { entry.myDecodeWatcherOrNull->disconnect( this );  entry.myDecodeWatcherOrNull->waitForFinished();  delete entry.myDecodeWatcherOrNull;  entry.myDecodeWatcherOrNull = NULL; }
+      this->EvictCluster( entry );
+   }
+   myClusterEntries.clear();
+   myNumberOfClustersBeingDecoded = 0;
+   if( myFileContents ) myFile.unmap( const_cast<uchar*>( myFileContents ) );
+   myFileContents = NULL;
+   myFile.close();
+   myBoundingBox = QBox3D();
+   myNumberOfTriangles = 0;
+}
+
+
+//------------------------------------------------------------------------------
+QSimDecodedCluster  QSimClusteredMesh::DecodeCluster( const uchar* clusterData, const quint32 numberOfVertices, const quint32 numberOfIndices )
+{
+   // Runs on a worker thread, so reading the cluster from disk (page faults in the mapped file) does not stall drawing.
+   QSimDecodedCluster decodedCluster;
+   const qint64 numberOfPositionBytes = numberOfVertices * (qint64)sizeof(QVector3D);
+   const ushort* indices = reinterpret_cast<const ushort*>( clusterData + 2 * numberOfPositionBytes );
+   for( quint32 i=0;  i < numberOfIndices;  i++ )
+      if( indices[i] >= numberOfVertices ) return decodedCluster;
+   decodedCluster.myPositions.resize( numberOfVertices );
+   decodedCluster.myNormals.resize( numberOfVertices );
+   decodedCluster.myIndices.resize( numberOfIndices );
+   memcpy( decodedCluster.myPositions.data(), clusterData, numberOfPositionBytes );
+   memcpy( decodedCluster.myNormals.data(), clusterData + numberOfPositionBytes, numberOfPositionBytes );
+   memcpy( decodedCluster.myIndices.data(), indices, numberOfIndices * sizeof(ushort) );
+   return decodedCluster;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimClusteredMesh::StartDecodingCluster( QSimClusterEntry& entry )
+{
+   entry.myDecodeWatcherOrNull = new QFutureWatcher<QSimDecodedCluster>( this );
+   QObject::connect( entry.myDecodeWatcherOrNull, SIGNAL(finished()), this, SLOT(DecodedClusterIsReadySlot()) );
+   entry.myDecodeWatcherOrNull->setFuture( QtConcurrent::run( QSimClusteredMesh::DecodeCluster, myFileContents + entry.myByteOffset, entry.myNumberOfVertices, entry.myNumberOfIndices ) );
+   ++myNumberOfClustersBeingDecoded;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimClusteredMesh::DecodedClusterIsReadySlot()
+{
+   // Collect the results of all reads that have finished (each cluster is uploaded when it is next drawn).
+   const int numberOfClusters = myClusterEntries.count();
+   for( int c=0;  c < numberOfClusters;  c++ )
+   {
+      QSimClusterEntry& entry = myClusterEntries[c];
+      if( entry.myDecodeWatcherOrNull == NULL || !entry.myDecodeWatcherOrNull->isFinished() ) continue;
+      entry.myDecodedCluster = entry.myDecodeWatcherOrNull->result();
+      entry.myIsDamaged = entry.myDecodedCluster.myIndices.count() != (int)entry.myNumberOfIndices;
+      entry.myIsDecoded = !entry.myIsDamaged;
+      entry.myDecodeWatcherOrNull->deleteLater();
+      entry.myDecodeWatcherOrNull = NULL;
+      --myNumberOfClustersBeingDecoded;
+      if( entry.myIsDamaged ) qWarning( "QSimClusteredMesh: Cluster %d of %s is damaged", c, qPrintable( myFile.fileName() ) );
+   }
+   emit ClusterIsReadySignal();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimClusteredMesh::MakeClusterResident( QSimClusterEntry& entry )
+{
+   // Make room for this cluster, then upload it (its CPU copy is no longer needed).
+   this->EvictClustersToFitInBudget( entry.myClusterMemoryInBytes );
+   entry.myVertexBundleOrNull = new QGLVertexBundle;
+   entry.myVertexBundleOrNull->addAttribute( QGL::Position, entry.myDecodedCluster.myPositions );
+   entry.myVertexBundleOrNull->addAttribute( QGL::Normal, entry.myDecodedCluster.myNormals );
+   entry.myVertexBundleOrNull->upload();
+   entry.myIndexBufferOrNull = new QGLIndexBuffer;
+   entry.myIndexBufferOrNull->setIndexes( entry.myDecodedCluster.myIndices );
+   entry.myIndexBufferOrNull->upload();
+   entry.myDecodedCluster = QSimDecodedCluster();
+   entry.myIsDecoded = false;
+   myResidentClusterMemoryInBytes += entry.myClusterMemoryInBytes;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimClusteredMesh::EvictCluster( QSimClusterEntry& entry )
+{
+   if( entry.myVertexBundleOrNull == NULL ) return;
+   delete entry.myVertexBundleOrNull;   entry.myVertexBundleOrNull = NULL;
+   delete entry.myIndexBufferOrNull;    entry.myIndexBufferOrNull = NULL;
+   myResidentClusterMemoryInBytes -= entry.myClusterMemoryInBytes;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimClusteredMesh::EvictClustersToFitInBudget( const qint64 additionalBytesNeeded )
+{
+   // Evict the least recently drawn resident cluster until there is room (clusters drawn in the current frame are not evicted).
+   const int numberOfClusters = myClusterEntries.count();
+   while( myResidentClusterMemoryInBytes + additionalBytesNeeded > myClusterMemoryBudgetInBytes )
+   {
+      QSimClusterEntry* leastRecentlyUsedEntry = NULL;
+      for( int c=0;  c < numberOfClusters;  c++ )
+      {
+         QSimClusterEntry& entry = myClusterEntries[c];
+         if( entry.myVertexBundleOrNull == NULL || entry.myLastFrameNumberUsed == myCurrentFrameNumber ) continue;
+         if( leastRecentlyUsedEntry == NULL || entry.myLastFrameNumberUsed < leastRecentlyUsedEntry->myLastFrameNumberUsed ) leastRecentlyUsedEntry = &entry;
+      }
+      if( leastRecentlyUsedEntry == NULL ) break;
+      this->EvictCluster( *leastRecentlyUsedEntry );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimClusteredMesh::DrawWithLocalTransform( QGLPainter& painter )
+{
+   // The picking pass draws the same frame again, so it only draws clusters that are resident (it does not count as a frame,
+   // which would make clusters look less recently used and double the upload limit, and it does not read or upload clusters).
+   const bool isPicking = painter.isPicking();
+   if( !isPicking ) { ++myCurrentFrameNumber;  myNumberOfClustersDrawnInLastFrame = 0; }
+
+   // Clusters outside the view frustum are skipped (and a copy read for them is discarded, so memory is only used for what is visible).
+   const int maximumNumberOfClustersBeingDecoded = 2 * qMax( 1, QThread::idealThreadCount() );
+   qint64 numberOfBytesUploaded = 0;
+   bool isUploadDeferred = false;
+   const int numberOfClusters = myClusterEntries.count();
+   for( int c=0;  c < numberOfClusters;  c++ )
+   {
+      QSimClusterEntry& entry = myClusterEntries[c];
+      if( entry.myIsDamaged ) continue;
+      if( painter.isCullable( entry.myBoundingBox ) )
+      {
+         if( entry.myIsDecoded ) { entry.myDecodedCluster = QSimDecodedCluster();  entry.myIsDecoded = false; }
+         continue;
+      }
+      entry.myLastFrameNumberUsed = myCurrentFrameNumber;
+
+      // A visible cluster that is not resident is uploaded if it has been read (a limited number of bytes per frame), or else read on a worker thread.
+      if( entry.myVertexBundleOrNull == NULL && !isPicking )
+      {
+         if( entry.myIsDecoded && numberOfBytesUploaded < QSimClusteredMesh::GetMaximumUploadInBytesPerFrame() ) { this->MakeClusterResident( entry );  numberOfBytesUploaded += entry.myClusterMemoryInBytes; }
+         else if( entry.myIsDecoded ) isUploadDeferred = true;
+         else if( entry.myDecodeWatcherOrNull == NULL && myNumberOfClustersBeingDecoded < maximumNumberOfClustersBeingDecoded ) this->StartDecodingCluster( entry );
+      }
+      if( entry.myVertexBundleOrNull == NULL ) continue;
+
+      // Draw the resident cluster with the render state that was already applied to the painter.
+      painter.clearAttributes();
+      painter.setVertexBundle( *entry.myVertexBundleOrNull );
+      painter.draw( QGL::Triangles, *entry.myIndexBufferOrNull );
+      if( !isPicking ) ++myNumberOfClustersDrawnInLastFrame;
+   }
+
+   // Clusters that were read but not uploaded this frame are uploaded in the next frame.
+   if( isUploadDeferred ) QMetaObject::invokeMethod( this, "ClusterIsReadySignal", Qt::QueuedConnection );
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
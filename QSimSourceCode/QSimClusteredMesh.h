@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+// File:     QSimClusteredMesh.h
+// Class:    QSimClusteredMesh
+// Parents:  QGLSceneNode
+// Purpose:  Very large triangle mesh split into spatial clusters in a memory-mapped file, streamed to the GPU as clusters become visible.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMCLUSTEREDMESH_H__
+#define  QSIMCLUSTEREDMESH_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglscenenode.h"
+#include "qglpainter.h"
+#include "qglvertexbundle.h"
+#include "qglindexbuffer.h"
+#include "qbox3d.h"
+#include "CppStandardHeaders.h"
+#include "QSimGenericFunctions.h"
+#include "QSimMeshSceneNode.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Result of reading one cluster from the memory-mapped file on a worker thread (empty if the cluster's data is damaged).
+struct QSimDecodedCluster
+{
+   QVector3DArray  myPositions;
+   QVector3DArray  myNormals;
+   QArray<ushort>  myIndices;
+};
+
+
+//------------------------------------------------------------------------------
+class QSimClusteredMesh : public QSimMeshSceneNode
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimClusteredMesh( QObject* parent = NULL );
+  ~QSimClusteredMesh();
+
+   // A clustered mesh file (.qsimmesh) is a header, a table with each cluster's bounding box and where its data is, then each cluster's
+   // vertex positions, vertex normals, and 16-bit triangle indices.  Clusters are spatially compact (a recursive median split of the
+   // triangles), so a cluster outside the view frustum is skipped as a whole and only visible clusters need to be in memory.
+   // WriteClusteredMeshFile writes welded triangles (three indices per triangle into positions and normals).
+   // OpenClusteredMeshFile maps the file into memory and reads only the table (cluster data is read when first visible).
+   // Both return false and set errorMessage if the file cannot be written or read.
+   static bool  WriteClusteredMeshFile( const QString& filename, const QVector3DArray& positions, const QVector3DArray& normals, const QVector<int>& vertexIndexOfCorners, QString& errorMessage );
+   bool         OpenClusteredMeshFile( const QString& filename, QString& errorMessage );
+   QString      GetClusteredMeshFilename() const  { return myFile.fileName(); }
+
+   // Mesh importers write meshes with at least this many triangles to a clustered mesh file rather than keeping them in memory.
+   static QString  GetClusteredMeshFileSuffix()                  { return "qsimmesh"; }
+   static int      GetMinimumNumberOfTrianglesToCluster()        { return 1 << 20; }
+   static int      GetMaximumNumberOfTrianglesPerCluster()       { return 1 << 14; }   // At most 3 * 16384 vertices, so 16-bit indices suffice.
+
+   // Bounds and size of the whole mesh (known from the table, without reading any cluster).
+   const QBox3D&  GetBoundingBox() const             { return myBoundingBox; }
+   unsigned int   GetNumberOfClusters() const        { return myClusterEntries.count(); }
+   qint64         GetNumberOfTriangles() const       { return myNumberOfTriangles; }
+
+   // Budget (in bytes) for clusters resident on the GPU.  Least recently drawn clusters are evicted to stay within it
+   // (clusters drawn in the current frame are never evicted, so the budget may be exceeded temporarily).
+   void    SetClusterMemoryBudgetInBytes( const qint64 budgetInBytes )  { myClusterMemoryBudgetInBytes = budgetInBytes; }
+   qint64  GetClusterMemoryBudgetInBytes() const                        { return myClusterMemoryBudgetInBytes; }
+
+   // At most this many bytes are uploaded each frame (the remaining visible clusters are uploaded in later frames so the view stays responsive).
+   static qint64  GetMaximumUploadInBytesPerFrame()  { return 16 * 1024 * 1024; }
+
+   // Statistics (helpful for profiling).
+   qint64        GetResidentClusterMemoryInBytes() const      { return myResidentClusterMemoryInBytes; }
+   unsigned int  GetNumberOfClustersDrawnInLastFrame() const  { return myNumberOfClustersDrawnInLastFrame; }
+
+signals:
+   // Emitted when clusters have been read (connect it to the view's updateGL so they are drawn).
+   void  ClusterIsReadySignal();
+
+protected:
+   // Draws the visible clusters that are resident, uploads visible clusters that have been read, and starts reading other visible clusters.
+   virtual void  DrawWithLocalTransform( QGLPainter& painter );
+
+private slots:
+   void  DecodedClusterIsReadySlot();
+
+private:
+   // Each cluster keeps nothing in CPU memory once uploaded (an evicted cluster is read from the file again when next visible).
+   // myDecodeWatcherOrNull is not NULL while the cluster is being read on a worker thread.
+   // myVertexBundleOrNull and myIndexBufferOrNull are not NULL while the cluster is resident on the GPU.
+   struct QSimClusterEntry
+   {
+      QBox3D                               myBoundingBox;
+      quint32                              myNumberOfVertices;
+      quint32                              myNumberOfIndices;
+      qint64                               myByteOffset;
+      QFutureWatcher<QSimDecodedCluster>*  myDecodeWatcherOrNull;
+      QSimDecodedCluster                   myDecodedCluster;
+      bool                                 myIsDecoded;
+      bool                                 myIsDamaged;
+      QGLVertexBundle*                     myVertexBundleOrNull;
+      QGLIndexBuffer*                      myIndexBufferOrNull;
+      qint64                               myClusterMemoryInBytes;
+      unsigned int                         myLastFrameNumberUsed;
+   };
+   QVector<QSimClusterEntry>  myClusterEntries;
+   static qint64  GetClusterMemoryInBytes( const QSimClusterEntry& entry )  { return entry.myNumberOfVertices * (qint64)( 2 * sizeof(QVector3D) ) + entry.myNumberOfIndices * (qint64)sizeof(ushort); }
+
+   // Reading, uploading, and evicting clusters.
+   static QSimDecodedCluster  DecodeCluster( const uchar* clusterData, const quint32 numberOfVertices, const quint32 numberOfIndices );
+   void  StartDecodingCluster( QSimClusterEntry& entry );
+   void  MakeClusterResident( QSimClusterEntry& entry );
+   void  EvictCluster( QSimClusterEntry& entry );
+   void  EvictClustersToFitInBudget( const qint64 additionalBytesNeeded );
+   void  CloseClusteredMeshFile();
+
+   // The memory-mapped file (only its table is copied into myClusterEntries).
+   QFile         myFile;
+   const uchar*  myFileContents;
+   QBox3D        myBoundingBox;
+   qint64        myNumberOfTriangles;
+
+   // Residency and statistics.
+   qint64        myClusterMemoryBudgetInBytes;
+   qint64        myResidentClusterMemoryInBytes;
+   int           myNumberOfClustersBeingDecoded;
+   unsigned int  myCurrentFrameNumber;
+   unsigned int  myNumberOfClustersDrawnInLastFrame;
+
+   // Disable copying.
+   QSimClusteredMesh( const QSimClusteredMesh& );
+   QSimClusteredMesh&  operator=( const QSimClusteredMesh& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMCLUSTEREDMESH_H__
+//--------------------------------------------------------------------------
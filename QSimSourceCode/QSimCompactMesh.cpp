@@ -0,0 +1,345 @@
+//-----------------------------------------------------------------------------
+// File:     QSimCompactMesh.cpp
+// Class:    QSimCompactMesh
+// Parents:  QGLSceneNode
+// Purpose:  Triangle mesh stored with quantized positions, octahedral normals, and 16-bit texture coordinates that are decoded in the shader.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <cstddef>
+#include "QSimCompactMesh.h"
+#include "QSimSceneNode.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+// Shaders for compact vertices.  OpenGL has already normalized the integers to [0,1] (positions and texture coordinates) or [-1,1] (normals).
+// A normal is unfolded from the octahedron:  z = 1 - |x| - |y|, and if z < 0 the lower half is folded back across the diagonals.
+// Lighting is a headlight (as bright as the material's diffuse color where a surface faces the camera), and picking draws the pick color.
+static const char*  QSimCompactMeshVertexShader =
+   "attribute highp vec4 qt_Vertex;\n"
+   "attribute mediump vec4 qt_Normal;\n"
+   "attribute highp vec4 qt_MultiTexCoord0;\n"
+   "uniform highp mat4 qt_ModelViewProjectionMatrix;\n"
+   "uniform mediump mat3 qt_NormalMatrix;\n"
+   "uniform highp vec3 qsim_PositionOffset;\n"
+   "uniform highp vec3 qsim_PositionScale;\n"
+   "uniform highp vec2 qsim_TextureCoordinateOffset;\n"
+   "uniform highp vec2 qsim_TextureCoordinateScale;\n"
+   "varying mediump vec3 qsim_EyeNormal;\n"
+   "varying highp vec2 qsim_TextureCoordinate;\n"
+   "void main()\n"
+   "{\n"
+   "   highp vec3 position = qsim_PositionOffset + qt_Vertex.xyz * qsim_PositionScale;\n"
+   "   mediump vec3 normal = vec3( qt_Normal.xy, 1.0 - abs(qt_Normal.x) - abs(qt_Normal.y) );\n"
+   "   if( normal.z < 0.0 ) normal.xy = ( 1.0 - abs(normal.yx) ) * ( 2.0 * step( 0.0, normal.xy ) - 1.0 );\n"
+   "   qsim_EyeNormal = qt_NormalMatrix * normalize( normal );\n"
+   "   qsim_TextureCoordinate = qsim_TextureCoordinateOffset + qt_MultiTexCoord0.xy * qsim_TextureCoordinateScale;\n"
+   "   gl_Position = qt_ModelViewProjectionMatrix * vec4( position, 1.0 );\n"
+   "}\n";
+
+static const char*  QSimCompactMeshFragmentShader =
+   "uniform mediump vec4 qt_Color;\n"
+   "uniform sampler2D qt_Texture0;\n"
+   "uniform bool qsim_IsLit;\n"
+   "uniform bool qsim_HasTexture;\n"
+   "varying mediump vec3 qsim_EyeNormal;\n"
+   "varying highp vec2 qsim_TextureCoordinate;\n"
+   "void main()\n"
+   "{\n"
+   "   mediump vec4 color = qt_Color;\n"
+   "   if( qsim_HasTexture ) { mediump vec4 texel = texture2D( qt_Texture0, qsim_TextureCoordinate );  color.rgb = mix( color.rgb, texel.rgb, texel.a ); }\n"
+   "   if( qsim_IsLit ) color.rgb *= 0.3 + 0.7 * abs( normalize( qsim_EyeNormal ).z );\n"
+   "   gl_FragColor = color;\n"
+   "}\n";
+
+
+//------------------------------------------------------------------------------
+// Nearest 16-bit fraction of range (0 if range is empty).
+static quint16  QuantizeToUnsigned16Bits( const qreal value, const qreal range )
+{
+   if( range <= 0 ) return 0;
+   const qreal fraction = qBound( (qreal)0, value / range, (qreal)1 );
+   return (quint16)( fraction * 65535 + 0.5 );
+}
+
+
+//------------------------------------------------------------------------------
+QSimCompactMesh::QSimCompactMesh( QGLShaderProgramEffect& compactMeshEffect, QObject* parent ) : QSimMeshSceneNode(parent), myCompactMeshEffect(compactMeshEffect)
+{
+   myNumberOfIndices = 0;
+   myHasTextureCoordinates = false;
+   myVertexBufferOrNull = NULL;
+   myIndexBufferOrNull = NULL;
+}
+
+
+//------------------------------------------------------------------------------
+QSimCompactMesh::~QSimCompactMesh()
+{
+   this->DeleteCompactMeshBuffers();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimCompactMesh::DeleteCompactMeshBuffers()
+{
+   delete myVertexBufferOrNull;   myVertexBufferOrNull = NULL;
+   delete myIndexBufferOrNull;    myIndexBufferOrNull = NULL;
+}
+
+
+//------------------------------------------------------------------------------
+QGLShaderProgramEffect*  QSimCompactMesh::CreateCompactMeshEffect()
+{
+   QGLShaderProgramEffect* compactMeshEffect = new QGLShaderProgramEffect;
+   compactMeshEffect->setVertexShader( QByteArray( QSimCompactMeshVertexShader ) );
+   compactMeshEffect->setFragmentShader( QByteArray( QSimCompactMeshFragmentShader ) );
+   return compactMeshEffect;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimCompactMesh::EncodeOctahedralNormal( const QVector3D& normal, qint16* octahedralNormal )
+{
+   // Project onto the octahedron |x|+|y|+|z| = 1, and fold its lower half (z < 0) over the upper half's corners (a zero normal becomes +z).
+   const qreal sumOfMagnitudes = qAbs( normal.x() ) + qAbs( normal.y() ) + qAbs( normal.z() );
+   qreal x = 0,  y = 0;
+   if( sumOfMagnitudes > 0 )
+   {
+      x = normal.x() / sumOfMagnitudes;
+      y = normal.y() / sumOfMagnitudes;
+      if( normal.z() < 0 )
+      {
+         const qreal foldedX = ( 1 - qAbs(y) ) * ( x >= 0 ? 1 : -1 );
+         const qreal foldedY = ( 1 - qAbs(x) ) * ( y >= 0 ? 1 : -1 );
+         x = foldedX;
+         y = foldedY;
+      }
+   }
+   octahedralNormal[0] = (qint16)qRound( qBound( (qreal)-1, x, (qreal)1 ) * 32767 );
+   octahedralNormal[1] = (qint16)qRound( qBound( (qreal)-1, y, (qreal)1 ) * 32767 );
+}
+
+
+//------------------------------------------------------------------------------
+QVector3D  QSimCompactMesh::DecodeOctahedralNormal( const qint16* octahedralNormal )
+{
+   // Same as the vertex shader.
+   const qreal x = qMax( (qreal)-1, octahedralNormal[0] / (qreal)32767 );
+   const qreal y = qMax( (qreal)-1, octahedralNormal[1] / (qreal)32767 );
+   QVector3D normal( x, y, 1 - qAbs(x) - qAbs(y) );
+   if( normal.z() < 0 ) { normal.setX( ( 1 - qAbs(y) ) * ( x >= 0 ? 1 : -1 ) );  normal.setY( ( 1 - qAbs(x) ) * ( y >= 0 ? 1 : -1 ) ); }
+   return normal.normalized();
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimCompactMesh::SetCompactMeshFromSceneNodeGeometry( const QGLSceneNode& sceneNode )
+{
+   // Start empty (the buffers are uploaded again when next drawn).
+   this->DeleteCompactMeshBuffers();
+   myCompactVertices.clear();
+   myShortIndices.clear();
+   myIntIndices.clear();
+   myNumberOfIndices = 0;
+   myHasTextureCoordinates = false;
+   myBoundingBox = QBox3D();
+
+   // Only the vertices used by this scene node are encoded (QGLBuilder puts the geometry of several scene nodes in one QGeometryData).
+   const QGeometryData geometry = sceneNode.geometry();
+   const int start = sceneNode.start();
+   const int count = sceneNode.count();
+   const QGL::IndexArray indices = geometry.indices();
+   const bool isIndexed = indices.count() > 0;
+   if( sceneNode.drawingMode() != QGL::Triangles || count < 3 || start < 0 || start + count > ( isIndexed ? indices.count() : geometry.count() ) || !geometry.hasField( QGL::Normal ) || geometry.hasField( QGL::Color ) ) return false;
+   int minimumIndex = start, maximumIndex = start + count - 1;
+   if( isIndexed )
+   {
+      minimumIndex = maximumIndex = indices.at( start );
+      for( int i = start + 1;  i < start + count;  i++ ) { minimumIndex = qMin( minimumIndex, (int)indices.at(i) );  maximumIndex = qMax( maximumIndex, (int)indices.at(i) ); }
+   }
+   if( maximumIndex >= geometry.count() ) return false;
+   const int numberOfVertices = maximumIndex - minimumIndex + 1;
+   const QVector3DArray positions = geometry.vertices();
+   const QVector3DArray normals = geometry.normals();
+   myHasTextureCoordinates = geometry.hasField( QGL::TextureCoord0 );
+   const QVector2DArray textureCoordinates = myHasTextureCoordinates ? geometry.texCoords( QGL::TextureCoord0 ) : QVector2DArray();
+
+   // Positions are quantized against the bounding box of these vertices, and texture coordinates against their range.
+   QVector2D minimumTextureCoordinate, maximumTextureCoordinate;
+   for( int i=0;  i < numberOfVertices;  i++ )
+   {
+      myBoundingBox.unite( positions.at( minimumIndex + i ) );
+      if( !myHasTextureCoordinates ) continue;
+      const QVector2D& t = textureCoordinates.at( minimumIndex + i );
+      if( i == 0 ) minimumTextureCoordinate = maximumTextureCoordinate = t;
+      minimumTextureCoordinate = QVector2D( qMin( minimumTextureCoordinate.x(), t.x() ), qMin( minimumTextureCoordinate.y(), t.y() ) );
+      maximumTextureCoordinate = QVector2D( qMax( maximumTextureCoordinate.x(), t.x() ), qMax( maximumTextureCoordinate.y(), t.y() ) );
+   }
+   myPositionScale = myBoundingBox.size();
+   myTextureCoordinateOffset = minimumTextureCoordinate;
+   myTextureCoordinateScale = maximumTextureCoordinate - minimumTextureCoordinate;
+
+   // Encode each vertex (each quantized value is the nearest one, so the error is at most half a step, i.e., 1/131070 of the range).
+   const QVector3D minimumPosition = myBoundingBox.minimum();
+   myCompactVertices.resize( numberOfVertices );
+   for( int i=0;  i < numberOfVertices;  i++ )
+   {
+      QSimCompactVertex& vertex = myCompactVertices[i];
+      const QVector3D& position = positions.at( minimumIndex + i );
+      vertex.myPosition[0] = QuantizeToUnsigned16Bits( position.x() - minimumPosition.x(), myPositionScale.x() );
+      vertex.myPosition[1] = QuantizeToUnsigned16Bits( position.y() - minimumPosition.y(), myPositionScale.y() );
+      vertex.myPosition[2] = QuantizeToUnsigned16Bits( position.z() - minimumPosition.z(), myPositionScale.z() );
+      vertex.myPadding = 0;
+      QSimCompactMesh::EncodeOctahedralNormal( normals.at( minimumIndex + i ), vertex.myOctahedralNormal );
+      vertex.myTextureCoordinate[0] = vertex.myTextureCoordinate[1] = 0;
+      if( !myHasTextureCoordinates ) continue;
+      const QVector2D& textureCoordinate = textureCoordinates.at( minimumIndex + i );
+      vertex.myTextureCoordinate[0] = QuantizeToUnsigned16Bits( textureCoordinate.x() - myTextureCoordinateOffset.x(), myTextureCoordinateScale.x() );
+      vertex.myTextureCoordinate[1] = QuantizeToUnsigned16Bits( textureCoordinate.y() - myTextureCoordinateOffset.y(), myTextureCoordinateScale.y() );
+   }
+
+   // Indices relative to the first vertex used (16-bit when they fit).
+   myNumberOfIndices = count - count % 3;
+   if( numberOfVertices <= 65536 )
+   {
+      myShortIndices.resize( myNumberOfIndices );
+      ushort* shortIndices = myShortIndices.data();
+      for( int i=0;  i < myNumberOfIndices;  i++ ) shortIndices[i] = (ushort)( ( isIndexed ? (int)indices.at( start + i ) : start + i ) - minimumIndex );
+   }
+   else
+   {
+      myIntIndices.resize( myNumberOfIndices );
+      uint* intIndices = myIntIndices.data();
+      for( int i=0;  i < myNumberOfIndices;  i++ ) intIndices[i] = (uint)( ( isIndexed ? (int)indices.at( start + i ) : start + i ) - minimumIndex );
+   }
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimCompactMesh::ConvertTrianglesToCompactMeshes( QGLSceneNode& sceneNode, QGLShaderProgramEffect& compactMeshEffect )
+{
+   // Descendants first (the compact meshes added below are children that need no conversion).
+   const QList<QGLSceneNode*> childSceneNodes = sceneNode.children();
+   for( QList<QGLSceneNode*>::const_iterator it = childSceneNodes.constBegin();  it != childSceneNodes.constEnd();  ++it )
+      if( qobject_cast<QSimCompactMesh*>( *it ) == NULL && QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( **it ) == NULL ) QSimCompactMesh::ConvertTrianglesToCompactMeshes( **it, compactMeshEffect );
+
+   // The compact mesh replaces this scene node's triangles (other drawing modes are left as they are).
+   if( sceneNode.count() <= 0 ) return;
+   QSimCompactMesh* compactMesh = new QSimCompactMesh( compactMeshEffect );
+   if( !compactMesh->SetCompactMeshFromSceneNodeGeometry( sceneNode ) ) { delete compactMesh;  return; }
+   compactMesh->setObjectName( sceneNode.objectName() );
+   sceneNode.addNode( compactMesh );
+   sceneNode.setStart( 0 );
+   sceneNode.setCount( 0 );
+   sceneNode.setGeometry( QGeometryData() );
+}
+
+
+//------------------------------------------------------------------------------
+QGeometryData  QSimCompactMesh::GetDecodedGeometry() const
+{
+   QGeometryData geometry;
+   const QVector3D minimumPosition = myBoundingBox.minimum();
+   const int numberOfVertices = myCompactVertices.count();
+   for( int i=0;  i < numberOfVertices;  i++ )
+   {
+      const QSimCompactVertex& vertex = myCompactVertices.at(i);
+      geometry.appendVertex( minimumPosition + QVector3D( vertex.myPosition[0] * myPositionScale.x(), vertex.myPosition[1] * myPositionScale.y(), vertex.myPosition[2] * myPositionScale.z() ) / 65535 );
+      geometry.appendNormal( QSimCompactMesh::DecodeOctahedralNormal( vertex.myOctahedralNormal ) );
+      if( myHasTextureCoordinates ) geometry.appendTexCoord( myTextureCoordinateOffset + QVector2D( vertex.myTextureCoordinate[0] * myTextureCoordinateScale.x(), vertex.myTextureCoordinate[1] * myTextureCoordinateScale.y() ) / 65535 );
+   }
+   for( int i=0;  i < myNumberOfIndices;  i++ ) geometry.appendIndex( myIntIndices.isEmpty() ? (int)myShortIndices.at(i) : (int)myIntIndices.at(i) );
+   return geometry;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimCompactMesh::DrawWithLocalTransform( QGLPainter& painter )
+{
+   if( myNumberOfIndices <= 0 ) return;
+
+   // Upload the vertices and indices the first time the mesh is drawn.
+   if( myVertexBufferOrNull == NULL )
+   {
+      myVertexBufferOrNull = new QGLBuffer( QGLBuffer::VertexBuffer );
+      if( !myVertexBufferOrNull->create() ) { this->DeleteCompactMeshBuffers();  return; }
+      myVertexBufferOrNull->bind();
+      myVertexBufferOrNull->allocate( myCompactVertices.constData(), (int)this->GetVertexMemoryInBytes() );
+      myVertexBufferOrNull->release();
+      myIndexBufferOrNull = new QGLIndexBuffer;
+      if( myIntIndices.isEmpty() ) myIndexBufferOrNull->setIndexes( myShortIndices );
+      else                         myIndexBufferOrNull->setIndexes( myIntIndices );
+      myIndexBufferOrNull->upload();
+   }
+
+   // Draw with the compact mesh effect, then restore the painter's effect (the render queue skips setting an effect that it set last).
+   // The texture is used if the painter was about to draw a texture (the texture is already bound).
+   QGLAbstractEffect* previousUserEffect = painter.userEffect();
+   const QGL::StandardEffect previousStandardEffect = painter.standardEffect();
+   const bool isPicking = painter.isPicking();
+   const bool hasTexture = myHasTextureCoordinates && !isPicking && previousUserEffect == NULL && previousStandardEffect == QGL::LitDecalTexture2D;
+   painter.setUserEffect( &myCompactMeshEffect );
+   QGLShaderProgram* program = myCompactMeshEffect.program();
+   if( program )
+   {
+      program->setUniformValue( "qsim_PositionOffset", myBoundingBox.minimum() );
+      program->setUniformValue( "qsim_PositionScale", myPositionScale );
+      program->setUniformValue( "qsim_TextureCoordinateOffset", myTextureCoordinateOffset );
+      program->setUniformValue( "qsim_TextureCoordinateScale", myTextureCoordinateScale );
+      program->setUniformValue( "qsim_IsLit", (GLint)( isPicking ? 0 : 1 ) );
+      program->setUniformValue( "qsim_HasTexture", (GLint)( hasTexture ? 1 : 0 ) );
+      program->setUniformValue( "qt_Texture0", (GLint)0 );
+
+      // Setting a client-side attribute through the painter makes it release the vertex buffer it last bound (so it binds its next vertex bundle again).
+      // Then the attributes are pointed into this mesh's vertex buffer (OpenGL normalizes the 16-bit integers as they are read).
+      const int stride = sizeof(QSimCompactVertex);
+      painter.setVertexAttribute( QGL::Position, QGLAttributeValue( 3, GL_UNSIGNED_SHORT, stride, myCompactVertices.constData() ) );
+      myVertexBufferOrNull->bind();
+      program->setAttributeBuffer( QGL::Position,      GL_UNSIGNED_SHORT, (int)offsetof( QSimCompactVertex, myPosition ),          3, stride );
+      program->setAttributeBuffer( QGL::Normal,        GL_SHORT,          (int)offsetof( QSimCompactVertex, myOctahedralNormal ),  2, stride );
+      program->setAttributeBuffer( QGL::TextureCoord0, GL_UNSIGNED_SHORT, (int)offsetof( QSimCompactVertex, myTextureCoordinate ), 2, stride );
+      program->enableAttributeArray( QGL::Position );
+      program->enableAttributeArray( QGL::Normal );
+      program->enableAttributeArray( QGL::TextureCoord0 );
+      myVertexBufferOrNull->release();
+      painter.draw( QGL::Triangles, *myIndexBufferOrNull );
+   }
+   if( previousUserEffect ) painter.setUserEffect( previousUserEffect );
+   else                     painter.setStandardEffect( previousStandardEffect );
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------------
+// File:     QSimCompactMesh.h
+// Class:    QSimCompactMesh
+// Parents:  QGLSceneNode
+// Purpose:  Triangle mesh stored with quantized positions, octahedral normals, and 16-bit texture coordinates that are decoded in the shader.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMCOMPACTMESH_H__
+#define  QSIMCOMPACTMESH_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglscenenode.h"
+#include "qglpainter.h"
+#include "qglindexbuffer.h"
+#include "qglshaderprogrameffect.h"
+#include "qbox3d.h"
+#include "CppStandardHeaders.h"
+#include "QSimMeshSceneNode.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+//------------------------------------------------------------------------------
+class QSimCompactMesh : public QSimMeshSceneNode
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   // compactMeshEffect (from CreateCompactMeshEffect) draws the mesh, so it must outlive the mesh (it is usually shared by all compact meshes in a view).
+   QSimCompactMesh( QGLShaderProgramEffect& compactMeshEffect, QObject* parent = NULL );
+  ~QSimCompactMesh();
+
+   // Each vertex is 16 bytes (rather than 32 bytes for a float position, normal, and texture coordinate):
+   //   Position:            three unsigned 16-bit integers, a fraction of the mesh's bounding box (plus 2 bytes of padding).
+   //   Normal:              two signed 16-bit integers, the unit normal in octahedral encoding (the octahedron |x|+|y|+|z| = 1 unfolded onto a square).
+   //   Texture coordinate:  two unsigned 16-bit integers, a fraction of the range of the mesh's texture coordinates.
+   // OpenGL normalizes the integers to [0,1] or [-1,1] as they are read, and the vertex shader scales them back.
+   // SetCompactMeshFromSceneNodeGeometry encodes the triangles in sceneNode's range of its geometry (which needs normals and no per-vertex colors).
+   // Returns false (and leaves this mesh empty) if sceneNode has no such triangles.
+   bool  SetCompactMeshFromSceneNodeGeometry( const QGLSceneNode& sceneNode );
+
+   // Replace the triangles of sceneNode and of its descendant QGLSceneNodes (except other objects and meshes that are already compact)
+   // by compact meshes (children of the QGLSceneNodes whose geometry they replace).  The QGeometryData they used is released.
+   static void  ConvertTrianglesToCompactMeshes( QGLSceneNode& sceneNode, QGLShaderProgramEffect& compactMeshEffect );
+
+   // Effect whose shaders decode compact vertices (the caller owns it and deletes it while its OpenGL context is current).
+   static QGLShaderProgramEffect*  CreateCompactMeshEffect();
+
+   // Full-precision copy of the mesh (e.g., for writing to a file), with texture coordinates only if the original mesh had them.
+   QGeometryData  GetDecodedGeometry() const;
+
+   // Bounds and size of the mesh.
+   const QBox3D&  GetBoundingBox() const           { return myBoundingBox; }
+   int            GetNumberOfVertices() const      { return myCompactVertices.count(); }
+   int            GetNumberOfTriangles() const     { return myNumberOfIndices / 3; }
+   qint64         GetVertexMemoryInBytes() const   { return myCompactVertices.count() * (qint64)sizeof(QSimCompactVertex); }
+
+protected:
+   // Draws the mesh with the painter's current color (and texture, if the painter's standard effect is LitDecalTexture2D).
+   // The vertex and index buffers are uploaded the first time the mesh is drawn.
+   virtual void  DrawWithLocalTransform( QGLPainter& painter );
+
+private:
+   // Interleaved vertex (16 bytes, so each vertex starts on a 16-byte boundary).
+   struct QSimCompactVertex
+   {
+      quint16  myPosition[3];
+      quint16  myPadding;
+      qint16   myOctahedralNormal[2];
+      quint16  myTextureCoordinate[2];
+   };
+   static void  EncodeOctahedralNormal( const QVector3D& normal, qint16* octahedralNormal );
+   static QVector3D  DecodeOctahedralNormal( const qint16* octahedralNormal );
+
+   // Compact vertices and indices (kept so the buffers can be uploaded again and the mesh can be decoded).
+   // Indices are 16-bit if there are at most 65536 vertices, otherwise 32-bit.
+   QVector<QSimCompactVertex>  myCompactVertices;
+   QArray<ushort>              myShortIndices;
+   QArray<uint>                myIntIndices;
+   int                         myNumberOfIndices;
+   bool                        myHasTextureCoordinates;
+
+   // Each quantized value q (normalized to [0,1]) is decoded as offset + q * scale.
+   QBox3D     myBoundingBox;
+   QVector3D  myPositionScale;
+   QVector2D  myTextureCoordinateOffset;
+   QVector2D  myTextureCoordinateScale;
+
+   // Buffers on the GPU (NULL until the mesh is first drawn).
+   QGLBuffer*       myVertexBufferOrNull;
+   QGLIndexBuffer*  myIndexBufferOrNull;
+   void  DeleteCompactMeshBuffers();
+
+   // Effect whose shaders decode the vertices.
+   QGLShaderProgramEffect&  myCompactMeshEffect;
+
+   // Disable copying.
+   QSimCompactMesh( const QSimCompactMesh& );
+   QSimCompactMesh&  operator=( const QSimCompactMesh& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMCOMPACTMESH_H__
+//--------------------------------------------------------------------------
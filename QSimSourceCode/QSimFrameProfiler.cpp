@@ -0,0 +1,302 @@
+//-----------------------------------------------------------------------------
+// File:     QSimFrameProfiler.cpp
+// Class:    QSimFrameProfiler
+// Parents:  None
+// Purpose:  Measures the cost of each frame drawn in a view widget, shows it in an overlay, and writes it to a log file.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "qvector2darray.h"
+#include "QSimFrameProfiler.h"
+
+// Timer queries (GL_ARB_timer_query or GL_EXT_timer_query) are not in the OpenGL 1.1 headers, so get them from the driver.
+#ifndef APIENTRY
+   #define APIENTRY
+#endif
+#ifndef GL_TIME_ELAPSED
+   #define GL_TIME_ELAPSED               0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+   #define GL_QUERY_RESULT               0x8866
+   #define GL_QUERY_RESULT_AVAILABLE     0x8867
+#endif
+typedef void (APIENTRY *QSimGLGenQueries)( GLsizei n, GLuint* ids );
+typedef void (APIENTRY *QSimGLDeleteQueries)( GLsizei n, const GLuint* ids );
+typedef void (APIENTRY *QSimGLBeginQuery)( GLenum target, GLuint id );
+typedef void (APIENTRY *QSimGLEndQuery)( GLenum target );
+typedef void (APIENTRY *QSimGLGetQueryObjectiv)( GLuint id, GLenum pname, GLint* params );
+typedef void (APIENTRY *QSimGLGetQueryObjectui64v)( GLuint id, GLenum pname, quint64* params );
+static QSimGLGenQueries           qsimGLGenQueries = NULL;
+static QSimGLDeleteQueries        qsimGLDeleteQueries = NULL;
+static QSimGLBeginQuery           qsimGLBeginQuery = NULL;
+static QSimGLEndQuery             qsimGLEndQuery = NULL;
+static QSimGLGetQueryObjectiv     qsimGLGetQueryObjectiv = NULL;
+static QSimGLGetQueryObjectui64v  qsimGLGetQueryObjectui64v = NULL;
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimFrameProfiler::QSimFrameProfiler()
+{
+   myFrameProfilerIsEnabled = false;
+   myIndexOfLastFrameInLog = myIndexOfLastPickPassInLog = -1;
+   myFrameIsPickPass = false;
+   myIndexOfActiveGpuTimerQueryOrMinus1 = -1;
+   myDriverSupportsTimerQueries = -1;
+   for( int i=0;  i < NumberOfGpuTimerQueries;  i++ ) { myGpuTimerQueries[i].myQueryId = 0;  myGpuTimerQueries[i].myIndexInLogOrMinus1 = -1; }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimFrameProfiler::SetFrameProfilerEnabled( const bool enableFrameProfiler )
+{
+   myFrameProfilerIsEnabled = enableFrameProfiler;
+   if( !enableFrameProfiler ) return;
+   myFrameProfilerLog.resize( 0 );
+   myFrameProfilerLog.reserve( 1000 );
+   myIndexOfLastFrameInLog = myIndexOfLastPickPassInLog = -1;
+   for( int i=0;  i < NumberOfGpuTimerQueries;  i++ ) myGpuTimerQueries[i].myIndexInLogOrMinus1 = -1;
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimFrameProfiler::InitializeGpuTimerQueries()
+{
+   // Check the driver's extensions once (requires a current OpenGL context).
+   if( myDriverSupportsTimerQueries == -1 )
+   {
+      myDriverSupportsTimerQueries = 0;
+      const QGLContext* context = QGLContext::currentContext();
+      const QByteArray extensions( (const char*)glGetString( GL_EXTENSIONS ) );
+      const bool isARB = extensions.contains( "GL_ARB_timer_query" );
+      if( context && (isARB || extensions.contains( "GL_EXT_timer_query" )) )
+      {
+         qsimGLGenQueries           = (QSimGLGenQueries)          context->getProcAddress( "glGenQueries" );
+         qsimGLDeleteQueries        = (QSimGLDeleteQueries)       context->getProcAddress( "glDeleteQueries" );
+         qsimGLBeginQuery           = (QSimGLBeginQuery)          context->getProcAddress( "glBeginQuery" );
+         qsimGLEndQuery             = (QSimGLEndQuery)            context->getProcAddress( "glEndQuery" );
+         qsimGLGetQueryObjectiv     = (QSimGLGetQueryObjectiv)    context->getProcAddress( "glGetQueryObjectiv" );
+         qsimGLGetQueryObjectui64v  = (QSimGLGetQueryObjectui64v) context->getProcAddress( isARB ? "glGetQueryObjectui64v" : "glGetQueryObjectui64vEXT" );
+         const bool hasAllFunctions = qsimGLGenQueries && qsimGLDeleteQueries && qsimGLBeginQuery && qsimGLEndQuery && qsimGLGetQueryObjectiv && qsimGLGetQueryObjectui64v;
+         myDriverSupportsTimerQueries = hasAllFunctions ? 1 : 0;
+      }
+   }
+   if( myDriverSupportsTimerQueries != 1 ) return false;
+
+   // Create the queries the first time they are needed.
+   if( myGpuTimerQueries[0].myQueryId == 0 )
+   {
+      GLuint queryIds[ NumberOfGpuTimerQueries ];
+      qsimGLGenQueries( NumberOfGpuTimerQueries, queryIds );
+      for( int i=0;  i < NumberOfGpuTimerQueries;  i++ ) myGpuTimerQueries[i].myQueryId = queryIds[i];
+   }
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimFrameProfiler::DeleteFrameProfilerGLResources()
+{
+   if( myGpuTimerQueries[0].myQueryId == 0 || qsimGLDeleteQueries == NULL ) return;
+   for( int i=0;  i < NumberOfGpuTimerQueries;  i++ )
+   {
+      qsimGLDeleteQueries( 1, &myGpuTimerQueries[i].myQueryId );
+      myGpuTimerQueries[i].myQueryId = 0;
+      myGpuTimerQueries[i].myIndexInLogOrMinus1 = -1;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimFrameProfiler::ReadAvailableGpuTimerQueryResults()
+{
+   // Only read results the GPU has already produced (asking for any other result would wait for the GPU).
+   for( int i=0;  i < NumberOfGpuTimerQueries;  i++ )
+   {
+      QSimGpuTimerQuery& query = myGpuTimerQueries[i];
+      if( query.myIndexInLogOrMinus1 < 0 ) continue;
+      GLint isResultAvailable = 0;
+      qsimGLGetQueryObjectiv( query.myQueryId, GL_QUERY_RESULT_AVAILABLE, &isResultAvailable );
+      if( !isResultAvailable ) continue;
+      quint64 elapsedTimeInNanoseconds = 0;
+      qsimGLGetQueryObjectui64v( query.myQueryId, GL_QUERY_RESULT, &elapsedTimeInNanoseconds );
+      if( query.myIndexInLogOrMinus1 < myFrameProfilerLog.count() )
+         myFrameProfilerLog[ query.myIndexInLogOrMinus1 ].myGpuTimeInMilliseconds = 1.0E-6 * elapsedTimeInNanoseconds;
+      query.myIndexInLogOrMinus1 = -1;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimFrameProfiler::BeginFrameProfilerFrame( const bool isPickPass )
+{
+   if( !myFrameProfilerIsEnabled ) return;
+   myFrameIsPickPass = isPickPass;
+
+   // Start a free timer query (if all are still waiting for the GPU, this frame has no GPU time).
+   myIndexOfActiveGpuTimerQueryOrMinus1 = -1;
+   if( this->InitializeGpuTimerQueries() )
+   {
+      this->ReadAvailableGpuTimerQueryResults();
+      for( int i=0;  i < NumberOfGpuTimerQueries && myIndexOfActiveGpuTimerQueryOrMinus1 < 0;  i++ )
+         if( myGpuTimerQueries[i].myIndexInLogOrMinus1 < 0 ) myIndexOfActiveGpuTimerQueryOrMinus1 = i;
+      if( myIndexOfActiveGpuTimerQueryOrMinus1 >= 0 ) qsimGLBeginQuery( GL_TIME_ELAPSED, myGpuTimerQueries[ myIndexOfActiveGpuTimerQueryOrMinus1 ].myQueryId );
+   }
+   myCpuTimer.start();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimFrameProfiler::EndFrameProfilerFrame( const unsigned int numberOfDrawCalls, const unsigned int numberOfTriangles, const unsigned int numberOfStateChanges )
+{
+   if( !myFrameProfilerIsEnabled || !myCpuTimer.isValid() ) return;
+
+   // CPU time is the time to issue the OpenGL commands (the GPU may still be working on them).
+   QSimFrameProfilerSample sample;
+#if QT_VERSION >= 0x040800
+   sample.myCpuTimeInMilliseconds = 1.0E-6 * myCpuTimer.nsecsElapsed();
+#else
+   sample.myCpuTimeInMilliseconds = myCpuTimer.elapsed();   // Qt 4.7 only has millisecond resolution.
+#endif
+   sample.myGpuTimeInMilliseconds = -1.0;
+   sample.myNumberOfDrawCalls = numberOfDrawCalls;
+   sample.myNumberOfTriangles = numberOfTriangles;
+   sample.myNumberOfStateChanges = numberOfStateChanges;
+   sample.myIsPickPass = myFrameIsPickPass;
+   myCpuTimer.invalidate();
+
+   // Start over when the log is full (pending timer queries no longer refer to valid samples).
+   if( myFrameProfilerLog.count() >= QSimFrameProfiler::GetMaximumNumberOfSamplesInLog() )
+   {
+      myFrameProfilerLog.resize( 0 );
+      myIndexOfLastFrameInLog = myIndexOfLastPickPassInLog = -1;
+      for( int i=0;  i < NumberOfGpuTimerQueries;  i++ ) myGpuTimerQueries[i].myIndexInLogOrMinus1 = -1;
+   }
+   const int indexInLog = myFrameProfilerLog.count();
+   myFrameProfilerLog.append( sample );
+   if( myFrameIsPickPass ) myIndexOfLastPickPassInLog = indexInLog;
+   else                    myIndexOfLastFrameInLog = indexInLog;
+
+   // The query's result is read in a later frame.
+   if( myIndexOfActiveGpuTimerQueryOrMinus1 >= 0 )
+   {
+      qsimGLEndQuery( GL_TIME_ELAPSED );
+      myGpuTimerQueries[ myIndexOfActiveGpuTimerQueryOrMinus1 ].myIndexInLogOrMinus1 = indexInLog;
+      myIndexOfActiveGpuTimerQueryOrMinus1 = -1;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimFrameProfiler::DrawFrameProfilerOverlay( QGLPainter& painter, QGLWidget& glWidget )
+{
+   if( !myFrameProfilerIsEnabled || myIndexOfLastFrameInLog < 0 ) return;
+
+   // Histogram of the CPU time of recent frames (not pick passes) in 2 millisecond bins (last bin is 30 milliseconds or more).
+   const int numberOfBins = 16;
+   const double millisecondsPerBin = 2.0;
+   int binCounts[ numberOfBins ] = { 0 };
+   int numberOfFramesInHistogram = 0;
+   for( int i = myFrameProfilerLog.count() - 1;  i >= 0 && numberOfFramesInHistogram < 240;  i-- )
+   {
+      const QSimFrameProfilerSample& sample = myFrameProfilerLog[i];
+      if( sample.myIsPickPass ) continue;
+      ++binCounts[ qMin( numberOfBins - 1, (int)( sample.myCpuTimeInMilliseconds / millisecondsPerBin ) ) ];
+      ++numberOfFramesInHistogram;
+   }
+   int largestBinCount = 1;
+   for( int bin=0;  bin < numberOfBins;  bin++ ) largestBinCount = qMax( largestBinCount, binCounts[bin] );
+
+   // Bars in the lower-left corner, in pixel coordinates (origin at upper-left) and drawn over the scene.
+   const int barWidth = 8, maxBarHeight = 60, left = 10, bottom = glWidget.height() - 10;
+   QVector2DArray barVertices;
+   for( int bin=0;  bin < numberOfBins;  bin++ )
+   {
+      const qreal x0 = left + bin * (barWidth + 2),  x1 = x0 + barWidth;
+      const qreal y0 = bottom,  y1 = bottom - qMax( 1, maxBarHeight * binCounts[bin] / largestBinCount );
+      barVertices.append( QVector2D(x0,y0), QVector2D(x1,y0), QVector2D(x1,y1) );
+      barVertices.append( QVector2D(x0,y0), QVector2D(x1,y1), QVector2D(x0,y1) );
+   }
+   painter.projectionMatrix().push();
+   painter.modelViewMatrix().push();
+   painter.projectionMatrix().setToIdentity();
+   painter.projectionMatrix().ortho( glWidget.rect() );
+   painter.modelViewMatrix().setToIdentity();
+   glDisable( GL_DEPTH_TEST );
+   painter.setStandardEffect( QGL::FlatColor );
+   painter.setColor( QColor( 0, 220, 0 ) );
+   painter.clearAttributes();
+   painter.setVertexAttribute( QGL::Position, barVertices );
+   painter.draw( QGL::Triangles, barVertices.count() );
+   painter.modelViewMatrix().pop();
+   painter.projectionMatrix().pop();
+
+   // Text for the most recent frame and pick pass (renderText changes the shader program, so disable the painter's effect first).
+   const QSimFrameProfilerSample& frame = myFrameProfilerLog[ myIndexOfLastFrameInLog ];
+   const QString gpuTime = frame.myGpuTimeInMilliseconds >= 0 ? QString::number( frame.myGpuTimeInMilliseconds, 'f', 2 ) + " ms" : QString("n/a");
+   const QString pickTime = myIndexOfLastPickPassInLog >= 0 ? QString::number( myFrameProfilerLog[ myIndexOfLastPickPassInLog ].myCpuTimeInMilliseconds, 'f', 2 ) + " ms" : QString("n/a");
+   QStringList lines;
+   lines << QString("CPU frame: %1 ms   GPU frame: %2").arg( frame.myCpuTimeInMilliseconds, 0, 'f', 2 ).arg( gpuTime );
+   lines << QString("Draw calls: %1   Triangles: %2   State changes: %3").arg( frame.myNumberOfDrawCalls ).arg( frame.myNumberOfTriangles ).arg( frame.myNumberOfStateChanges );
+   lines << QString("Pick pass: %1").arg( pickTime );
+   const QString histogramLabel = QString("Frame time histogram (%1 frames, 0 to %2+ ms)").arg( numberOfFramesInHistogram ).arg( (numberOfBins - 1) * millisecondsPerBin );
+   painter.disableEffect();
+   glWidget.qglColor( Qt::white );
+   const int lineHeight = glWidget.fontMetrics().height();
+   for( int i=0;  i < lines.count();  i++ ) glWidget.renderText( 10, 10 + (i + 1) * lineHeight, lines[i] );
+   glWidget.renderText( 10, bottom - maxBarHeight - 4, histogramLabel );
+   glEnable( GL_DEPTH_TEST );
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimFrameProfiler::WriteFrameProfilerLogToFile( const QString& filename ) const
+{
+   QFile file( filename );
+   if( !file.open( QFile::WriteOnly | QFile::Text | QFile::Truncate ) ) return false;
+   QTextStream stream( &file );
+   stream << "Sample,PickPass,CpuTimeInMilliseconds,GpuTimeInMilliseconds,DrawCalls,Triangles,StateChanges\n";
+   const int numberOfSamples = myFrameProfilerLog.count();
+   for( int i=0;  i < numberOfSamples;  i++ )
+   {
+      const QSimFrameProfilerSample& sample = myFrameProfilerLog[i];
+      stream << i << "," << (sample.myIsPickPass ? 1 : 0) << "," << sample.myCpuTimeInMilliseconds << ",";
+      if( sample.myGpuTimeInMilliseconds >= 0 ) stream << sample.myGpuTimeInMilliseconds;
+      stream << "," << sample.myNumberOfDrawCalls << "," << sample.myNumberOfTriangles << "," << sample.myNumberOfStateChanges << "\n";
+   }
+   stream.flush();
+   return file.error() == QFile::NoError;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------------------
+// File:     QSimFrameProfiler.h
+// Class:    QSimFrameProfiler
+// Parents:  None
+// Purpose:  Measures the cost of each frame drawn in a view widget, shows it in an overlay, and writes it to a log file.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMFRAMEPROFILER_H__
+#define  QSIMFRAMEPROFILER_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglpainter.h"
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Measurements for one frame (or one pick pass, which draws every object into the pick buffer).
+struct QSimFrameProfilerSample
+{
+   double        myCpuTimeInMilliseconds;
+   double        myGpuTimeInMilliseconds;      // Negative until the result arrives, or if the driver has no timer queries.
+   unsigned int  myNumberOfDrawCalls;
+   unsigned int  myNumberOfTriangles;
+   unsigned int  myNumberOfStateChanges;
+   bool          myIsPickPass;
+};
+
+
+//------------------------------------------------------------------------------
+class QSimFrameProfiler
+{
+public:
+   // Constructors and destructors.
+   QSimFrameProfiler();
+  ~QSimFrameProfiler()  {;}
+
+   // Profiling is off by default (so it costs nothing).  Turning it on starts a new log.
+   bool  IsFrameProfilerEnabled() const  { return myFrameProfilerIsEnabled; }
+   void  SetFrameProfilerEnabled( const bool enableFrameProfiler );
+
+   // Call around the drawing of each frame (with the view widget's OpenGL context current).
+   // GPU time is measured with a timer query whose result is read a few frames later, so measuring does not stall the pipeline.
+   void  BeginFrameProfilerFrame( const bool isPickPass );
+   void  EndFrameProfilerFrame( const unsigned int numberOfDrawCalls, const unsigned int numberOfTriangles, const unsigned int numberOfStateChanges );
+
+   // Draw the most recent statistics and a histogram of recent frame times over the top of the scene.
+   void  DrawFrameProfilerOverlay( QGLPainter& painter, QGLWidget& glWidget );
+
+   // Write every sample since profiling was turned on as comma-separated values.
+   bool  WriteFrameProfilerLogToFile( const QString& filename ) const;
+
+   // Delete the timer queries (call with the view widget's OpenGL context current, e.g., before the widget is destroyed).
+   void  DeleteFrameProfilerGLResources();
+
+private:
+   bool  myFrameProfilerIsEnabled;
+
+   // Log of samples (cleared when full, so a profiler left on indefinitely does not grow without bound).
+   QVector<QSimFrameProfilerSample>  myFrameProfilerLog;
+   static int  GetMaximumNumberOfSamplesInLog()  { return 100000; }
+   int  myIndexOfLastFrameInLog, myIndexOfLastPickPassInLog;
+
+   // CPU time of the frame being drawn.
+   QElapsedTimer  myCpuTimer;
+   bool           myFrameIsPickPass;
+
+   // A few timer queries are cycled so results can be read after the GPU finishes (each remembers which sample it belongs to).
+   struct QSimGpuTimerQuery
+   {
+      GLuint  myQueryId;
+      int     myIndexInLogOrMinus1;
+   };
+   enum { NumberOfGpuTimerQueries = 4 };
+   QSimGpuTimerQuery  myGpuTimerQueries[ NumberOfGpuTimerQueries ];
+   int                myIndexOfActiveGpuTimerQueryOrMinus1;
+   int                myDriverSupportsTimerQueries;   // -1 until checked (requires a current OpenGL context).
+   bool  InitializeGpuTimerQueries();
+   void  ReadAvailableGpuTimerQueryResults();
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMFRAMEPROFILER_H__
+//--------------------------------------------------------------------------
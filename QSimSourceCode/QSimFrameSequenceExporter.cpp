@@ -0,0 +1,141 @@
+//-----------------------------------------------------------------------------
+// File:     QSimFrameSequenceExporter.cpp
+// Class:    QSimFrameSequenceExporter
+// Parents:  QObject
+// Purpose:  Renders a view widget's scene at fixed simulated-time steps and writes the frames as a numbered image sequence.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <QtConcurrentRun>
+#include "QSimFrameSequenceExporter.h"
+#include "QSimGLViewWidget.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimFrameSequenceExporter::QSimFrameSequenceExporter( QSimGLViewWidget& glViewWidget ) : QObject(NULL), myGLViewWidget(glViewWidget)
+{
+   // Default is 10 seconds at 30 frames per second, the size of the view widget, as png files in the current folder.
+   this->SetSimulatedTimes( 0.0, 10.0, 1.0/30.0 );
+   this->SetImageSize( glViewWidget.size() );
+   this->SetOutputFolderAndFilenamePrefix( QDir::currentPath(), "Frame" );
+}
+
+
+//------------------------------------------------------------------------------
+unsigned int  QSimFrameSequenceExporter::GetNumberOfFrames() const
+{
+   // Small tolerance so round-off does not drop the frame at endTime.
+   if( myTimeStep <= 0 || myEndTime < myStartTime ) return 0;
+   return 1 + (unsigned int)( (myEndTime - myStartTime) / myTimeStep + 1.0E-9 );
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimFrameSequenceExporter::WriteImageToFile( const QImage image, const QString filename, const QString imageFormat )
+{
+   // Compression (e.g., png) is the slow part, which is why this runs on a worker thread.
+   return image.save( filename, imageFormat.toLatin1().constData() );
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimFrameSequenceExporter::ExportFrameSequence( QWidget* parentWidgetOrNull )
+{
+   const unsigned int numberOfFrames = this->GetNumberOfFramesToExport();
+   if( numberOfFrames == 0 || myImageSize.isEmpty() ) return false;
+   if( !QDir().mkpath( myOutputFolder ) )
+   {
+      QMessageBox::warning( parentWidgetOrNull, tr("Export frames"), tr("Cannot create folder %1.").arg(myOutputFolder), QMessageBox::Ok, QMessageBox::NoButton );
+      return false;
+   }
+
+   // The progress dialog processes events (including its cancel button) each time its value is set.
+   QProgressDialog progressDialog( tr("Exporting frames..."), tr("Cancel"), 0, numberOfFrames, parentWidgetOrNull );
+   progressDialog.setWindowModality( Qt::WindowModal );
+   progressDialog.setMinimumDuration( 0 );
+
+   // Frames being encoded and written on worker threads (oldest first).
+   // Limit how many are in flight so rendering faster than encoding does not hold every frame in memory.
+   QList< QFuture<bool> >  framesBeingWritten;
+   QStringList             filenamesBeingWritten;
+   const int maxNumberOfFramesBeingWritten = 2 * qMax( 1, QThread::idealThreadCount() );
+   QString filenameThatFailedOrEmpty;
+   bool isEveryFrameRendered = true;
+
+   for( unsigned int frame = 0;  frame < numberOfFrames;  ++frame )
+   {
+      progressDialog.setValue( frame );
+      if( progressDialog.wasCanceled() ) { isEveryFrameRendered = false;  break; }
+
+      // Move the scene to this frame's simulated time and render it offscreen.
+      emit SetSceneToSimulatedTimeSignal( myStartTime + frame * myTimeStep );
+      const QImage frameImage = myGLViewWidget.RenderSceneToImage( myImageSize );
+      if( frameImage.isNull() )
+      {
+         QMessageBox::warning( parentWidgetOrNull, tr("Export frames"), tr("Unable to render frames offscreen on this computer."), QMessageBox::Ok, QMessageBox::NoButton );
+         isEveryFrameRendered = false;
+         break;
+      }
+
+      // Wait for the oldest frame only if too many are in flight (usually the render loop does not wait).
+      if( framesBeingWritten.count() >= maxNumberOfFramesBeingWritten )
+      {
+         const QString filename = filenamesBeingWritten.takeFirst();
+         if( !framesBeingWritten.takeFirst().result() && filenameThatFailedOrEmpty.isEmpty() ) filenameThatFailedOrEmpty = filename;
+      }
+
+      // Hand the frame to a worker thread (QImage is implicitly shared, so this does not copy the pixels).
+      const QString filename = QDir( myOutputFolder ).filePath( QString("%1%2.%3").arg(myFilenamePrefix).arg(frame, 5, 10, QChar('0')).arg(myImageFormat) );
+      framesBeingWritten.append( QtConcurrent::run( QSimFrameSequenceExporter::WriteImageToFile, frameImage, filename, myImageFormat ) );
+      filenamesBeingWritten.append( filename );
+      if( !filenameThatFailedOrEmpty.isEmpty() ) { isEveryFrameRendered = false;  break; }
+   }
+
+   // Finish writing the frames that were already rendered (also when canceled, so no partially-written files are left).
+   progressDialog.setLabelText( tr("Writing remaining frames...") );
+   progressDialog.setCancelButton( NULL );
+   while( !framesBeingWritten.isEmpty() )
+   {
+      const QString filename = filenamesBeingWritten.takeFirst();
+      if( !framesBeingWritten.takeFirst().result() && filenameThatFailedOrEmpty.isEmpty() ) filenameThatFailedOrEmpty = filename;
+   }
+   progressDialog.setValue( numberOfFrames );
+
+   if( !filenameThatFailedOrEmpty.isEmpty() )
+      QMessageBox::warning( parentWidgetOrNull, tr("Export frames"), tr("Cannot write file %1.").arg(filenameThatFailedOrEmpty), QMessageBox::Ok, QMessageBox::NoButton );
+   return isEveryFrameRendered && filenameThatFailedOrEmpty.isEmpty();
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// File:     QSimFrameSequenceExporter.h
+// Class:    QSimFrameSequenceExporter
+// Parents:  QObject
+// Purpose:  Renders a view widget's scene at fixed simulated-time steps and writes the frames as a numbered image sequence.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMFRAMESEQUENCEEXPORTER_H__
+#define  QSIMFRAMESEQUENCEEXPORTER_H__
+#include <QtCore>
+#include <QtGui>
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Forward declarations
+class  QSimGLViewWidget;
+
+
+//------------------------------------------------------------------------------
+class QSimFrameSequenceExporter : public QObject
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimFrameSequenceExporter( QSimGLViewWidget& glViewWidget );
+  ~QSimFrameSequenceExporter()  {;}
+
+   // Frames are rendered at simulated times startTime, startTime + timeStep, ... up to and including endTime.
+   void          SetSimulatedTimes( const double startTime, const double endTime, const double timeStep )  { myStartTime = startTime;  myEndTime = endTime;  myTimeStep = timeStep; }
+   unsigned int  GetNumberOfFrames() const;
+
+   // The scene only changes between frames if something moves it to each frame's simulated time (see SetSceneToSimulatedTimeSignal).
+   // Otherwise every frame would be the same image, so only the first frame is exported.
+   bool          IsSceneAnimated() const             { return this->receivers( SIGNAL(SetSceneToSimulatedTimeSignal(double)) ) > 0; }
+   unsigned int  GetNumberOfFramesToExport() const   { return this->IsSceneAnimated() ? this->GetNumberOfFrames() : qMin( 1u, this->GetNumberOfFrames() ); }
+
+   // Each frame is an image of this size (any size, as frames are rendered offscreen).
+   void  SetImageSize( const QSize& imageSize )  { myImageSize = imageSize; }
+
+   // Frames are written to outputFolder/filenamePrefix00000.png, outputFolder/filenamePrefix00001.png, ...
+   // imageFormat is any format Qt can write (e.g., "png", "jpg", "bmp").
+   void  SetOutputFolderAndFilenamePrefix( const QString& outputFolder, const QString& filenamePrefix, const QString& imageFormat = "png" )  { myOutputFolder = outputFolder;  myFilenamePrefix = filenamePrefix;  myImageFormat = imageFormat; }
+
+   // Render every frame to export (on this thread, as rendering uses OpenGL) while worker threads encode and write previous frames.
+   // Shows a progress dialog with a cancel button.  Returns true if every frame was written, false if canceled or on error.
+   bool  ExportFrameSequence( QWidget* parentWidgetOrNull );
+
+signals:
+   // Emitted before each frame is rendered so the scene can be moved to that simulated time (connect with a direct connection).
+   void  SetSceneToSimulatedTimeSignal( double simulatedTime );
+
+private:
+   // Runs on a worker thread.
+   static bool  WriteImageToFile( const QImage image, const QString filename, const QString imageFormat );
+
+   // The view widget whose scene is rendered.
+   QSimGLViewWidget&  myGLViewWidget;
+
+   // Simulated times, image size, and files for the frames.
+   double   myStartTime, myEndTime, myTimeStep;
+   QSize    myImageSize;
+   QString  myOutputFolder, myFilenamePrefix, myImageFormat;
+
+   // Disable default constructors and copying.
+   QSimFrameSequenceExporter();
+   QSimFrameSequenceExporter( const QSimFrameSequenceExporter& );
+   QSimFrameSequenceExporter&  operator=( const QSimFrameSequenceExporter& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMFRAMESEQUENCEEXPORTER_H__
+//--------------------------------------------------------------------------
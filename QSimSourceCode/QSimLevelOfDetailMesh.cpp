@@ -0,0 +1,101 @@
+//-----------------------------------------------------------------------------
+// File:     QSimLevelOfDetailMesh.cpp
+// Class:    QSimLevelOfDetailMesh
+// Parents:  QGLSceneNode
+// Purpose:  Chain of increasingly simplified versions of a mesh, one of which is drawn each frame depending on its size on the screen.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimLevelOfDetailMesh.h"
+#include "qglabstractsurface.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimLevelOfDetailMesh::QSimLevelOfDetailMesh( QObject* parent ) : QSimMeshSceneNode(parent)
+{
+   myMaximumScreenSpaceErrorInPixels = 1.0;
+   myLevelDrawnInLastFrame = 0;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimLevelOfDetailMesh::AddLevelOfDetail( QGLSceneNode* levelSceneNode, const qreal geometricError, const int numberOfTriangles )
+{
+   // The level is a QObject child (so it is deleted with this node) but not a child QGLSceneNode.
+   if( levelSceneNode == NULL ) return;
+   levelSceneNode->setParent( this );
+   QSimLevelOfDetail levelOfDetail;
+   levelOfDetail.mySceneNode = levelSceneNode;
+   levelOfDetail.myGeometricError = geometricError;
+   levelOfDetail.myNumberOfTriangles = numberOfTriangles;
+   myLevelsOfDetail.append( levelOfDetail );
+}
+
+
+//------------------------------------------------------------------------------
+int  QSimLevelOfDetailMesh::SelectLevelOfDetail( QGLPainter& painter ) const
+{
+   // A length L in this node's coordinates is about L * pixelsPerUnit pixels on the screen, where pixelsPerUnit = 0.5 * viewportHeight * projection(1,1) * scale / w.
+   // Here scale is the largest scale in the model-view matrix and w (the clip coordinate that the perspective divides by) is taken at the point of
+   // the bounding sphere nearest the camera, so the error is not underestimated anywhere on the mesh.  With an orthographic projection, w is 1.
+   const int numberOfLevels = myLevelsOfDetail.count();
+   const QGLAbstractSurface* surface = painter.currentSurface();
+   if( numberOfLevels <= 1 || surface == NULL || !myBoundingBox.isFinite() ) return 0;
+   const QMatrix4x4 modelViewMatrix = painter.modelViewMatrix().top();
+   const QMatrix4x4 projectionMatrix = painter.projectionMatrix().top();
+   const qreal modelViewScale = qMax( modelViewMatrix.column(0).toVector3D().length(), qMax( modelViewMatrix.column(1).toVector3D().length(), modelViewMatrix.column(2).toVector3D().length() ) );
+   const QVector3D eyeCenter = modelViewMatrix.map( myBoundingBox.center() );
+   const qreal eyeRadius = 0.5 * myBoundingBox.size().length() * modelViewScale;
+   const QVector3D projectionRow3( projectionMatrix(3,0), projectionMatrix(3,1), projectionMatrix(3,2) );
+   const qreal nearestW = QVector3D::dotProduct( projectionRow3, eyeCenter ) + projectionMatrix(3,3) - eyeRadius * projectionRow3.length();
+   if( nearestW <= 0 ) return 0;
+   const qreal pixelsPerUnit = 0.5 * surface->viewportGL().height() * qAbs( projectionMatrix(1,1) ) * modelViewScale / nearestW;
+
+   // Levels are ordered by increasing error, so stop at the first one that is too coarse.
+   int level = 0;
+   while( level + 1 < numberOfLevels && myLevelsOfDetail[level+1].myGeometricError * pixelsPerUnit <= myMaximumScreenSpaceErrorInPixels ) ++level;
+   return level;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimLevelOfDetailMesh::DrawWithLocalTransform( QGLPainter& painter )
+{
+   if( myLevelsOfDetail.isEmpty() ) return;
+   myLevelDrawnInLastFrame = this->SelectLevelOfDetail( painter );
+   myLevelsOfDetail[ myLevelDrawnInLastFrame ].mySceneNode->draw( &painter );
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
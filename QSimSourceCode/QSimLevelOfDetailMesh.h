@@ -0,0 +1,107 @@
+//-----------------------------------------------------------------------------
+// File:     QSimLevelOfDetailMesh.h
+// Class:    QSimLevelOfDetailMesh
+// Parents:  QGLSceneNode
+// Purpose:  Chain of increasingly simplified versions of a mesh, one of which is drawn each frame depending on its size on the screen.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMLEVELOFDETAILMESH_H__
+#define  QSIMLEVELOFDETAILMESH_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglscenenode.h"
+#include "qglpainter.h"
+#include "qbox3d.h"
+#include "CppStandardHeaders.h"
+#include "QSimMeshSceneNode.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+//------------------------------------------------------------------------------
+class QSimLevelOfDetailMesh : public QSimMeshSceneNode
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimLevelOfDetailMesh( QObject* parent = NULL );
+  ~QSimLevelOfDetailMesh()  {;}
+
+   // Levels are added from finest (level 0, usually the original mesh with geometric error 0) to coarsest.
+   // Each level's geometric error is the farthest (in this node's coordinates) its surface may be from the finest level's surface.
+   // This node takes ownership of levelSceneNode, which is not a child QGLSceneNode (so only the selected level is drawn or visited).
+   void  AddLevelOfDetail( QGLSceneNode* levelSceneNode, const qreal geometricError, const int numberOfTriangles );
+   int            GetNumberOfLevelsOfDetail() const                     { return myLevelsOfDetail.count(); }
+   QGLSceneNode&  GetLevelOfDetailSceneNode( const int level ) const    { return *myLevelsOfDetail[level].mySceneNode; }
+   qreal          GetGeometricErrorOfLevel( const int level ) const     { return myLevelsOfDetail[level].myGeometricError; }
+   int            GetNumberOfTrianglesOfLevel( const int level ) const  { return myLevelsOfDetail[level].myNumberOfTriangles; }
+
+   // Bounds of the finest level (set by whoever adds the levels).
+   void           SetBoundingBox( const QBox3D& boundingBox )  { myBoundingBox = boundingBox; }
+   const QBox3D&  GetBoundingBox() const                       { return myBoundingBox; }
+
+   // The coarsest level whose geometric error, projected onto the screen, is at most this many pixels is drawn (default is 1 pixel).
+   void   SetMaximumScreenSpaceErrorInPixels( const qreal maximumScreenSpaceErrorInPixels )  { myMaximumScreenSpaceErrorInPixels = maximumScreenSpaceErrorInPixels; }
+   qreal  GetMaximumScreenSpaceErrorInPixels() const                                        { return myMaximumScreenSpaceErrorInPixels; }
+   int    SelectLevelOfDetail( QGLPainter& painter ) const;
+
+   // Statistics (helpful for profiling).
+   int  GetLevelDrawnInLastFrame() const  { return myLevelDrawnInLastFrame; }
+
+protected:
+   // Draws the selected level.
+   virtual void  DrawWithLocalTransform( QGLPainter& painter );
+
+private:
+   struct QSimLevelOfDetail
+   {
+      QGLSceneNode*  mySceneNode;
+      qreal          myGeometricError;
+      int            myNumberOfTriangles;
+   };
+   QVector<QSimLevelOfDetail>  myLevelsOfDetail;
+   QBox3D  myBoundingBox;
+   qreal   myMaximumScreenSpaceErrorInPixels;
+   int     myLevelDrawnInLastFrame;
+
+   // Disable copying.
+   QSimLevelOfDetailMesh( const QSimLevelOfDetailMesh& );
+   QSimLevelOfDetailMesh&  operator=( const QSimLevelOfDetailMesh& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMLEVELOFDETAILMESH_H__
+//--------------------------------------------------------------------------
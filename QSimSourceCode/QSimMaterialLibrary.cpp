@@ -0,0 +1,141 @@
+//-----------------------------------------------------------------------------
+// File:     QSimMaterialLibrary.cpp
+// Class:    QSimMaterialLibrary
+// Parents:  None
+// Purpose:  Shared library of immutable materials that scene nodes reference by small handles.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimMaterialLibrary.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimMaterialLibrary&  QSimMaterialLibrary::GetQSimMaterialLibrary()  { static QSimMaterialLibrary materialLibrary;  return materialLibrary; }
+
+
+//------------------------------------------------------------------------------
+QSimMaterialLibrary::QSimMaterialLibrary()
+{
+   // The built-in materials are added in the order of their handles and hold one reference that is never released.
+   this->AcquireMaterial( QSimMaterialType::GetChinaMaterialStandard() );
+   this->AcquireMaterial( QSimMaterialType::GetChinaMaterialHighlight() );
+   this->AcquireMaterial( QSimMaterialType::GetMetalMaterialStandard() );
+   this->AcquireMaterial( QSimMaterialType::GetMetalMaterialHighlight() );
+}
+
+
+//------------------------------------------------------------------------------
+QSimMaterialLibrary::~QSimMaterialLibrary()
+{
+   const int numberOfEntries = myLibraryEntries.count();
+   for( int i=0;  i < numberOfEntries;  i++ )
+      delete myLibraryEntries[i].myMaterial;
+}
+
+
+//------------------------------------------------------------------------------
+QSimMaterialKey  QSimMaterialLibrary::GetMaterialKey( const QGLMaterial& material )
+{
+   QSimMaterialKey key;
+   key.myAmbientColor  = material.ambientColor().rgba();
+   key.myDiffuseColor  = material.diffuseColor().rgba();
+   key.mySpecularColor = material.specularColor().rgba();
+   key.myEmittedColor  = material.emittedColor().rgba();
+   key.myShininess     = material.shininess();
+   return key;
+}
+
+
+//------------------------------------------------------------------------------
+QSimMaterialHandle  QSimMaterialLibrary::AcquireMaterial( const QGLMaterial& material )
+{
+   // If a material with the same properties already exists, share it.
+   const QSimMaterialKey key = QSimMaterialLibrary::GetMaterialKey( material );
+   QHash<QSimMaterialKey, QSimMaterialHandle>::const_iterator it = myHandlesForMaterialKeys.constFind( key );
+   if( it != myHandlesForMaterialKeys.constEnd() ) return this->AcquireMaterial( it.value() );
+
+   // Otherwise reuse an entry that is no longer referenced, or add a new entry.
+   QSimMaterialHandle handle;
+   if( !myFreeHandles.isEmpty() )
+   {
+      handle = myFreeHandles.last();
+      myFreeHandles.pop_back();
+   }
+   else
+   {
+      // Every handle other than the invalid handle is in use.
+      if( myLibraryEntries.count() >= GetInvalidMaterialHandle() ) { qWarning( "QSimMaterialLibrary: Too many materials" );  return GetInvalidMaterialHandle(); }
+      QSimMaterialLibraryEntry newEntry;
+      newEntry.myMaterial = new QSimMaterialType;
+      newEntry.myReferenceCount = 0;
+      handle = (QSimMaterialHandle)myLibraryEntries.count();
+      myLibraryEntries.append( newEntry );
+   }
+
+   // Copy the material's properties into the entry (this is the only place a material in the library is modified).
+   QSimMaterialLibraryEntry& entry = myLibraryEntries[handle];
+   entry.myMaterial->SetQSimMaterialType( material );
+   entry.myMaterial->setEmittedColor( material.emittedColor() );
+   entry.myMaterialKey = key;
+   entry.myReferenceCount = 1;
+   myHandlesForMaterialKeys.insert( key, handle );
+   return handle;
+}
+
+
+//------------------------------------------------------------------------------
+QSimMaterialHandle  QSimMaterialLibrary::AcquireMaterialWithDiffuseColor( const QSimMaterialHandle handle, const QColor& newDiffuseColor )
+{
+   // Make a copy of the material as it currently exists and change the relevant properties.
+   if( handle == GetInvalidMaterialHandle() ) return handle;
+   QSimMaterialType newMaterial( this->GetMaterial(handle) );
+   newMaterial.setEmittedColor( this->GetMaterial(handle).emittedColor() );
+   newMaterial.setDiffuseColor( newDiffuseColor );
+   return this->AcquireMaterial( newMaterial );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimMaterialLibrary::ReleaseMaterial( const QSimMaterialHandle handle )
+{
+   // When the last reference is released, the entry is available to be reused for a different material.
+   if( handle == GetInvalidMaterialHandle() ) return;
+   QSimMaterialLibraryEntry& entry = myLibraryEntries[handle];
+   if( entry.myReferenceCount == 0 || --(entry.myReferenceCount) > 0 ) return;
+   myHandlesForMaterialKeys.remove( entry.myMaterialKey );
+   myFreeHandles.append( handle );
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// File:     QSimMaterialLibrary.h
+// Class:    QSimMaterialLibrary
+// Parents:  None
+// Purpose:  Shared library of immutable materials that scene nodes reference by small handles.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMMATERIALLIBRARY_H__
+#define  QSIMMATERIALLIBRARY_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglmaterial.h"
+#include "CppStandardHeaders.h"
+#include "QSimMaterialType.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Scene nodes refer to materials by a handle (an index into the library) rather than owning a QGLMaterial.
+typedef unsigned short  QSimMaterialHandle;
+
+// Materials are interned by the value of their colors and shininess.
+struct QSimMaterialKey
+{
+   QRgb   myAmbientColor, myDiffuseColor, mySpecularColor, myEmittedColor;
+   qreal  myShininess;
+   bool  operator==( const QSimMaterialKey& other ) const  { return myAmbientColor == other.myAmbientColor && myDiffuseColor == other.myDiffuseColor && mySpecularColor == other.mySpecularColor && myEmittedColor == other.myEmittedColor && myShininess == other.myShininess; }
+};
+inline uint  qHash( const QSimMaterialKey& key )  { return key.myAmbientColor ^ (key.myDiffuseColor << 1) ^ (key.mySpecularColor << 2) ^ (key.myEmittedColor << 3) ^ (uint)key.myShininess; }
+
+
+//------------------------------------------------------------------------------
+class QSimMaterialLibrary
+{
+public:
+   // There is one material library that is shared by all scene nodes (it is only used from the GUI thread).
+   static QSimMaterialLibrary&  GetQSimMaterialLibrary();
+
+   // Some standard materials for objects (built-in and never removed from the library).
+   static QSimMaterialHandle  GetChinaMaterialStandardHandle()   { return 0; }
+   static QSimMaterialHandle  GetChinaMaterialHighlightHandle()  { return 1; }
+   static QSimMaterialHandle  GetMetalMaterialStandardHandle()   { return 2; }
+   static QSimMaterialHandle  GetMetalMaterialHighlightHandle()  { return 3; }
+
+   // Returned when the library is full (every handle is in use).  It is never stored in a scene node, and acquiring or releasing it does nothing.
+   static QSimMaterialHandle  GetInvalidMaterialHandle()         { return 0xFFFF; }
+
+   // Materials in the library are immutable.  To "change" a material, acquire a handle to a material with the new properties
+   // (which reuses a matching material if one already exists), then release the handle to the old material.
+   QSimMaterialHandle  AcquireMaterial( const QGLMaterial& material );
+   QSimMaterialHandle  AcquireMaterial( const QSimMaterialHandle handle )  { if( handle != GetInvalidMaterialHandle() ) ++(myLibraryEntries[handle].myReferenceCount);  return handle; }
+   QSimMaterialHandle  AcquireMaterialWithDiffuseColor( const QSimMaterialHandle handle, const QColor& newDiffuseColor );
+   void                ReleaseMaterial( const QSimMaterialHandle handle );
+
+   // Get the material associated with a handle.
+   const QSimMaterialType&  GetMaterial( const QSimMaterialHandle handle ) const  { return *( myLibraryEntries[handle].myMaterial ); }
+
+   // Number of materials currently referenced by at least one scene node (or built-in).
+   unsigned int  GetNumberOfMaterialsInUse() const  { return myLibraryEntries.count() - myFreeHandles.count(); }
+
+private:
+   // Constructors and destructors (use GetQSimMaterialLibrary).
+   QSimMaterialLibrary();
+  ~QSimMaterialLibrary();
+
+   // Key used to find an existing material with the same properties.
+   static QSimMaterialKey  GetMaterialKey( const QGLMaterial& material );
+
+   // Each entry owns one material.  Entries whose reference count drops to zero are recycled (their material object is reused).
+   struct QSimMaterialLibraryEntry
+   {
+      QSimMaterialType*  myMaterial;
+      QSimMaterialKey    myMaterialKey;
+      unsigned int       myReferenceCount;
+   };
+   QVector<QSimMaterialLibraryEntry>           myLibraryEntries;
+   QVector<QSimMaterialHandle>                 myFreeHandles;
+   QHash<QSimMaterialKey, QSimMaterialHandle>  myHandlesForMaterialKeys;
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMMATERIALLIBRARY_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,1107 @@
+//-----------------------------------------------------------------------------
+// File:     QSimMeshImporter.cpp
+// Class:    QSimMeshImporter
+// Parents:  QObject
+// Purpose:  Reads triangle meshes (.obj, .stl, and .vtp files) and tetrahedral meshes (TetGen .ele) on worker threads and adds each as an object to a view widget.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <QtConcurrentRun>
+#include <QXmlStreamReader>
+#include <climits>
+#include <cstring>
+#include "qgeometrydata.h"
+#include "QSimMeshImporter.h"
+#include "QSimSceneNode.h"
+#include "QSimGLViewWidget.h"
+#include "QSimClusteredMesh.h"
+#include "QSimTetrahedralMesh.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+static int  GetNumberOfMeshImporterChunks( const qint64 numberOfBytes )
+{
+   // Chunks of at least a megabyte (so small files are not split), and several per worker thread (so threads finish together).
+   const qint64 maximumNumberOfChunks = 4 * qMax( 1, QThread::idealThreadCount() );
+   return (int)qBound( (qint64)1, numberOfBytes / (1 << 20), maximumNumberOfChunks );
+}
+
+
+//------------------------------------------------------------------------------
+template <class QSimMeshImporterTask>
+static bool  RunTasksOnWorkerThreads( QVector<QSimMeshImporterTask>& tasks, void (*taskFunction)( QSimMeshImporterTask* ), QProgressDialog& progressDialog, const int firstProgressValue, const int lastProgressValue )
+{
+   // All tasks are queued for the global thread pool, then waited for in order (the progress dialog processes events each time its value is set).
+   // Even when canceled, every task is finished before returning, as tasks refer to the caller's data.
+   QList< QFuture<void> > futures;
+   for( int i=0;  i < tasks.count();  i++ ) futures.append( QtConcurrent::run( taskFunction, &tasks[i] ) );
+   bool wasCanceled = false;
+   for( int i=0;  i < futures.count();  i++ )
+   {
+      futures[i].waitForFinished();
+      progressDialog.setValue( firstProgressValue + (lastProgressValue - firstProgressValue) * (i+1) / futures.count() );
+      wasCanceled = wasCanceled || progressDialog.wasCanceled();
+   }
+   return !wasCanceled;
+}
+
+
+//------------------------------------------------------------------------------
+static bool  IsSpaceCharacter( const char c )  { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+
+//------------------------------------------------------------------------------
+static const char*  ParseFloatNumber( const char* p, const char* end, float& value )
+{
+   // Returns the character after the number, or NULL if there is no number (leading spaces are skipped).
+   // Numbers are parsed here rather than with strtod, which is slower and depends on the locale's decimal point.
+   while( p < end && IsSpaceCharacter(*p) ) ++p;
+   bool isNegative = false;
+   if( p < end && (*p == '-' || *p == '+') ) { isNegative = *p == '-';  ++p; }
+   double mantissa = 0;
+   int numberOfDigits = 0, exponent = 0;
+   while( p < end && *p >= '0' && *p <= '9' ) { mantissa = 10 * mantissa + (*p - '0');  ++p;  ++numberOfDigits; }
+   if( p < end && *p == '.' )
+   {
+      ++p;
+      while( p < end && *p >= '0' && *p <= '9' ) { mantissa = 10 * mantissa + (*p - '0');  ++p;  ++numberOfDigits;  --exponent; }
+   }
+   if( numberOfDigits == 0 ) return NULL;
+   if( p < end && (*p == 'e' || *p == 'E') )
+   {
+      const char* q = p + 1;
+      bool isExponentNegative = false;
+      if( q < end && (*q == '-' || *q == '+') ) { isExponentNegative = *q == '-';  ++q; }
+      int exponentInFile = 0, numberOfExponentDigits = 0;
+      while( q < end && *q >= '0' && *q <= '9' ) { if( exponentInFile < 10000 ) exponentInFile = 10 * exponentInFile + (*q - '0');  ++q;  ++numberOfExponentDigits; }
+      if( numberOfExponentDigits > 0 ) { exponent += isExponentNegative ? -exponentInFile : exponentInFile;  p = q; }
+   }
+   const double magnitude = exponent != 0 ? mantissa * pow( 10.0, exponent ) : mantissa;
+   value = (float)( isNegative ? -magnitude : magnitude );
+   return p;
+}
+
+
+//------------------------------------------------------------------------------
+static const char*  ParseIntegerNumber( const char* p, const char* end, int& value )
+{
+   // Returns the character after the number, or NULL if there is no number (leading spaces are skipped).
+   while( p < end && IsSpaceCharacter(*p) ) ++p;
+   bool isNegative = false;
+   if( p < end && (*p == '-' || *p == '+') ) { isNegative = *p == '-';  ++p; }
+   qint64 magnitude = 0;
+   int numberOfDigits = 0;
+   while( p < end && *p >= '0' && *p <= '9' ) { if( magnitude <= INT_MAX ) magnitude = 10 * magnitude + (*p - '0');  ++p;  ++numberOfDigits; }
+   if( numberOfDigits == 0 || magnitude > INT_MAX ) return NULL;
+   value = isNegative ? -(int)magnitude : (int)magnitude;
+   return p;
+}
+
+
+//------------------------------------------------------------------------------
+static QVector<const char*>  SplitIntoChunksAfterLine( const char* begin, const char* end, const int numberOfChunks, const char* lineStartOrNull )
+{
+   // Chunk boundaries (numberOfChunks + 1 pointers, first is begin and last is end) are moved forward to the start of a line,
+   // or if lineStartOrNull is not NULL, to the line after the next line that contains lineStartOrNull (e.g., "endfacet").
+   QVector<const char*> boundaries;
+   boundaries.append( begin );
+   for( int i=1;  i < numberOfChunks;  i++ )
+   {
+      const char* p = qMax( boundaries.last(), begin + (qint64)(end - begin) * i / numberOfChunks );
+      if( lineStartOrNull )
+      {
+         const int markerIndex = QByteArray::fromRawData( p, end - p ).indexOf( lineStartOrNull );
+         p = markerIndex >= 0 ? p + markerIndex : end;
+      }
+      const char* newline = p < end ? static_cast<const char*>( memchr( p, '\n', end - p ) ) : NULL;
+      boundaries.append( newline ? newline + 1 : end );
+   }
+   boundaries.append( end );
+   return boundaries;
+}
+
+
+//------------------------------------------------------------------------------
+// OBJ files are parsed one chunk (of whole lines) per task.  OBJ indices start at 1, and negative indices count back from the most
+// recent element, so each corner's indices (position, texture coordinate, normal) are either 0-based indices in the whole file or,
+// if marked in myCornerIsRelativeFlags, 0-based indices relative to the start of the chunk (known once all chunks are parsed).
+struct QSimObjChunk
+{
+   // Parsed from the chunk.
+   const char*      myBegin;
+   const char*      myEnd;
+   QVector<float>   myPositions, myNormals, myTextureCoordinates;
+   QVector<int>     myCornerIndices;
+   QVector<quint8>  myCornerIsRelativeFlags;
+   int              myNumberOfCornersWithoutNormal, myNumberOfCornersWithoutTextureCoordinate;
+   bool             myIsValid;
+
+   // Set once all chunks are parsed (elements of the whole file, and where this chunk's corners go).
+   int              myPositionOffset, myNormalOffset, myTextureCoordinateOffset;
+   const float*     myAllPositions;  int myNumberOfPositions;
+   const float*     myAllNormals;    int myNumberOfNormals;
+   const float*     myAllTextureCoordinates;  int myNumberOfTextureCoordinates;
+   float*           myCornerPositions;
+   float*           myCornerNormalsOrNull;
+   float*           myCornerTextureCoordinatesOrNull;
+};
+static const int  QSimObjIndexIsMissing = INT_MIN;
+
+
+//------------------------------------------------------------------------------
+static void  ParseObjChunk( QSimObjChunk* chunk )
+{
+   chunk->myIsValid = true;
+   chunk->myNumberOfCornersWithoutNormal = chunk->myNumberOfCornersWithoutTextureCoordinate = 0;
+   const char* end = chunk->myEnd;
+   for( const char* p = chunk->myBegin;  p < end && chunk->myIsValid;  )
+   {
+      const char* lineEnd = static_cast<const char*>( memchr( p, '\n', end - p ) );
+      if( lineEnd == NULL ) lineEnd = end;
+      while( p < lineEnd && (*p == ' ' || *p == '\t') ) ++p;
+      const bool isSpaceAfter1 = lineEnd - p > 1 && (p[1] == ' ' || p[1] == '\t');
+      const bool isSpaceAfter2 = lineEnd - p > 2 && (p[2] == ' ' || p[2] == '\t');
+      float x, y, z;
+
+      // Positions (v x y z), normals (vn x y z), and texture coordinates (vt u [v]).  Other statements (e.g., groups and materials) are ignored.
+      if( p < lineEnd && p[0] == 'v' && isSpaceAfter1 )
+      {
+         const char* q = ParseFloatNumber( p + 1, lineEnd, x );
+         if( q ) q = ParseFloatNumber( q, lineEnd, y );
+         if( q ) q = ParseFloatNumber( q, lineEnd, z );
+         if( q ) { chunk->myPositions.append( x );  chunk->myPositions.append( y );  chunk->myPositions.append( z ); }
+         else chunk->myIsValid = false;
+      }
+      else if( lineEnd - p > 1 && p[0] == 'v' && p[1] == 'n' && isSpaceAfter2 )
+      {
+         const char* q = ParseFloatNumber( p + 2, lineEnd, x );
+         if( q ) q = ParseFloatNumber( q, lineEnd, y );
+         if( q ) q = ParseFloatNumber( q, lineEnd, z );
+         if( q ) { chunk->myNormals.append( x );  chunk->myNormals.append( y );  chunk->myNormals.append( z ); }
+         else chunk->myIsValid = false;
+      }
+      else if( lineEnd - p > 1 && p[0] == 'v' && p[1] == 't' && isSpaceAfter2 )
+      {
+         const char* q = ParseFloatNumber( p + 2, lineEnd, x );
+         if( q == NULL ) chunk->myIsValid = false;
+         else
+         {
+            if( ParseFloatNumber( q, lineEnd, y ) == NULL ) y = 0;
+            chunk->myTextureCoordinates.append( x );  chunk->myTextureCoordinates.append( y );
+         }
+      }
+
+      // Faces (f v1/t1/n1 v2/t2/n2 v3/t3/n3 ...) with any number of corners are split into a fan of triangles.
+      else if( p < lineEnd && p[0] == 'f' && isSpaceAfter1 )
+      {
+         const int numberOfElementsSoFar[3] = { chunk->myPositions.count() / 3, chunk->myTextureCoordinates.count() / 2, chunk->myNormals.count() / 3 };
+         int firstCorner[3], previousCorner[3];
+         quint8 firstCornerFlags = 0, previousCornerFlags = 0;
+         int numberOfCornersInFace = 0;
+         const char* q = p + 1;
+         while( chunk->myIsValid )
+         {
+            int corner[3] = { QSimObjIndexIsMissing, QSimObjIndexIsMissing, QSimObjIndexIsMissing };
+            quint8 cornerFlags = 0;
+            int indexInFile = 0;
+            q = ParseIntegerNumber( q, lineEnd, indexInFile );
+            if( q == NULL ) break;
+            for( int field = 0;  field < 3;  field++ )
+            {
+               if( field > 0 )
+               {
+                  // A field is present only after a slash (e.g., v//n has no texture coordinate).
+                  if( q >= lineEnd || *q != '/' ) break;
+                  ++q;
+                  if( q < lineEnd && *q == '/' ) continue;
+                  const char* r = ParseIntegerNumber( q, lineEnd, indexInFile );
+                  if( r == NULL ) continue;
+                  q = r;
+               }
+               if( indexInFile == 0 ) { chunk->myIsValid = false;  break; }
+               if( indexInFile > 0 ) corner[field] = indexInFile - 1;
+               else { corner[field] = numberOfElementsSoFar[field] + indexInFile;  cornerFlags |= (1 << field); }
+            }
+
+            // Triangles (first, previous, this) once there are three corners.
+            if( numberOfCornersInFace == 0 ) { memcpy( firstCorner, corner, sizeof(corner) );  firstCornerFlags = cornerFlags; }
+            else if( numberOfCornersInFace >= 2 )
+            {
+               chunk->myCornerIndices << firstCorner[0]    << firstCorner[1]    << firstCorner[2];
+               chunk->myCornerIndices << previousCorner[0] << previousCorner[1] << previousCorner[2];
+               chunk->myCornerIndices << corner[0]         << corner[1]         << corner[2];
+               chunk->myCornerIsRelativeFlags << firstCornerFlags << previousCornerFlags << cornerFlags;
+               chunk->myNumberOfCornersWithoutTextureCoordinate += (firstCorner[1] == QSimObjIndexIsMissing) + (previousCorner[1] == QSimObjIndexIsMissing) + (corner[1] == QSimObjIndexIsMissing);
+               chunk->myNumberOfCornersWithoutNormal            += (firstCorner[2] == QSimObjIndexIsMissing) + (previousCorner[2] == QSimObjIndexIsMissing) + (corner[2] == QSimObjIndexIsMissing);
+            }
+            memcpy( previousCorner, corner, sizeof(corner) );  previousCornerFlags = cornerFlags;
+            ++numberOfCornersInFace;
+         }
+      }
+      p = lineEnd + 1;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+static void  CopyObjChunkToCorners( QSimObjChunk* chunk )
+{
+   // Look up each corner's position (and normal and texture coordinate, if every corner has one) in the elements of the whole file.
+   const int offsets[3] = { chunk->myPositionOffset, chunk->myTextureCoordinateOffset, chunk->myNormalOffset };
+   const int numberOfElements[3] = { chunk->myNumberOfPositions, chunk->myNumberOfTextureCoordinates, chunk->myNumberOfNormals };
+   const int numberOfCorners = chunk->myCornerIsRelativeFlags.count();
+   for( int i=0;  i < numberOfCorners;  i++ )
+   {
+      int index[3];
+      for( int field = 0;  field < 3;  field++ )
+      {
+         index[field] = chunk->myCornerIndices[3*i + field];
+         if( chunk->myCornerIsRelativeFlags[i] & (1 << field) ) index[field] += offsets[field];
+         const bool isFieldNeeded = field == 0 || ( field == 1 && chunk->myCornerTextureCoordinatesOrNull ) || ( field == 2 && chunk->myCornerNormalsOrNull );
+         if( isFieldNeeded && ( index[field] < 0 || index[field] >= numberOfElements[field] ) ) { chunk->myIsValid = false;  return; }
+      }
+      memcpy( chunk->myCornerPositions + 3*i, chunk->myAllPositions + 3*index[0], 3 * sizeof(float) );
+      if( chunk->myCornerTextureCoordinatesOrNull ) memcpy( chunk->myCornerTextureCoordinatesOrNull + 2*i, chunk->myAllTextureCoordinates + 2*index[1], 2 * sizeof(float) );
+      if( chunk->myCornerNormalsOrNull )            memcpy( chunk->myCornerNormalsOrNull + 3*i,            chunk->myAllNormals + 3*index[2],            3 * sizeof(float) );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+QString  QSimMeshImporter::ReadObjFile( const char* fileContents, const qint64 numberOfBytes, QSimMeshCorners& corners, QProgressDialog& progressDialog )
+{
+   // Parse chunks of whole lines on worker threads.
+   const QVector<const char*> boundaries = SplitIntoChunksAfterLine( fileContents, fileContents + numberOfBytes, GetNumberOfMeshImporterChunks( numberOfBytes ), NULL );
+   QVector<QSimObjChunk> chunks( boundaries.count() - 1 );
+   for( int i=0;  i < chunks.count();  i++ ) { chunks[i].myBegin = boundaries[i];  chunks[i].myEnd = boundaries[i+1]; }
+   if( !RunTasksOnWorkerThreads( chunks, ParseObjChunk, progressDialog, 0, 40 ) ) return QString();
+
+   // Gather the positions, normals, and texture coordinates of the whole file (each chunk's elements follow the previous chunk's).
+   QVector<float> allPositions, allNormals, allTextureCoordinates;
+   int numberOfCorners = 0, numberOfCornersWithoutNormal = 0, numberOfCornersWithoutTextureCoordinate = 0;
+   for( int i=0;  i < chunks.count();  i++ )
+   {
+      QSimObjChunk& chunk = chunks[i];
+      if( !chunk.myIsValid ) return tr("The file has a line that could not be read.");
+      chunk.myPositionOffset = allPositions.count() / 3;
+      chunk.myNormalOffset = allNormals.count() / 3;
+      chunk.myTextureCoordinateOffset = allTextureCoordinates.count() / 2;
+      allPositions += chunk.myPositions;                    chunk.myPositions.clear();
+      allNormals += chunk.myNormals;                        chunk.myNormals.clear();
+      allTextureCoordinates += chunk.myTextureCoordinates;  chunk.myTextureCoordinates.clear();
+      numberOfCorners += chunk.myCornerIsRelativeFlags.count();
+      numberOfCornersWithoutNormal += chunk.myNumberOfCornersWithoutNormal;
+      numberOfCornersWithoutTextureCoordinate += chunk.myNumberOfCornersWithoutTextureCoordinate;
+   }
+
+   // Normals and texture coordinates are kept only if every corner has one.
+   corners.myPositions.resize( 3 * numberOfCorners );
+   corners.myNormals.resize(            numberOfCornersWithoutNormal            == 0 && !allNormals.isEmpty()            ? 3 * numberOfCorners : 0 );
+   corners.myTextureCoordinates.resize( numberOfCornersWithoutTextureCoordinate == 0 && !allTextureCoordinates.isEmpty() ? 2 * numberOfCorners : 0 );
+   for( int i=0, cornerOffset = 0;  i < chunks.count();  i++ )
+   {
+      QSimObjChunk& chunk = chunks[i];
+      chunk.myAllPositions = allPositions.constData();                    chunk.myNumberOfPositions = allPositions.count() / 3;
+      chunk.myAllNormals = allNormals.constData();                        chunk.myNumberOfNormals = allNormals.count() / 3;
+      chunk.myAllTextureCoordinates = allTextureCoordinates.constData();  chunk.myNumberOfTextureCoordinates = allTextureCoordinates.count() / 2;
+      chunk.myCornerPositions = corners.myPositions.data() + 3 * cornerOffset;
+      chunk.myCornerNormalsOrNull = corners.myNormals.isEmpty() ? NULL : corners.myNormals.data() + 3 * cornerOffset;
+      chunk.myCornerTextureCoordinatesOrNull = corners.myTextureCoordinates.isEmpty() ? NULL : corners.myTextureCoordinates.data() + 2 * cornerOffset;
+      cornerOffset += chunk.myCornerIsRelativeFlags.count();
+   }
+   if( !RunTasksOnWorkerThreads( chunks, CopyObjChunkToCorners, progressDialog, 40, 55 ) ) return QString();
+   for( int i=0;  i < chunks.count();  i++ )
+      if( !chunks[i].myIsValid ) return tr("A face refers to a vertex, normal, or texture coordinate that does not exist.");
+   return QString();
+}
+
+
+//------------------------------------------------------------------------------
+// STL files are parsed one chunk per task: a range of 50-byte triangles (binary) or of whole facets (ASCII).
+struct QSimStlChunk
+{
+   const char*     myBegin;
+   const char*     myEnd;
+   QVector<float>  myPositions;
+   float*          myCornerPositionsOrNull;
+   bool            myIsValid;
+};
+
+
+//------------------------------------------------------------------------------
+static void  ParseBinaryStlChunk( QSimStlChunk* chunk )
+{
+   // Each triangle is a facet normal (ignored), three vertices, and a 2-byte attribute, as little-endian floats.
+   chunk->myIsValid = true;
+   float* corner = chunk->myCornerPositionsOrNull;
+   for( const char* triangle = chunk->myBegin;  triangle + 50 <= chunk->myEnd;  triangle += 50 )
+   {
+      for( int i=0;  i < 9;  i++ )
+      {
+         const quint32 bits = qFromLittleEndian<quint32>( reinterpret_cast<const uchar*>( triangle + 12 + 4*i ) );
+         memcpy( corner++, &bits, sizeof(float) );
+      }
+   }
+}
+
+
+//------------------------------------------------------------------------------
+static void  ParseAsciiStlChunk( QSimStlChunk* chunk )
+{
+   // Only vertex lines matter (facet normals are ignored).  Chunks end after an endfacet line, so each holds whole triangles.
+   chunk->myIsValid = true;
+   const char* end = chunk->myEnd;
+   for( const char* p = chunk->myBegin;  p < end && chunk->myIsValid;  )
+   {
+      const char* lineEnd = static_cast<const char*>( memchr( p, '\n', end - p ) );
+      if( lineEnd == NULL ) lineEnd = end;
+      while( p < lineEnd && (*p == ' ' || *p == '\t') ) ++p;
+      if( lineEnd - p > 6 && memcmp( p, "vertex", 6 ) == 0 )
+      {
+         float x, y, z;
+         const char* q = ParseFloatNumber( p + 6, lineEnd, x );
+         if( q ) q = ParseFloatNumber( q, lineEnd, y );
+         if( q ) q = ParseFloatNumber( q, lineEnd, z );
+         if( q ) { chunk->myPositions.append( x );  chunk->myPositions.append( y );  chunk->myPositions.append( z ); }
+         else chunk->myIsValid = false;
+      }
+      p = lineEnd + 1;
+   }
+   if( chunk->myPositions.count() % 9 != 0 ) chunk->myIsValid = false;
+}
+
+
+//------------------------------------------------------------------------------
+QString  QSimMeshImporter::ReadStlFile( const char* fileContents, const qint64 numberOfBytes, QSimMeshCorners& corners, QProgressDialog& progressDialog )
+{
+   // A binary STL file is an 80-byte header, the number of triangles, and 50 bytes per triangle (some binary files also start with "solid").
+   const quint32 numberOfBinaryTriangles = numberOfBytes >= 84 ? qFromLittleEndian<quint32>( reinterpret_cast<const uchar*>( fileContents + 80 ) ) : 0;
+   const bool isBinary = numberOfBytes >= 84 && 84 + 50 * (qint64)numberOfBinaryTriangles == numberOfBytes;
+   const char* end = fileContents + numberOfBytes;
+   QVector<QSimStlChunk> chunks( GetNumberOfMeshImporterChunks( numberOfBytes ) );
+   if( isBinary )
+   {
+      // Each chunk writes its triangles directly into corners.
+      corners.myPositions.resize( 9 * numberOfBinaryTriangles );
+      const int numberOfChunks = chunks.count();
+      for( int i=0;  i < numberOfChunks;  i++ )
+      {
+         const qint64 firstTriangle = numberOfBinaryTriangles * (qint64)i / numberOfChunks;
+         const qint64 endTriangle = numberOfBinaryTriangles * (qint64)(i+1) / numberOfChunks;
+         chunks[i].myBegin = fileContents + 84 + 50 * firstTriangle;
+         chunks[i].myEnd = fileContents + 84 + 50 * endTriangle;
+         chunks[i].myCornerPositionsOrNull = corners.myPositions.data() + 9 * firstTriangle;
+      }
+      RunTasksOnWorkerThreads( chunks, ParseBinaryStlChunk, progressDialog, 0, 55 );
+      return QString();
+   }
+
+   // ASCII STL (solid ... facet normal ... outer loop, vertex x y z (three times), endloop, endfacet ... endsolid).
+   const QVector<const char*> boundaries = SplitIntoChunksAfterLine( fileContents, end, chunks.count(), "endfacet" );
+   for( int i=0;  i < chunks.count();  i++ ) { chunks[i].myBegin = boundaries[i];  chunks[i].myEnd = boundaries[i+1];  chunks[i].myCornerPositionsOrNull = NULL; }
+   if( !RunTasksOnWorkerThreads( chunks, ParseAsciiStlChunk, progressDialog, 0, 50 ) ) return QString();
+   for( int i=0;  i < chunks.count();  i++ )
+   {
+      if( !chunks[i].myIsValid ) return tr("The file is neither a binary STL file nor an ASCII STL file with three vertices per facet.");
+      corners.myPositions += chunks[i].myPositions;
+      chunks[i].myPositions.clear();
+   }
+   return QString();
+}
+
+
+//------------------------------------------------------------------------------
+// Numbers in a VTP data array (whitespace-separated ASCII) are parsed one chunk per task.
+struct QSimNumberChunk
+{
+   const char*     myBegin;
+   const char*     myEnd;
+   bool            myIsInteger;
+   QVector<float>  myFloats;
+   QVector<int>    myIntegers;
+   bool            myIsValid;
+};
+
+
+//------------------------------------------------------------------------------
+static void  ParseNumberChunk( QSimNumberChunk* chunk )
+{
+   chunk->myIsValid = true;
+   const char* p = chunk->myBegin;
+   const char* end = chunk->myEnd;
+   while( true )
+   {
+      while( p < end && IsSpaceCharacter(*p) ) ++p;
+      if( p >= end ) break;
+      float floatValue;
+      int integerValue;
+      p = chunk->myIsInteger ? ParseIntegerNumber( p, end, integerValue ) : ParseFloatNumber( p, end, floatValue );
+      if( p == NULL || (p < end && !IsSpaceCharacter(*p)) ) { chunk->myIsValid = false;  break; }
+      if( chunk->myIsInteger ) chunk->myIntegers.append( integerValue );
+      else                     chunk->myFloats.append( floatValue );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+static bool  ParseNumbersOnWorkerThreads( const char* begin, const char* end, const bool isInteger, QVector<float>& floats, QVector<int>& integers, QProgressDialog& progressDialog, const int firstProgressValue, const int lastProgressValue )
+{
+   // Chunk boundaries are moved forward to whitespace, so no number is split.
+   QVector<QSimNumberChunk> chunks( GetNumberOfMeshImporterChunks( end - begin ) );
+   const char* chunkBegin = begin;
+   for( int i=0;  i < chunks.count();  i++ )
+   {
+      const char* chunkEnd = ( i + 1 == chunks.count() ) ? end : qMax( chunkBegin, begin + (qint64)(end - begin) * (i+1) / chunks.count() );
+      while( chunkEnd < end && !IsSpaceCharacter(*chunkEnd) ) ++chunkEnd;
+      chunks[i].myBegin = chunkBegin;
+      chunks[i].myEnd = chunkEnd;
+      chunks[i].myIsInteger = isInteger;
+      chunkBegin = chunkEnd;
+   }
+   if( !RunTasksOnWorkerThreads( chunks, ParseNumberChunk, progressDialog, firstProgressValue, lastProgressValue ) ) return false;
+   for( int i=0;  i < chunks.count();  i++ )
+   {
+      if( !chunks[i].myIsValid ) return false;
+      floats += chunks[i].myFloats;
+      integers += chunks[i].myIntegers;
+   }
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+// Corners of a range of triangles whose corners are indices into the points of a VTP file.
+struct QSimIndexedCornerChunk
+{
+   const int*    myPointIndices;
+   int           myFirstCorner, myEndCorner;
+   const float*  myPoints;
+   const float*  myPointNormalsOrNull;
+   int           myNumberOfPoints;
+   float*        myCornerPositions;
+   float*        myCornerNormalsOrNull;
+   bool          myIsValid;
+};
+
+
+//------------------------------------------------------------------------------
+static void  CopyIndexedCornerChunkToCorners( QSimIndexedCornerChunk* chunk )
+{
+   chunk->myIsValid = true;
+   for( int i = chunk->myFirstCorner;  i < chunk->myEndCorner;  i++ )
+   {
+      const int pointIndex = chunk->myPointIndices[i];
+      if( pointIndex < 0 || pointIndex >= chunk->myNumberOfPoints ) { chunk->myIsValid = false;  return; }
+      memcpy( chunk->myCornerPositions + 3*i, chunk->myPoints + 3*pointIndex, 3 * sizeof(float) );
+      if( chunk->myCornerNormalsOrNull ) memcpy( chunk->myCornerNormalsOrNull + 3*i, chunk->myPointNormalsOrNull + 3*pointIndex, 3 * sizeof(float) );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+QString  QSimMeshImporter::ReadVtpFile( const char* fileContents, const qint64 numberOfBytes, QSimMeshCorners& corners, QProgressDialog& progressDialog )
+{
+   // The XML structure is small, so it is read on this thread.  Each data array's text (which is most of the file) is only located here
+   // (it is everything between the DataArray start tag and the next '<') and then parsed on worker threads.
+   const QByteArray fileBytes = QByteArray::fromRawData( fileContents, numberOfBytes );
+   QXmlStreamReader reader( fileBytes );
+   const char* pointsBegin = NULL;        const char* pointsEnd = NULL;
+   const char* normalsBegin = NULL;       const char* normalsEnd = NULL;
+   const char* connectivityBegin = NULL;  const char* connectivityEnd = NULL;
+   const char* offsetsBegin = NULL;       const char* offsetsEnd = NULL;
+   QString section, normalsName;
+   int numberOfPieces = 0;
+   while( !reader.atEnd() && numberOfPieces <= 1 )
+   {
+      reader.readNext();
+      if( reader.isEndElement() ) section.clear();
+      if( !reader.isStartElement() ) continue;
+      const QString elementName = reader.name().toString();
+      const QXmlStreamAttributes attributes = reader.attributes();
+      if( elementName == "Piece" ) { ++numberOfPieces;  continue; }
+      if( elementName == "Points" || elementName == "Polys" ) { section = elementName;  continue; }
+      if( elementName == "PointData" ) { section = elementName;  normalsName = attributes.value( QLatin1String("Normals") ).toString();  continue; }
+      if( elementName != "DataArray" ) continue;
+
+      // Only the points, normals, and polygons are needed (other arrays are skipped).
+      const QString arrayName = attributes.value( QLatin1String("Name") ).toString();
+      const char** textBegin = NULL;
+      const char** textEnd = NULL;
+      if( section == "Points" )                                                                { textBegin = &pointsBegin;        textEnd = &pointsEnd; }
+      else if( section == "PointData" && !normalsName.isEmpty() && arrayName == normalsName )  { textBegin = &normalsBegin;       textEnd = &normalsEnd; }
+      else if( section == "Polys" && arrayName == "connectivity" )                             { textBegin = &connectivityBegin;  textEnd = &connectivityEnd; }
+      else if( section == "Polys" && arrayName == "offsets" )                                  { textBegin = &offsetsBegin;       textEnd = &offsetsEnd; }
+      if( textBegin != NULL )
+      {
+         // Locate the array's text (the reader has just read the start tag, and the file's text is ASCII, so characters are bytes).
+         if( attributes.value( QLatin1String("format") ).toString() != "ascii" ) return tr("Only VTP files with ASCII data arrays (format=\"ascii\") can be read.");
+         const qint64 textOffset = reader.characterOffset();
+         if( textOffset <= 0 || textOffset > numberOfBytes || fileContents[textOffset-1] != '>' ) return tr("The file is not a VTK PolyData file that can be read.");
+         *textBegin = fileContents + textOffset;
+         *textEnd = static_cast<const char*>( memchr( *textBegin, '<', numberOfBytes - textOffset ) );
+         if( *textEnd == NULL ) *textEnd = fileContents + numberOfBytes;
+      }
+      reader.skipCurrentElement();
+   }
+   if( reader.hasError() ) return tr("The file is not valid XML (%1).").arg( reader.errorString() );
+   if( pointsBegin == NULL || connectivityBegin == NULL || offsetsBegin == NULL ) return tr("The file has no points or polygons.");
+
+   // Parse the arrays on worker threads.
+   QVector<float> points, pointNormals, unusedFloats;
+   QVector<int> connectivity, offsets, unusedIntegers;
+   if( !ParseNumbersOnWorkerThreads( pointsBegin, pointsEnd, false, points, unusedIntegers, progressDialog, 0, 20 ) ) return progressDialog.wasCanceled() ? QString() : tr("The points could not be read.");
+   if( normalsBegin && !ParseNumbersOnWorkerThreads( normalsBegin, normalsEnd, false, pointNormals, unusedIntegers, progressDialog, 20, 30 ) ) return progressDialog.wasCanceled() ? QString() : tr("The normals could not be read.");
+   if( !ParseNumbersOnWorkerThreads( connectivityBegin, connectivityEnd, true, unusedFloats, connectivity, progressDialog, 30, 40 ) ) return progressDialog.wasCanceled() ? QString() : tr("The polygons could not be read.");
+   if( !ParseNumbersOnWorkerThreads( offsetsBegin, offsetsEnd, true, unusedFloats, offsets, progressDialog, 40, 45 ) ) return progressDialog.wasCanceled() ? QString() : tr("The polygons could not be read.");
+   if( points.count() % 3 != 0 ) return tr("The points could not be read.");
+   if( pointNormals.count() != points.count() ) pointNormals.clear();
+
+   // Split each polygon (the points in connectivity up to its offset) into a fan of triangles.
+   QVector<int> pointIndexOfCorners;
+   pointIndexOfCorners.reserve( 3 * qMax( 0, connectivity.count() - 2 * offsets.count() ) );
+   for( int i=0, polygonBegin = 0;  i < offsets.count();  polygonBegin = offsets[i++] )
+   {
+      const int polygonEnd = offsets[i];
+      if( polygonEnd < polygonBegin || polygonEnd > connectivity.count() ) return tr("The polygons could not be read.");
+      for( int j = polygonBegin + 1;  j + 1 < polygonEnd;  j++ ) pointIndexOfCorners << connectivity[polygonBegin] << connectivity[j] << connectivity[j+1];
+   }
+
+   // Copy the points of the corners on worker threads.
+   const int numberOfCorners = pointIndexOfCorners.count();
+   corners.myPositions.resize( 3 * numberOfCorners );
+   corners.myNormals.resize( pointNormals.isEmpty() ? 0 : 3 * numberOfCorners );
+   QVector<QSimIndexedCornerChunk> chunks( GetNumberOfMeshImporterChunks( 12 * (qint64)numberOfCorners ) );
+   for( int i=0;  i < chunks.count();  i++ )
+   {
+      QSimIndexedCornerChunk& chunk = chunks[i];
+      chunk.myPointIndices = pointIndexOfCorners.constData();
+      chunk.myFirstCorner = numberOfCorners * (qint64)i / chunks.count();
+      chunk.myEndCorner = numberOfCorners * (qint64)(i+1) / chunks.count();
+      chunk.myPoints = points.constData();
+      chunk.myPointNormalsOrNull = pointNormals.isEmpty() ? NULL : pointNormals.constData();
+      chunk.myNumberOfPoints = points.count() / 3;
+      chunk.myCornerPositions = corners.myPositions.data();
+      chunk.myCornerNormalsOrNull = pointNormals.isEmpty() ? NULL : corners.myNormals.data();
+   }
+   if( !RunTasksOnWorkerThreads( chunks, CopyIndexedCornerChunkToCorners, progressDialog, 45, 55 ) ) return QString();
+   for( int i=0;  i < chunks.count();  i++ )
+      if( !chunks[i].myIsValid ) return tr("A polygon refers to a point that does not exist.");
+   return QString();
+}
+
+
+//------------------------------------------------------------------------------
+static QString  ReadNumbersInTetGenFile( const QString& filename, QVector<float>& numbers, QProgressDialog& progressDialog, const int firstProgressValue, const int lastProgressValue )
+{
+   // Comments (from # to the end of the line) are replaced by spaces, so the rest of the file is whitespace-separated numbers parsed on worker threads.
+   // Point numbers are read as floats too (exact up to 2^24, and .ele attributes may be floats).
+   QFile file( filename );
+   if( !file.open( QFile::ReadOnly ) ) return QSimMeshImporter::tr("Cannot read file %1:\n%2.").arg(filename).arg(file.errorString());
+   QByteArray fileContents = file.readAll();
+   char* p = fileContents.data();
+   const char* end = p + fileContents.size();
+   for( bool isComment = false;  p < end;  ++p )
+   {
+      if( *p == '#' ) isComment = true;
+      else if( *p == '\n' ) isComment = false;
+      if( isComment ) *p = ' ';
+   }
+   QVector<int> unusedIntegers;
+   if( !ParseNumbersOnWorkerThreads( fileContents.constData(), end, false, numbers, unusedIntegers, progressDialog, firstProgressValue, lastProgressValue ) )
+      return progressDialog.wasCanceled() ? QString() : QSimMeshImporter::tr("%1 has text that is not a number.").arg( QFileInfo(filename).fileName() );
+   return QString();
+}
+
+
+//------------------------------------------------------------------------------
+QString  QSimMeshImporter::ReadTetGenFiles( const QFileInfo& eleFileInfo, QSimTetrahedralMesh& tetrahedralMesh, QProgressDialog& progressDialog )
+{
+   // TetGen names the files of a mesh alike (e.g., Liver.1.node and Liver.1.ele).
+   QVector<float> nodeNumbers,  eleNumbers;
+   const QString nodeFilename = eleFileInfo.absoluteDir().absoluteFilePath( eleFileInfo.completeBaseName() + ".node" );
+   QString errorMessage = ReadNumbersInTetGenFile( nodeFilename, nodeNumbers, progressDialog, 0, 40 );
+   if( errorMessage.isEmpty() && !progressDialog.wasCanceled() ) errorMessage = ReadNumbersInTetGenFile( eleFileInfo.absoluteFilePath(), eleNumbers, progressDialog, 40, 80 );
+   if( !errorMessage.isEmpty() || progressDialog.wasCanceled() ) return errorMessage;
+
+   // .node:  <number of points> <dimension (3)> <number of attributes> <boundary markers (0 or 1)>, then for each point:  <point number> <x> <y> <z> [attributes] [boundary marker].
+   if( nodeNumbers.count() < 4 || nodeNumbers[1] != 3 || nodeNumbers[2] < 0 ) return tr("%1 is not a 3D TetGen .node file.").arg( QFileInfo(nodeFilename).fileName() );
+   const int numberOfPoints = (int)nodeNumbers[0];
+   const int numbersPerPoint = 4 + (int)nodeNumbers[2] + ( nodeNumbers[3] != 0 ? 1 : 0 );
+   if( numberOfPoints <= 0 || nodeNumbers.count() != 4 + (qint64)numberOfPoints * numbersPerPoint ) return tr("%1 does not have the number of points given in its first line.").arg( QFileInfo(nodeFilename).fileName() );
+   const int firstPointNumber = (int)nodeNumbers[4];   // Points are numbered from 0 or 1.
+   QVector3DArray vertices;
+   vertices.resize( numberOfPoints );
+   QVector3D* vertexData = vertices.data();
+   for( int i=0;  i < numberOfPoints;  i++ )
+   {
+      const float* point = nodeNumbers.constData() + 4 + i * numbersPerPoint;
+      vertexData[i] = QVector3D( point[1], point[2], point[3] );
+   }
+
+   // .ele:  <number of tetrahedra> <points per tetrahedron (4, or 10 if quadratic)> <number of attributes>, then for each tetrahedron:  <tetrahedron number> <points> [attributes].
+   // The four corners are the first points of a quadratic tetrahedron (its edge midpoints are not used).
+   if( eleNumbers.count() < 3 || ( eleNumbers[1] != 4 && eleNumbers[1] != 10 ) || eleNumbers[2] < 0 ) return tr("%1 is not a TetGen .ele file.").arg( eleFileInfo.fileName() );
+   const int numberOfTetrahedra = (int)eleNumbers[0];
+   const int numbersPerTetrahedron = 1 + (int)eleNumbers[1] + (int)eleNumbers[2];
+   if( numberOfTetrahedra <= 0 || eleNumbers.count() != 3 + (qint64)numberOfTetrahedra * numbersPerTetrahedron ) return tr("%1 does not have the number of tetrahedra given in its first line.").arg( eleFileInfo.fileName() );
+   QVector<int> tetrahedronVertexIndices( 4 * numberOfTetrahedra );
+   for( int t=0;  t < numberOfTetrahedra;  t++ )
+   {
+      const float* tetrahedron = eleNumbers.constData() + 3 + t * numbersPerTetrahedron;
+      for( int k=0;  k < 4;  k++ ) tetrahedronVertexIndices[4*t+k] = (int)tetrahedron[1+k] - firstPointNumber;
+   }
+
+   // Volumes, qualities, and boundary faces are calculated by the mesh.
+   if( !tetrahedralMesh.SetTetrahedralMesh( vertices, tetrahedronVertexIndices ) ) return tr("%1 has a tetrahedron with a point that is not in %2.").arg( eleFileInfo.fileName() ).arg( QFileInfo(nodeFilename).fileName() );
+   progressDialog.setValue( 95 );
+   return QString();
+}
+
+
+//------------------------------------------------------------------------------
+// Welding: each corner is hashed (on worker threads), the corners are sorted by bucket (a counting sort), then each task welds the corners in its bucket (so no two tasks
+// touch the same corner), numbering the bucket's vertices from 0.  Once every bucket's number of vertices is known, each task adds
+// its bucket's offset to its corners' vertex indices and copies its vertices into the mesh.
+static quint32  HashFloats( quint32 hash, const float* values, const int numberOfValues )
+{
+   // FNV-1a on the bits of each float (with -0 hashed as 0, since -0 == 0).
+   for( int i=0;  i < numberOfValues;  i++ )
+   {
+      const float value = values[i] == 0 ? 0.0f : values[i];
+      quint32 bits;
+      memcpy( &bits, &value, sizeof(bits) );
+      hash = ( hash ^ bits ) * 16777619u;
+   }
+   return hash;
+}
+
+
+//------------------------------------------------------------------------------
+static bool  AreCornersEqual( const QSimMeshCorners& corners, const int a, const int b )
+{
+   const float* positions = corners.myPositions.constData();
+   if( positions[3*a] != positions[3*b] || positions[3*a+1] != positions[3*b+1] || positions[3*a+2] != positions[3*b+2] ) return false;
+   const float* normals = corners.myNormals.constData();
+   if( !corners.myNormals.isEmpty() && ( normals[3*a] != normals[3*b] || normals[3*a+1] != normals[3*b+1] || normals[3*a+2] != normals[3*b+2] ) ) return false;
+   const float* textureCoordinates = corners.myTextureCoordinates.constData();
+   if( !corners.myTextureCoordinates.isEmpty() && ( textureCoordinates[2*a] != textureCoordinates[2*b] || textureCoordinates[2*a+1] != textureCoordinates[2*b+1] ) ) return false;
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+struct QSimWeldChunk
+{
+   const QSimMeshCorners*  myCorners;
+   int                     myFirstCorner, myEndCorner;   // Corners hashed by this task.
+   quint32*                myCornerHashes;
+   const int*              myCornersInBucket;            // Corners welded by this task (in corner order).
+   int                     myNumberOfCornersInBucket;
+   quint32                 myNumberOfBuckets;
+   int*                    myVertexIndexOfCorners;
+   QVector<int>            myFirstCornerOfVertices;
+   int                     myVertexOffset;
+   QVector3D*              myVertexPositions;
+   QVector3D*              myVertexNormalsOrNull;
+   QVector2D*              myVertexTextureCoordinatesOrNull;
+};
+
+
+//------------------------------------------------------------------------------
+static void  HashCornersInWeldChunk( QSimWeldChunk* chunk )
+{
+   const QSimMeshCorners& corners = *chunk->myCorners;
+   for( int i = chunk->myFirstCorner;  i < chunk->myEndCorner;  i++ )
+   {
+      quint32 hash = HashFloats( 2166136261u, corners.myPositions.constData() + 3*i, 3 );
+      if( !corners.myNormals.isEmpty() )            hash = HashFloats( hash, corners.myNormals.constData() + 3*i, 3 );
+      if( !corners.myTextureCoordinates.isEmpty() ) hash = HashFloats( hash, corners.myTextureCoordinates.constData() + 2*i, 2 );
+      hash ^= hash >> 16;  hash *= 0x85EBCA6Bu;  hash ^= hash >> 13;
+      chunk->myCornerHashes[i] = hash;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+static void  WeldCornersInBucket( QSimWeldChunk* chunk )
+{
+   // Open-addressing hash table (at most half full) of this bucket's vertices.
+   const quint32* hashes = chunk->myCornerHashes;
+   const quint32 numberOfBuckets = chunk->myNumberOfBuckets;
+   const int numberOfCornersInBucket = chunk->myNumberOfCornersInBucket;
+   int tableSize = 16;
+   while( tableSize < 2 * numberOfCornersInBucket ) tableSize *= 2;
+   QVector<int> table( tableSize, -1 );
+   chunk->myFirstCornerOfVertices.reserve( numberOfCornersInBucket );
+
+   for( int j=0;  j < numberOfCornersInBucket;  j++ )
+   {
+      const int i = chunk->myCornersInBucket[j];
+      int slot = ( hashes[i] / numberOfBuckets ) & ( tableSize - 1 );
+      while( table[slot] >= 0 && !AreCornersEqual( *chunk->myCorners, chunk->myFirstCornerOfVertices[ table[slot] ], i ) ) slot = ( slot + 1 ) & ( tableSize - 1 );
+      if( table[slot] < 0 ) { table[slot] = chunk->myFirstCornerOfVertices.count();  chunk->myFirstCornerOfVertices.append( i ); }
+      chunk->myVertexIndexOfCorners[i] = table[slot];
+   }
+}
+
+
+//------------------------------------------------------------------------------
+static void  CopyVerticesInBucket( QSimWeldChunk* chunk )
+{
+   // Vertex indices become indices in the whole mesh, and each vertex's data is copied from its first corner.
+   const QSimMeshCorners& corners = *chunk->myCorners;
+   for( int j=0;  j < chunk->myNumberOfCornersInBucket;  j++ ) chunk->myVertexIndexOfCorners[ chunk->myCornersInBucket[j] ] += chunk->myVertexOffset;
+   for( int j=0;  j < chunk->myFirstCornerOfVertices.count();  j++ )
+   {
+      const int i = chunk->myFirstCornerOfVertices[j];
+      const int vertexIndex = chunk->myVertexOffset + j;
+      const float* position = corners.myPositions.constData() + 3*i;
+      chunk->myVertexPositions[vertexIndex] = QVector3D( position[0], position[1], position[2] );
+      if( chunk->myVertexNormalsOrNull )            { const float* normal = corners.myNormals.constData() + 3*i;  chunk->myVertexNormalsOrNull[vertexIndex] = QVector3D( normal[0], normal[1], normal[2] ); }
+      if( chunk->myVertexTextureCoordinatesOrNull ) { const float* textureCoordinate = corners.myTextureCoordinates.constData() + 2*i;  chunk->myVertexTextureCoordinatesOrNull[vertexIndex] = QVector2D( textureCoordinate[0], textureCoordinate[1] ); }
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Smooth normals: each task calculates the (area-weighted) normals of a range of triangles, then each task adds the normals of the
+// triangles around each vertex in a range of vertices (found through a list of each vertex's triangles, so no two tasks write the same vertex).
+struct QSimNormalChunk
+{
+   int               myFirst, myEnd;   // Triangles or vertices.
+   const QVector3D*  myVertexPositions;
+   const int*        myVertexIndexOfCorners;
+   QVector3D*        myTriangleNormals;
+   const int*        myFirstTriangleOfVertices;   // Triangles around vertex v are myTrianglesOfVertices[ myFirstTriangleOfVertices[v] ... myFirstTriangleOfVertices[v+1] - 1 ].
+   const int*        myTrianglesOfVertices;
+   QVector3D*        myVertexNormals;
+};
+
+
+//------------------------------------------------------------------------------
+static void  CalculateTriangleNormals( QSimNormalChunk* chunk )
+{
+   for( int t = chunk->myFirst;  t < chunk->myEnd;  t++ )
+   {
+      const QVector3D& a = chunk->myVertexPositions[ chunk->myVertexIndexOfCorners[3*t] ];
+      const QVector3D& b = chunk->myVertexPositions[ chunk->myVertexIndexOfCorners[3*t+1] ];
+      const QVector3D& c = chunk->myVertexPositions[ chunk->myVertexIndexOfCorners[3*t+2] ];
+      chunk->myTriangleNormals[t] = QVector3D::crossProduct( b - a, c - a );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+static void  CalculateVertexNormals( QSimNormalChunk* chunk )
+{
+   for( int v = chunk->myFirst;  v < chunk->myEnd;  v++ )
+   {
+      QVector3D normal;
+      for( int j = chunk->myFirstTriangleOfVertices[v];  j < chunk->myFirstTriangleOfVertices[v+1];  j++ ) normal += chunk->myTriangleNormals[ chunk->myTrianglesOfVertices[j] ];
+      chunk->myVertexNormals[v] = normal.normalized();
+   }
+}
+
+
+//------------------------------------------------------------------------------
+QGLSceneNode*  QSimMeshImporter::CreateSceneNodeFromMeshCorners( const QSimMeshCorners& corners, const QString& clusteredMeshFilename, QProgressDialog& progressDialog )
+{
+   // Hash the corners and weld each bucket of corners on worker threads.
+   const int numberOfCorners = corners.GetNumberOfCorners();
+   const int numberOfTriangles = numberOfCorners / 3;
+   QVector<quint32> cornerHashes( numberOfCorners );
+   QVector<int> vertexIndexOfCorners( numberOfCorners );
+   QVector<QSimWeldChunk> chunks( GetNumberOfMeshImporterChunks( 12 * (qint64)numberOfCorners ) );
+   for( int i=0;  i < chunks.count();  i++ )
+   {
+      QSimWeldChunk& chunk = chunks[i];
+      chunk.myCorners = &corners;
+      chunk.myFirstCorner = numberOfCorners * (qint64)i / chunks.count();
+      chunk.myEndCorner = numberOfCorners * (qint64)(i+1) / chunks.count();
+      chunk.myCornerHashes = cornerHashes.data();
+      chunk.myNumberOfBuckets = chunks.count();
+      chunk.myVertexIndexOfCorners = vertexIndexOfCorners.data();
+   }
+   if( !RunTasksOnWorkerThreads( chunks, HashCornersInWeldChunk, progressDialog, 55, 60 ) ) return NULL;
+
+   // Corners of each bucket (counted, then listed, on this thread), so each task visits only its own corners rather than all of them.
+   const quint32 numberOfBuckets = chunks.count();
+   QVector<int> firstCornerOfBuckets( numberOfBuckets + 1, 0 );
+   for( int i=0;  i < numberOfCorners;  i++ ) ++firstCornerOfBuckets[ cornerHashes[i] % numberOfBuckets + 1 ];
+   for( quint32 b=0;  b < numberOfBuckets;  b++ ) firstCornerOfBuckets[b+1] += firstCornerOfBuckets[b];
+   QVector<int> cornersInBuckets( numberOfCorners );
+   QVector<int> nextSlotOfBuckets = firstCornerOfBuckets;
+   for( int i=0;  i < numberOfCorners;  i++ ) cornersInBuckets[ nextSlotOfBuckets[ cornerHashes[i] % numberOfBuckets ]++ ] = i;
+   for( int i=0;  i < chunks.count();  i++ )
+   {
+      chunks[i].myCornersInBucket = cornersInBuckets.constData() + firstCornerOfBuckets[i];
+      chunks[i].myNumberOfCornersInBucket = firstCornerOfBuckets[i+1] - firstCornerOfBuckets[i];
+   }
+   if( !RunTasksOnWorkerThreads( chunks, WeldCornersInBucket, progressDialog, 60, 75 ) ) return NULL;
+
+   // Each bucket's vertices follow the previous bucket's vertices.
+   int numberOfVertices = 0;
+   for( int i=0;  i < chunks.count();  i++ ) { chunks[i].myVertexOffset = numberOfVertices;  numberOfVertices += chunks[i].myFirstCornerOfVertices.count(); }
+   const bool hasNormals = !corners.myNormals.isEmpty();
+   const bool hasTextureCoordinates = !corners.myTextureCoordinates.isEmpty();
+   QVector3DArray positions, normals;
+   QVector2DArray textureCoordinates;
+   positions.resize( numberOfVertices );
+   normals.resize( numberOfVertices );
+   if( hasTextureCoordinates ) textureCoordinates.resize( numberOfVertices );
+   for( int i=0;  i < chunks.count();  i++ )
+   {
+      chunks[i].myVertexPositions = positions.data();
+      chunks[i].myVertexNormalsOrNull = hasNormals ? normals.data() : NULL;
+      chunks[i].myVertexTextureCoordinatesOrNull = hasTextureCoordinates ? textureCoordinates.data() : NULL;
+   }
+   if( !RunTasksOnWorkerThreads( chunks, CopyVerticesInBucket, progressDialog, 75, 80 ) ) return NULL;
+   myNumberOfVerticesAfterWelding = numberOfVertices;
+
+   // Calculate smooth normals if the file did not have them.
+   if( !hasNormals )
+   {
+      // Triangles around each vertex (counted, then listed, on this thread).
+      QVector<int> firstTriangleOfVertices( numberOfVertices + 1, 0 );
+      for( int i=0;  i < numberOfCorners;  i++ ) ++firstTriangleOfVertices[ vertexIndexOfCorners[i] + 1 ];
+      for( int v=0;  v < numberOfVertices;  v++ ) firstTriangleOfVertices[v+1] += firstTriangleOfVertices[v];
+      QVector<int> trianglesOfVertices( numberOfCorners );
+      QVector<int> nextSlotOfVertices = firstTriangleOfVertices;
+      for( int i=0;  i < numberOfCorners;  i++ ) trianglesOfVertices[ nextSlotOfVertices[ vertexIndexOfCorners[i] ]++ ] = i / 3;
+
+      QVector<QVector3D> triangleNormals( numberOfTriangles );
+      QVector<QSimNormalChunk> normalChunks( GetNumberOfMeshImporterChunks( 36 * (qint64)numberOfTriangles ) );
+      for( int i=0;  i < normalChunks.count();  i++ )
+      {
+         QSimNormalChunk& chunk = normalChunks[i];
+         chunk.myFirst = numberOfTriangles * (qint64)i / normalChunks.count();
+         chunk.myEnd = numberOfTriangles * (qint64)(i+1) / normalChunks.count();
+         chunk.myVertexPositions = positions.constData();
+         chunk.myVertexIndexOfCorners = vertexIndexOfCorners.constData();
+         chunk.myTriangleNormals = triangleNormals.data();
+         chunk.myFirstTriangleOfVertices = firstTriangleOfVertices.constData();
+         chunk.myTrianglesOfVertices = trianglesOfVertices.constData();
+         chunk.myVertexNormals = normals.data();
+      }
+      if( !RunTasksOnWorkerThreads( normalChunks, CalculateTriangleNormals, progressDialog, 80, 85 ) ) return NULL;
+      for( int i=0;  i < normalChunks.count();  i++ )
+      {
+         normalChunks[i].myFirst = numberOfVertices * (qint64)i / normalChunks.count();
+         normalChunks[i].myEnd = numberOfVertices * (qint64)(i+1) / normalChunks.count();
+      }
+      if( !RunTasksOnWorkerThreads( normalChunks, CalculateVertexNormals, progressDialog, 85, 95 ) ) return NULL;
+   }
+
+   // A large mesh is streamed from a clustered mesh file (if the file cannot be written, the mesh is kept in memory).
+   if( numberOfTriangles >= QSimClusteredMesh::GetMinimumNumberOfTrianglesToCluster() )
+   {
+      progressDialog.setValue( 96 );
+      QString errorMessage;
+      QSimClusteredMesh* clusteredMesh = NULL;
+      if( QSimClusteredMesh::WriteClusteredMeshFile( clusteredMeshFilename, positions, normals, vertexIndexOfCorners, errorMessage ) )
+      {
+         QSimMeshImporter::RemoveLeastRecentlyUsedClusteredMeshCacheFiles( clusteredMeshFilename );
+         clusteredMesh = this->OpenClusteredMeshFileOrNull( clusteredMeshFilename, errorMessage );
+      }
+      if( clusteredMesh ) return clusteredMesh;
+      qWarning( "QSimMeshImporter: %s", qPrintable( errorMessage ) );
+   }
+
+   // Geometry is uploaded to the GPU the first time it is drawn.
+   QGeometryData geometry;
+   geometry.appendVertexArray( positions );
+   geometry.appendNormalArray( normals );
+   if( hasTextureCoordinates ) geometry.appendTexCoordArray( textureCoordinates );
+   QGL::IndexArray indices;
+   indices.reserve( numberOfCorners );
+   for( int i=0;  i < numberOfCorners;  i++ ) indices.append( vertexIndexOfCorners[i] );
+   geometry.appendIndices( indices );
+   QGLSceneNode* sceneNode = new QGLSceneNode;
+   sceneNode->setGeometry( geometry );
+   sceneNode->setStart( 0 );
+   sceneNode->setCount( numberOfCorners );
+   sceneNode->setDrawingMode( QGL::Triangles );
+   return sceneNode;
+}
+
+
+//------------------------------------------------------------------------------
+QSimClusteredMesh*  QSimMeshImporter::OpenClusteredMeshFileOrNull( const QString& clusteredMeshFilename, QString& errorMessage )
+{
+   QSimClusteredMesh* clusteredMesh = new QSimClusteredMesh;
+   if( !clusteredMesh->OpenClusteredMeshFile( clusteredMeshFilename, errorMessage ) ) { delete clusteredMesh;  return NULL; }
+   QObject::connect( clusteredMesh, SIGNAL(ClusterIsReadySignal()), &myGLViewWidget, SLOT(updateGL()) );
+   return clusteredMesh;
+}
+
+
+//------------------------------------------------------------------------------
+QString  QSimMeshImporter::GetClusteredMeshCacheFilename( const QFileInfo& meshFileInfo )
+{
+   // The user's cache folder (or, if there is none, a folder in the temporary folder) is made if it does not exist.
+   QString cacheFolder = QDesktopServices::storageLocation( QDesktopServices::CacheLocation );
+   if( cacheFolder.isEmpty() || !QDir().mkpath( cacheFolder ) ) cacheFolder = QDir::temp().absoluteFilePath( "QSimCache" );
+   QDir().mkpath( cacheFolder );
+
+   // Different mesh files with the same name, and different versions of one mesh file, have different clustered mesh files.
+   const QByteArray key = ( meshFileInfo.absoluteFilePath() + "|" + meshFileInfo.lastModified().toString( Qt::ISODate ) + "|" + QString::number( meshFileInfo.size() ) ).toUtf8();
+   const QString hash = QString( QCryptographicHash::hash( key, QCryptographicHash::Md5 ).toHex().left(16) );
+   return QDir( cacheFolder ).absoluteFilePath( meshFileInfo.completeBaseName() + "-" + hash + "." + QSimClusteredMesh::GetClusteredMeshFileSuffix() );
+}
+
+
+//------------------------------------------------------------------------------
+static bool  IsFileLessRecentlyRead( const QFileInfo& fileInfoA, const QFileInfo& fileInfoB )  { return fileInfoA.lastRead() < fileInfoB.lastRead(); }
+
+
+//------------------------------------------------------------------------------
+void  QSimMeshImporter::RemoveLeastRecentlyUsedClusteredMeshCacheFiles( const QString& clusteredMeshFilenameToKeep )
+{
+   // Opening a clustered mesh file reads it, so the time it was last read is when it was last used.
+   const QFileInfo fileInfoToKeep( clusteredMeshFilenameToKeep );
+   QFileInfoList cacheFileInfos = fileInfoToKeep.absoluteDir().entryInfoList( QStringList( "*." + QSimClusteredMesh::GetClusteredMeshFileSuffix() ), QDir::Files );
+   qSort( cacheFileInfos.begin(), cacheFileInfos.end(), IsFileLessRecentlyRead );
+   qint64 cacheSizeInBytes = 0;
+   for( int i=0;  i < cacheFileInfos.count();  i++ ) cacheSizeInBytes += cacheFileInfos[i].size();
+   for( int i=0;  i < cacheFileInfos.count() && cacheSizeInBytes > QSimMeshImporter::GetMaximumClusteredMeshCacheSizeInBytes();  i++ )
+   {
+      if( cacheFileInfos[i].absoluteFilePath() == fileInfoToKeep.absoluteFilePath() ) continue;
+      if( QFile::remove( cacheFileInfos[i].absoluteFilePath() ) ) cacheSizeInBytes -= cacheFileInfos[i].size();
+   }
+}
+
+
+//------------------------------------------------------------------------------
+QSimSceneNode*  QSimMeshImporter::ImportMeshFile( const QString& filename, QGLSceneNode& parentSceneNode, QWidget* parentWidgetOrNull )
+{
+   QTime importTimer;
+   importTimer.start();
+   this->ClearMeshImporterStatistics();
+   const QFileInfo fileInfo( filename );
+   const QString suffix = fileInfo.suffix().toLower();
+
+   // A clustered mesh file only has its table read (its clusters are read as they become visible).  A large mesh file that was imported before
+   // (and has not changed since) is opened from its clustered mesh file in the cache, which is not written again (it may be open in the scene).
+   // A damaged file in the cache is removed, and the mesh file is imported again.
+   const bool isClusteredMeshFile = suffix == QSimClusteredMesh::GetClusteredMeshFileSuffix();
+   const QString clusteredMeshCacheFilename = isClusteredMeshFile ? QString() : QSimMeshImporter::GetClusteredMeshCacheFilename( fileInfo );
+   QString clusteredMeshErrorMessage;
+   QSimClusteredMesh* clusteredMesh = NULL;
+   if( isClusteredMeshFile ) clusteredMesh = this->OpenClusteredMeshFileOrNull( filename, clusteredMeshErrorMessage );
+   else if( suffix != "ele" && QFile::exists( clusteredMeshCacheFilename ) && ( clusteredMesh = this->OpenClusteredMeshFileOrNull( clusteredMeshCacheFilename, clusteredMeshErrorMessage ) ) == NULL ) QFile::remove( clusteredMeshCacheFilename );
+   if( isClusteredMeshFile || clusteredMesh != NULL )
+   {
+      if( clusteredMesh == NULL )
+      {
+         QMessageBox::warning( parentWidgetOrNull, tr("Import mesh"), tr("Cannot import %1:\n%2").arg(filename).arg(clusteredMeshErrorMessage), QMessageBox::Ok, QMessageBox::NoButton );
+         return NULL;
+      }
+      myNumberOfTriangles = (unsigned int)clusteredMesh->GetNumberOfTriangles();
+      QSimSceneNode* qsimSceneNode = myGLViewWidget.AddSceneNodeFromQGLSceneNode( parentSceneNode, *clusteredMesh, true, fileInfo.completeBaseName().toLatin1().constData() );
+      qsimSceneNode->SetPosition( QVector3D(0,0,0) );
+      myImportTimeInMilliseconds = importTimer.elapsed();
+      myGLViewWidget.updateGL();
+      return qsimSceneNode;
+   }
+
+   // A TetGen volume mesh is read into a QSimTetrahedralMesh (which draws its boundary faces colored by the quality of their tetrahedra).
+   if( suffix == "ele" )
+   {
+      QProgressDialog progressDialog( tr("Importing %1...").arg( fileInfo.fileName() ), tr("Cancel"), 0, 100, parentWidgetOrNull );
+      progressDialog.setWindowModality( Qt::WindowModal );
+      progressDialog.setMinimumDuration( 500 );
+      QSimTetrahedralMesh* tetrahedralMesh = new QSimTetrahedralMesh;
+      const QString errorMessage = this->ReadTetGenFiles( fileInfo, *tetrahedralMesh, progressDialog );
+      if( progressDialog.wasCanceled() || !errorMessage.isEmpty() )
+      {
+         delete tetrahedralMesh;
+         if( !progressDialog.wasCanceled() ) QMessageBox::warning( parentWidgetOrNull, tr("Import mesh"), tr("Cannot import %1:\n%2").arg(filename).arg(errorMessage), QMessageBox::Ok, QMessageBox::NoButton );
+         return NULL;
+      }
+      myNumberOfTetrahedra = tetrahedralMesh->GetNumberOfTetrahedra();
+      myNumberOfTriangles = tetrahedralMesh->GetNumberOfDrawnFaces();
+      myNumberOfVerticesAfterWelding = tetrahedralMesh->GetNumberOfVertices();
+      QSimSceneNode* qsimSceneNode = myGLViewWidget.AddSceneNodeFromQGLSceneNode( parentSceneNode, *tetrahedralMesh, true, fileInfo.completeBaseName().toLatin1().constData() );
+      qsimSceneNode->SetPosition( QVector3D(0,0,0) );
+      progressDialog.setValue( 100 );
+      myImportTimeInMilliseconds = importTimer.elapsed();
+      myGLViewWidget.updateGL();
+      return qsimSceneNode;
+   }
+
+   // Map the file into memory (or if that is not possible, read all of it).  The mapping is released when file is destroyed.
+   QFile file( filename );
+   if( !file.open( QFile::ReadOnly ) )
+   {
+      QMessageBox::warning( parentWidgetOrNull, tr("Import mesh"), tr("Cannot read file %1:\n%2.").arg(filename).arg(file.errorString()), QMessageBox::Ok, QMessageBox::NoButton );
+      return NULL;
+   }
+   QByteArray fileContentsIfNotMapped;
+   const qint64 numberOfBytes = qMin( file.size(), (qint64)INT_MAX );
+   const char* fileContents = reinterpret_cast<const char*>( file.map( 0, numberOfBytes ) );
+   if( fileContents == NULL ) { fileContentsIfNotMapped = file.readAll();  fileContents = fileContentsIfNotMapped.constData(); }
+
+   // Read the triangles' corners (the progress dialog processes events, including its cancel button, between chunks).
+   QProgressDialog progressDialog( tr("Importing %1...").arg( fileInfo.fileName() ), tr("Cancel"), 0, 100, parentWidgetOrNull );
+   progressDialog.setWindowModality( Qt::WindowModal );
+   progressDialog.setMinimumDuration( 500 );
+   QSimMeshCorners corners;
+   QString errorMessage;
+   if(      suffix == "obj" ) errorMessage = this->ReadObjFile( fileContents, numberOfBytes, corners, progressDialog );
+   else if( suffix == "stl" ) errorMessage = this->ReadStlFile( fileContents, numberOfBytes, corners, progressDialog );
+   else if( suffix == "vtp" ) errorMessage = this->ReadVtpFile( fileContents, numberOfBytes, corners, progressDialog );
+   else                       errorMessage = tr("Only .obj, .stl, .vtp, .ele, and .qsimmesh files can be imported.");
+   if( progressDialog.wasCanceled() ) return NULL;
+   if( errorMessage.isEmpty() && corners.GetNumberOfCorners() < 3 ) errorMessage = tr("The file has no triangles.");
+   if( !errorMessage.isEmpty() )
+   {
+      QMessageBox::warning( parentWidgetOrNull, tr("Import mesh"), tr("Cannot import %1:\n%2").arg(filename).arg(errorMessage), QMessageBox::Ok, QMessageBox::NoButton );
+      return NULL;
+   }
+   myNumberOfTriangles = corners.GetNumberOfCorners() / 3;
+
+   // Weld vertices (and calculate normals), then add the mesh as an object at the origin of parentSceneNode.
+   // Large meshes are written to the cache folder (e.g., Skull-0123456789abcdef.qsimmesh for Skull.obj).
+   QGLSceneNode* sceneNode = this->CreateSceneNodeFromMeshCorners( corners, clusteredMeshCacheFilename, progressDialog );
+   if( sceneNode == NULL ) return NULL;
+   QSimSceneNode* qsimSceneNode = myGLViewWidget.AddSceneNodeFromQGLSceneNode( parentSceneNode, *sceneNode, true, fileInfo.completeBaseName().toLatin1().constData() );
+   qsimSceneNode->SetPosition( QVector3D(0,0,0) );
+   progressDialog.setValue( 100 );
+   myImportTimeInMilliseconds = importTimer.elapsed();
+   myGLViewWidget.updateGL();
+   return qsimSceneNode;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
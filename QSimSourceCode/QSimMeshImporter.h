@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// File:     QSimMeshImporter.h
+// Class:    QSimMeshImporter
+// Parents:  QObject
+// Purpose:  Reads triangle meshes (.obj, .stl, and .vtp files) and tetrahedral meshes (TetGen .ele) on worker threads and adds each as an object to a view widget.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMMESHIMPORTER_H__
+#define  QSIMMESHIMPORTER_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglscenenode.h"
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Forward declarations
+class  QSimGLViewWidget;
+class  QSimSceneNode;
+class  QSimClusteredMesh;
+class  QSimTetrahedralMesh;
+
+
+//------------------------------------------------------------------------------
+// Triangle corners as read from a file (three per triangle, in order), before duplicate vertices are welded.
+// Normals and texture coordinates are empty unless every corner has one.
+struct QSimMeshCorners
+{
+   QVector<float>  myPositions;            // 3 per corner.
+   QVector<float>  myNormals;              // 3 per corner (or empty).
+   QVector<float>  myTextureCoordinates;   // 2 per corner (or empty).
+   int  GetNumberOfCorners() const  { return myPositions.count() / 3; }
+};
+
+
+//------------------------------------------------------------------------------
+class QSimMeshImporter : public QObject
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimMeshImporter( QSimGLViewWidget& glViewWidget ) : QObject(NULL), myGLViewWidget(glViewWidget)  { this->ClearMeshImporterStatistics(); }
+  ~QSimMeshImporter()  {;}
+
+   // Filter for file dialogs.
+   static QString  GetMeshFileDialogNameFilter()  { return tr("Meshes (*.obj *.stl *.vtp *.ele *.qsimmesh);;Wavefront OBJ (*.obj);;STL (*.stl);;VTK PolyData (*.vtp);;TetGen volume meshes (*.ele);;Clustered meshes (*.qsimmesh)"); }
+
+   // Read a mesh file (the format is determined by the filename extension) and add it as one object attached to parentSceneNode.
+   // The file is memory-mapped and split into chunks that are parsed on worker threads.  Corners with identical position, normal,
+   // and texture coordinates are then welded into one vertex, and if the file does not give every corner a normal, smooth normals
+   // are computed from the welded triangles (STL facet normals are not used, so STL meshes are always smooth shaded).
+   // Shows a progress dialog with a cancel button.  Shows a message box and returns NULL on error or if canceled.
+   // VTP files must use format="ascii" data arrays (as OpenSim geometry files do), and only their first piece is read.
+   // Meshes with at least QSimClusteredMesh::GetMinimumNumberOfTrianglesToCluster() triangles are written to a clustered mesh file
+   // in the cache folder (see GetClusteredMeshCacheFilename) and streamed from it, rather than kept in memory.
+   // A clustered mesh file (.qsimmesh) is opened directly, without reading its triangles.
+   // A TetGen volume mesh (tetrahedra in the .ele file, points in the .node file with the same base name) is added as a QSimTetrahedralMesh.
+   QSimSceneNode*  ImportMeshFile( const QString& filename, QGLSceneNode& parentSceneNode, QWidget* parentWidgetOrNull );
+
+   // Clustered mesh file made when a large mesh file is imported.  It is in the user's cache folder (never beside the imported file, so no file the user
+   // made is replaced), and its name includes a hash of the mesh file's path and time of modification, so only an earlier import of the same file is replaced.
+   static QString  GetClusteredMeshCacheFilename( const QFileInfo& meshFileInfo );
+
+   // Clustered mesh files in the cache may be several gigabytes each, so after one is written the least recently used files are removed until
+   // the cache is at most its maximum size (the file just written, and files that cannot be removed because they are open, are kept).
+   static qint64  GetMaximumClusteredMeshCacheSizeInBytes()  { return Q_INT64_C(4) * 1024 * 1024 * 1024; }
+   static void    RemoveLeastRecentlyUsedClusteredMeshCacheFiles( const QString& clusteredMeshFilenameToKeep );
+
+   // Statistics from the most recent call to ImportMeshFile (helpful for profiling).
+   unsigned int  GetNumberOfTriangles() const                { return myNumberOfTriangles; }
+   unsigned int  GetNumberOfVerticesBeforeWelding() const    { return 3 * myNumberOfTriangles; }
+   unsigned int  GetNumberOfVerticesAfterWelding() const     { return myNumberOfVerticesAfterWelding; }
+   unsigned int  GetNumberOfTetrahedra() const               { return myNumberOfTetrahedra; }   // 0 unless a volume mesh was imported.
+   qint64        GetImportTimeInMilliseconds() const         { return myImportTimeInMilliseconds; }
+
+private:
+   // Each format's reader fills corners (three per triangle) and returns an empty string, or returns an error message.
+   // Readers split the file into chunks, each parsed on a worker thread, and check the progress dialog between chunks.
+   QString  ReadObjFile( const char* fileContents, const qint64 numberOfBytes, QSimMeshCorners& corners, QProgressDialog& progressDialog );
+   QString  ReadStlFile( const char* fileContents, const qint64 numberOfBytes, QSimMeshCorners& corners, QProgressDialog& progressDialog );
+   QString  ReadVtpFile( const char* fileContents, const qint64 numberOfBytes, QSimMeshCorners& corners, QProgressDialog& progressDialog );
+   QString  ReadTetGenFiles( const QFileInfo& eleFileInfo, QSimTetrahedralMesh& tetrahedralMesh, QProgressDialog& progressDialog );
+
+   // Weld duplicate corners into vertices (on worker threads, each handling the corners whose hash falls in its bucket)
+   // and compute smooth normals if corners has none.  Returns a QGLSceneNode that draws the triangles (or NULL if canceled).
+   // A large mesh is written to clusteredMeshFilename and the returned QGLSceneNode is a QSimClusteredMesh that streams it.
+   QGLSceneNode*  CreateSceneNodeFromMeshCorners( const QSimMeshCorners& corners, const QString& clusteredMeshFilename, QProgressDialog& progressDialog );
+
+   // Open a clustered mesh file, redrawing the view as its clusters are read.  Returns NULL and sets errorMessage on error.
+   QSimClusteredMesh*  OpenClusteredMeshFileOrNull( const QString& clusteredMeshFilename, QString& errorMessage );
+
+   // The view widget to which meshes are added.
+   QSimGLViewWidget&  myGLViewWidget;
+
+   // Statistics from the most recent call to ImportMeshFile.
+   void          ClearMeshImporterStatistics()  { myNumberOfTriangles = myNumberOfVerticesAfterWelding = myNumberOfTetrahedra = 0;  myImportTimeInMilliseconds = 0; }
+   unsigned int  myNumberOfTriangles;
+   unsigned int  myNumberOfVerticesAfterWelding;
+   unsigned int  myNumberOfTetrahedra;
+   qint64        myImportTimeInMilliseconds;
+
+   // Disable default constructors and copying.
+   QSimMeshImporter();
+   QSimMeshImporter( const QSimMeshImporter& );
+   QSimMeshImporter&  operator=( const QSimMeshImporter& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMMESHIMPORTER_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,578 @@
+//-----------------------------------------------------------------------------
+// File:     QSimMeshSimplifier.cpp
+// Class:    QSimMeshSimplifier
+// Parents:  QObject
+// Purpose:  Simplifies the meshes in a scene (quadric error metrics) into chains of levels of detail, on worker threads.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <QtConcurrentRun>
+#include <algorithm>
+#include "QSimMeshSimplifier.h"
+#include "QSimLevelOfDetailMesh.h"
+#include "QSimCompactMesh.h"
+#include "QSimSceneNode.h"
+#include "QSimGLViewWidget.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+// Sum of squared distances to a set of planes, as a symmetric 4x4 matrix Q (the error at point p is [p 1] Q [p 1]^T).
+struct QSimQuadric
+{
+   double  myCoefficients[10];   // Upper triangle of Q:  aa ab ac ad bb bc bd cc cd dd.
+
+   void  SetToZero()  { for( int i=0;  i < 10;  i++ ) myCoefficients[i] = 0; }
+   void  Add( const QSimQuadric& other )  { for( int i=0;  i < 10;  i++ ) myCoefficients[i] += other.myCoefficients[i]; }
+   void  AddPlane( const double a, const double b, const double c, const double d, const double weight )
+   {
+      // Plane a*x + b*y + c*z + d = 0, with (a,b,c) a unit vector.
+      double* q = myCoefficients;
+      q[0] += weight*a*a;  q[1] += weight*a*b;  q[2] += weight*a*c;  q[3] += weight*a*d;
+      q[4] += weight*b*b;  q[5] += weight*b*c;  q[6] += weight*b*d;
+      q[7] += weight*c*c;  q[8] += weight*c*d;
+      q[9] += weight*d*d;
+   }
+   double  GetError( const QVector3D& p ) const
+   {
+      const double* q = myCoefficients;
+      const double x = p.x(),  y = p.y(),  z = p.z();
+      return q[0]*x*x + 2*q[1]*x*y + 2*q[2]*x*z + 2*q[3]*x + q[4]*y*y + 2*q[5]*y*z + 2*q[6]*y + q[7]*z*z + 2*q[8]*z + q[9];
+   }
+};
+
+
+//------------------------------------------------------------------------------
+// Candidate collapse of the edge between two vertices (moving myFromVertex onto myToVertex).
+// A candidate is stale if either vertex has changed since it was calculated (its version is then different).
+struct QSimEdgeCollapse
+{
+   double  myCost;
+   int     myFromVertex,   myToVertex;
+   int     myFromVersion,  myToVersion;
+
+   // The standard heap functions put the greatest element first, so the least cost is treated as greatest.
+   bool  operator<( const QSimEdgeCollapse& other ) const  { return myCost > other.myCost; }
+};
+
+
+//------------------------------------------------------------------------------
+// Orders vertices by position (so vertices at the same position are next to each other).
+struct QSimVertexPositionIsLess
+{
+   const QVector3D*  myPositions;
+   bool  operator()( const int a, const int b ) const
+   {
+      const QVector3D& p = myPositions[a];
+      const QVector3D& q = myPositions[b];
+      if( p.x() != q.x() ) return p.x() < q.x();
+      if( p.y() != q.y() ) return p.y() < q.y();
+      return p.z() < q.z();
+   }
+};
+
+
+//------------------------------------------------------------------------------
+// Edge-collapse simplification of one mesh (the state shared by the steps of QSimMeshSimplifier::SimplifyMeshIntoLevelsOfDetail).
+class QSimQuadricSimplification
+{
+public:
+   QSimQuadricSimplification( const QVector3DArray& positions, const QVector2DArray& textureCoordinates, const QVector<int>& indices );
+   QList<QSimSimplifiedMesh>  SimplifyIntoLevelsOfDetail( const int maximumNumberOfLevels );
+
+private:
+   void  PushEdgeCollapse( const int vertexA, const int vertexB );
+   bool  IsEdgeCollapseValid( const int fromVertex, const int toVertex );
+   void  CollapseEdge( const int fromVertex, const int toVertex );
+   void  GetNeighborsOfVertex( const int vertex, QVector<int>& neighbors ) const;
+   QSimSimplifiedMesh  GetSimplifiedMesh( const qreal geometricError ) const;
+   QVector3D  GetTriangleNormalTimesTwiceArea( const int a, const int b, const int c ) const  { return QVector3D::crossProduct( myPositions[b] - myPositions[a], myPositions[c] - myPositions[a] ); }
+
+   // Vertices (after merging those at the same position) and triangles (three vertices each).
+   QVector<QVector3D>       myPositions;
+   QVector<QVector2D>       myTextureCoordinates;
+   QVector<int>             myVersionOfVertices;
+   QVector<bool>            myIsVertexRemoved;
+   QVector<QSimQuadric>     myQuadrics;
+   QVector< QVector<int> >  myTrianglesOfVertices;   // May also list triangles that were removed.
+   QVector<int>             myVerticesOfTriangles;
+   QVector<bool>            myIsTriangleRemoved;
+   int                      myNumberOfTriangles;
+
+   // Candidate collapses (a heap, least cost first), and space reused by IsEdgeCollapseValid.
+   QVector<QSimEdgeCollapse>  myEdgeCollapses;
+   QVector<int>  myNeighborsOfFromVertex,  myNeighborsOfToVertex;
+};
+
+
+//------------------------------------------------------------------------------
+QSimQuadricSimplification::QSimQuadricSimplification( const QVector3DArray& positions, const QVector2DArray& textureCoordinates, const QVector<int>& indices )
+{
+   // Merge vertices at the same position (e.g., along the seams of a QGLBuilder mesh), keeping the texture coordinates of one of them.
+   const int numberOfInputVertices = positions.count();
+   const bool hasTextureCoordinates = textureCoordinates.count() == numberOfInputVertices;
+   QVector<int> sortedVertices( numberOfInputVertices );
+   for( int i=0;  i < numberOfInputVertices;  i++ ) sortedVertices[i] = i;
+   QSimVertexPositionIsLess isLess;
+   isLess.myPositions = positions.constData();
+   std::sort( sortedVertices.begin(), sortedVertices.end(), isLess );
+   QVector<int> mergedVertexOfInputVertices( numberOfInputVertices );
+   for( int i=0;  i < numberOfInputVertices;  i++ )
+   {
+      const int v = sortedVertices[i];
+      if( i == 0 || isLess( sortedVertices[i-1], v ) )
+      {
+         myPositions.append( positions.at(v) );
+         if( hasTextureCoordinates ) myTextureCoordinates.append( textureCoordinates.at(v) );
+      }
+      mergedVertexOfInputVertices[v] = myPositions.count() - 1;
+   }
+   const int numberOfVertices = myPositions.count();
+
+   // Triangles (those that became degenerate when vertices were merged are dropped).
+   const int numberOfInputTriangles = indices.count() / 3;
+   myVerticesOfTriangles.reserve( 3 * numberOfInputTriangles );
+   for( int t=0;  t < numberOfInputTriangles;  t++ )
+   {
+      const int i0 = indices[3*t],  i1 = indices[3*t+1],  i2 = indices[3*t+2];
+      if( i0 < 0 || i1 < 0 || i2 < 0 || i0 >= numberOfInputVertices || i1 >= numberOfInputVertices || i2 >= numberOfInputVertices ) continue;
+      const int a = mergedVertexOfInputVertices[i0],  b = mergedVertexOfInputVertices[i1],  c = mergedVertexOfInputVertices[i2];
+      if( a == b || b == c || c == a ) continue;
+      myVerticesOfTriangles.append( a );  myVerticesOfTriangles.append( b );  myVerticesOfTriangles.append( c );
+   }
+   myNumberOfTriangles = myVerticesOfTriangles.count() / 3;
+   myIsTriangleRemoved.fill( false, myNumberOfTriangles );
+   myIsVertexRemoved.fill( false, numberOfVertices );
+   myVersionOfVertices.fill( 0, numberOfVertices );
+   myTrianglesOfVertices.resize( numberOfVertices );
+   for( int i=0;  i < myVerticesOfTriangles.count();  i++ ) myTrianglesOfVertices[ myVerticesOfTriangles[i] ].append( i / 3 );
+
+   // Count the triangles on each edge (an edge with one triangle is on a boundary).
+   QHash<quint64,int> numberOfTrianglesOfEdges;
+   for( int t=0;  t < myNumberOfTriangles;  t++ )
+      for( int k=0;  k < 3;  k++ )
+      {
+         const quint64 a = myVerticesOfTriangles[3*t+k],  b = myVerticesOfTriangles[3*t+(k+1)%3];
+         numberOfTrianglesOfEdges[ a < b ? (a << 32) | b : (b << 32) | a ] += 1;
+      }
+
+   // Each vertex's quadric is the planes of its triangles, plus (heavily weighted) planes perpendicular to its triangles along boundary edges.
+   const double boundaryWeight = 10;
+   myQuadrics.resize( numberOfVertices );
+   for( int v=0;  v < numberOfVertices;  v++ ) myQuadrics[v].SetToZero();
+   for( int t=0;  t < myNumberOfTriangles;  t++ )
+   {
+      const int* vertices = myVerticesOfTriangles.constData() + 3*t;
+      QVector3D normal = this->GetTriangleNormalTimesTwiceArea( vertices[0], vertices[1], vertices[2] );
+      if( normal.isNull() ) continue;
+      normal.normalize();
+      const double d = -QVector3D::dotProduct( normal, myPositions[ vertices[0] ] );
+      for( int k=0;  k < 3;  k++ ) myQuadrics[ vertices[k] ].AddPlane( normal.x(), normal.y(), normal.z(), d, 1 );
+      for( int k=0;  k < 3;  k++ )
+      {
+         const quint64 a = vertices[k],  b = vertices[(k+1)%3];
+         if( numberOfTrianglesOfEdges.value( a < b ? (a << 32) | b : (b << 32) | a ) != 1 ) continue;
+         QVector3D boundaryNormal = QVector3D::crossProduct( myPositions[(int)b] - myPositions[(int)a], normal );
+         if( boundaryNormal.isNull() ) continue;
+         boundaryNormal.normalize();
+         const double boundaryD = -QVector3D::dotProduct( boundaryNormal, myPositions[(int)a] );
+         myQuadrics[(int)a].AddPlane( boundaryNormal.x(), boundaryNormal.y(), boundaryNormal.z(), boundaryD, boundaryWeight );
+         myQuadrics[(int)b].AddPlane( boundaryNormal.x(), boundaryNormal.y(), boundaryNormal.z(), boundaryD, boundaryWeight );
+      }
+   }
+
+   // One candidate collapse for each edge.
+   myEdgeCollapses.reserve( numberOfTrianglesOfEdges.count() );
+   for( QHash<quint64,int>::const_iterator it = numberOfTrianglesOfEdges.constBegin();  it != numberOfTrianglesOfEdges.constEnd();  ++it )
+      this->PushEdgeCollapse( (int)( it.key() >> 32 ), (int)( it.key() & 0xFFFFFFFF ) );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimQuadricSimplification::PushEdgeCollapse( const int vertexA, const int vertexB )
+{
+   // The merged vertex's error is measured with both quadrics, at whichever end of the edge has less error.
+   QSimQuadric quadric = myQuadrics[vertexA];
+   quadric.Add( myQuadrics[vertexB] );
+   const double costToB = quadric.GetError( myPositions[vertexB] );
+   const double costToA = quadric.GetError( myPositions[vertexA] );
+   const bool isCollapseToB = costToB <= costToA;
+   QSimEdgeCollapse edgeCollapse;
+   edgeCollapse.myFromVertex = isCollapseToB ? vertexA : vertexB;
+   edgeCollapse.myToVertex   = isCollapseToB ? vertexB : vertexA;
+   edgeCollapse.myCost = qMax( 0.0, isCollapseToB ? costToB : costToA );   // Rounding may make it slightly negative.
+   edgeCollapse.myFromVersion = myVersionOfVertices[ edgeCollapse.myFromVertex ];
+   edgeCollapse.myToVersion   = myVersionOfVertices[ edgeCollapse.myToVertex ];
+   myEdgeCollapses.append( edgeCollapse );
+   std::push_heap( myEdgeCollapses.begin(), myEdgeCollapses.end() );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimQuadricSimplification::GetNeighborsOfVertex( const int vertex, QVector<int>& neighbors ) const
+{
+   // Vertices that share a remaining triangle with vertex (sorted, each listed once).
+   neighbors.resize( 0 );
+   const QVector<int>& triangles = myTrianglesOfVertices[vertex];
+   for( int i=0;  i < triangles.count();  i++ )
+   {
+      const int t = triangles[i];
+      if( myIsTriangleRemoved[t] ) continue;
+      for( int k=0;  k < 3;  k++ ) if( myVerticesOfTriangles[3*t+k] != vertex ) neighbors.append( myVerticesOfTriangles[3*t+k] );
+   }
+   std::sort( neighbors.begin(), neighbors.end() );
+   neighbors.erase( std::unique( neighbors.begin(), neighbors.end() ), neighbors.end() );
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimQuadricSimplification::IsEdgeCollapseValid( const int fromVertex, const int toVertex )
+{
+   // A triangle that moves with fromVertex must not flip over or become degenerate.
+   const QVector<int>& triangles = myTrianglesOfVertices[fromVertex];
+   int numberOfTrianglesOnEdge = 0;
+   for( int i=0;  i < triangles.count();  i++ )
+   {
+      const int t = triangles[i];
+      if( myIsTriangleRemoved[t] ) continue;
+      const int* vertices = myVerticesOfTriangles.constData() + 3*t;
+      if( vertices[0] == toVertex || vertices[1] == toVertex || vertices[2] == toVertex ) { ++numberOfTrianglesOnEdge;  continue; }
+      const QVector3D oldNormal = this->GetTriangleNormalTimesTwiceArea( vertices[0], vertices[1], vertices[2] );
+      const QVector3D newNormal = this->GetTriangleNormalTimesTwiceArea( vertices[0] == fromVertex ? toVertex : vertices[0], vertices[1] == fromVertex ? toVertex : vertices[1], vertices[2] == fromVertex ? toVertex : vertices[2] );
+      if( QVector3D::dotProduct( oldNormal, newNormal ) <= 0.2 * oldNormal.length() * newNormal.length() ) return false;
+   }
+
+   // The surface must stay manifold: the only vertices next to both ends of the edge are those opposite it (one per triangle on the edge).
+   this->GetNeighborsOfVertex( fromVertex, myNeighborsOfFromVertex );
+   this->GetNeighborsOfVertex( toVertex, myNeighborsOfToVertex );
+   int numberOfCommonNeighbors = 0;
+   for( int i=0, j=0;  i < myNeighborsOfFromVertex.count() && j < myNeighborsOfToVertex.count(); )
+   {
+      if(      myNeighborsOfFromVertex[i] < myNeighborsOfToVertex[j] ) ++i;
+      else if( myNeighborsOfFromVertex[i] > myNeighborsOfToVertex[j] ) ++j;
+      else { ++numberOfCommonNeighbors;  ++i;  ++j; }
+   }
+   return numberOfCommonNeighbors <= numberOfTrianglesOnEdge;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimQuadricSimplification::CollapseEdge( const int fromVertex, const int toVertex )
+{
+   // Triangles on the edge are removed, and the other triangles of fromVertex move to toVertex.
+   QVector<int>& trianglesOfFromVertex = myTrianglesOfVertices[fromVertex];
+   QVector<int>& trianglesOfToVertex = myTrianglesOfVertices[toVertex];
+   for( int i=0;  i < trianglesOfFromVertex.count();  i++ )
+   {
+      const int t = trianglesOfFromVertex[i];
+      if( myIsTriangleRemoved[t] ) continue;
+      int* vertices = myVerticesOfTriangles.data() + 3*t;
+      if( vertices[0] == toVertex || vertices[1] == toVertex || vertices[2] == toVertex ) { myIsTriangleRemoved[t] = true;  --myNumberOfTriangles;  continue; }
+      for( int k=0;  k < 3;  k++ ) if( vertices[k] == fromVertex ) vertices[k] = toVertex;
+      trianglesOfToVertex.append( t );
+   }
+   trianglesOfFromVertex.clear();
+   myIsVertexRemoved[fromVertex] = true;
+   myQuadrics[toVertex].Add( myQuadrics[fromVertex] );
+   ++myVersionOfVertices[toVertex];
+
+   // Drop removed triangles from toVertex's list, then replace the candidate collapses of its edges (the old ones are now stale).
+   int numberOfTrianglesKept = 0;
+   for( int i=0;  i < trianglesOfToVertex.count();  i++ ) if( !myIsTriangleRemoved[ trianglesOfToVertex[i] ] ) trianglesOfToVertex[ numberOfTrianglesKept++ ] = trianglesOfToVertex[i];
+   trianglesOfToVertex.resize( numberOfTrianglesKept );
+   this->GetNeighborsOfVertex( toVertex, myNeighborsOfToVertex );
+   const QVector<int> neighbors = myNeighborsOfToVertex;
+   for( int i=0;  i < neighbors.count();  i++ ) this->PushEdgeCollapse( toVertex, neighbors[i] );
+}
+
+
+//------------------------------------------------------------------------------
+QList<QSimSimplifiedMesh>  QSimQuadricSimplification::SimplifyIntoLevelsOfDetail( const int maximumNumberOfLevels )
+{
+   // Collapse the cheapest edge until the number of triangles halves, save that level, and continue from it.
+   // A level's geometric error is estimated from the greatest cost of any collapse so far (the square root of a sum of squared distances).
+   QList<QSimSimplifiedMesh> levels;
+   double maximumCost = 0;
+   int targetNumberOfTriangles = myNumberOfTriangles / 2;
+   while( levels.count() < maximumNumberOfLevels && targetNumberOfTriangles >= QSimMeshSimplifier::GetMinimumNumberOfTrianglesPerLevel() && !myEdgeCollapses.isEmpty() )
+   {
+      std::pop_heap( myEdgeCollapses.begin(), myEdgeCollapses.end() );
+      const QSimEdgeCollapse edgeCollapse = myEdgeCollapses.last();
+      myEdgeCollapses.pop_back();
+      const int fromVertex = edgeCollapse.myFromVertex,  toVertex = edgeCollapse.myToVertex;
+      if( myIsVertexRemoved[fromVertex] || myIsVertexRemoved[toVertex] ) continue;
+      if( edgeCollapse.myFromVersion != myVersionOfVertices[fromVertex] || edgeCollapse.myToVersion != myVersionOfVertices[toVertex] ) continue;
+      if( !this->IsEdgeCollapseValid( fromVertex, toVertex ) ) continue;
+      this->CollapseEdge( fromVertex, toVertex );
+      maximumCost = qMax( maximumCost, edgeCollapse.myCost );
+      if( myNumberOfTriangles <= targetNumberOfTriangles )
+      {
+         levels.append( this->GetSimplifiedMesh( sqrt( maximumCost ) ) );
+         targetNumberOfTriangles = myNumberOfTriangles / 2;
+      }
+   }
+   return levels;
+}
+
+
+//------------------------------------------------------------------------------
+QSimSimplifiedMesh  QSimQuadricSimplification::GetSimplifiedMesh( const qreal geometricError ) const
+{
+   // Only the vertices of remaining triangles are kept, in the order they are first used.
+   QSimSimplifiedMesh mesh;
+   mesh.myGeometricError = geometricError;
+   const bool hasTextureCoordinates = !myTextureCoordinates.isEmpty();
+   QVector<int> newIndexOfVertices( myPositions.count(), -1 );
+   mesh.myIndices.reserve( 3 * myNumberOfTriangles );
+   for( int t=0;  t < myIsTriangleRemoved.count();  t++ )
+   {
+      if( myIsTriangleRemoved[t] ) continue;
+      for( int k=0;  k < 3;  k++ )
+      {
+         const int v = myVerticesOfTriangles[3*t+k];
+         if( newIndexOfVertices[v] < 0 )
+         {
+            newIndexOfVertices[v] = mesh.myPositions.count();
+            mesh.myPositions.append( myPositions[v] );
+            if( hasTextureCoordinates ) mesh.myTextureCoordinates.append( myTextureCoordinates[v] );
+         }
+         mesh.myIndices.append( newIndexOfVertices[v] );
+      }
+   }
+
+   // Smooth normals (each triangle's normal is weighted by its area).
+   const int numberOfVertices = mesh.myPositions.count();
+   mesh.myNormals.resize( numberOfVertices );
+   QVector3D* normals = mesh.myNormals.data();
+   for( int v=0;  v < numberOfVertices;  v++ ) normals[v] = QVector3D( 0, 0, 0 );
+   const QVector3D* positions = mesh.myPositions.constData();
+   for( int i=0;  i + 2 < mesh.myIndices.count();  i += 3 )
+   {
+      const int a = mesh.myIndices[i],  b = mesh.myIndices[i+1],  c = mesh.myIndices[i+2];
+      const QVector3D normalTimesTwiceArea = QVector3D::crossProduct( positions[b] - positions[a], positions[c] - positions[a] );
+      normals[a] += normalTimesTwiceArea;  normals[b] += normalTimesTwiceArea;  normals[c] += normalTimesTwiceArea;
+   }
+   for( int v=0;  v < numberOfVertices;  v++ ) normals[v] = normals[v].isNull() ? QVector3D( 0, 0, 1 ) : normals[v].normalized();
+   return mesh;
+}
+
+
+//------------------------------------------------------------------------------
+QList<QSimSimplifiedMesh>  QSimMeshSimplifier::SimplifyMeshIntoLevelsOfDetail( const QVector3DArray& positions, const QVector2DArray& textureCoordinates, const QVector<int>& indices, const int maximumNumberOfLevels )
+{
+   QSimQuadricSimplification simplification( positions, textureCoordinates, indices );
+   return simplification.SimplifyIntoLevelsOfDetail( maximumNumberOfLevels );
+}
+
+
+//------------------------------------------------------------------------------
+// A mesh found in the scene (copied on the GUI thread) and its levels of detail (calculated on a worker thread).
+// The mesh is the range of mySceneNode's geometry, or all of myCompactMeshOrNull.
+struct QSimMeshSimplifierTask
+{
+   QGLSceneNode*              mySceneNode;
+   QSimCompactMesh*           myCompactMeshOrNull;
+   QVector3DArray             myPositions;
+   QVector2DArray             myTextureCoordinates;
+   QVector<int>               myIndices;
+   QList<QSimSimplifiedMesh>  myLevels;
+   bool  operator<( const QSimMeshSimplifierTask& other ) const  { return myIndices.count() > other.myIndices.count(); }   // Largest first.
+};
+
+
+//------------------------------------------------------------------------------
+static void  SimplifyMeshOfTask( QSimMeshSimplifierTask* task )
+{
+   task->myLevels = QSimMeshSimplifier::SimplifyMeshIntoLevelsOfDetail( task->myPositions, task->myTextureCoordinates, task->myIndices, QSimMeshSimplifier::GetMaximumNumberOfLevelsOfDetail() );
+}
+
+
+//------------------------------------------------------------------------------
+static void  AppendMeshesToSimplify( QGLSceneNode& sceneNode, QSet<QGLSceneNode*>& visitedSceneNodes, QVector<QSimMeshSimplifierTask>& tasks )
+{
+   // A scene node may be listed as a child of more than one node, but its mesh is simplified once.
+   // The levels of a QSimLevelOfDetailMesh are not child QGLSceneNodes, so meshes that already have levels of detail are not visited.
+   if( visitedSceneNodes.contains( &sceneNode ) ) return;
+   visitedSceneNodes.insert( &sceneNode );
+   const int minimumNumberOfTriangles = QSimMeshSimplifier::GetMinimumNumberOfTrianglesToSimplify();
+   QSimMeshSimplifierTask task;
+   task.mySceneNode = &sceneNode;
+   task.myCompactMeshOrNull = qobject_cast<QSimCompactMesh*>( &sceneNode );
+   if( task.myCompactMeshOrNull && task.myCompactMeshOrNull->GetNumberOfTriangles() >= minimumNumberOfTriangles && qobject_cast<QGLSceneNode*>( sceneNode.parent() ) )
+   {
+      // A compact mesh is decoded (its levels are compacted again if the view uses the compact vertex format).
+      const QGeometryData geometry = task.myCompactMeshOrNull->GetDecodedGeometry();
+      task.myPositions = geometry.vertices();
+      if( geometry.hasField( QGL::TextureCoord0 ) ) task.myTextureCoordinates = geometry.texCoords( QGL::TextureCoord0 );
+      const QGL::IndexArray indices = geometry.indices();
+      task.myIndices.resize( indices.count() );
+      for( int i=0;  i < indices.count();  i++ ) task.myIndices[i] = indices.at(i);
+      tasks.append( task );
+   }
+   else if( task.myCompactMeshOrNull == NULL && sceneNode.drawingMode() == QGL::Triangles && sceneNode.count() >= 3 * minimumNumberOfTriangles )
+   {
+      // Only the vertices used by this scene node are copied (QGLBuilder puts the geometry of several scene nodes in one QGeometryData).
+      // Per-vertex colors (e.g., of a QSimTetrahedralMesh) are not kept by simplification, so such meshes are left as they are.
+      const QGeometryData geometry = sceneNode.geometry();
+      const int start = sceneNode.start();
+      const int count = sceneNode.count() - sceneNode.count() % 3;
+      const QGL::IndexArray indices = geometry.indices();
+      const bool isIndexed = indices.count() > 0;
+      if( start >= 0 && start + count <= ( isIndexed ? indices.count() : geometry.count() ) && !geometry.hasField( QGL::Color ) )
+      {
+         int minimumIndex = start, maximumIndex = start + count - 1;
+         if( isIndexed )
+         {
+            minimumIndex = maximumIndex = indices.at( start );
+            for( int i = start + 1;  i < start + count;  i++ ) { minimumIndex = qMin( minimumIndex, (int)indices.at(i) );  maximumIndex = qMax( maximumIndex, (int)indices.at(i) ); }
+         }
+         if( maximumIndex < geometry.count() )
+         {
+            const int numberOfVertices = maximumIndex - minimumIndex + 1;
+            task.myPositions = geometry.vertices().mid( minimumIndex, numberOfVertices );
+            if( geometry.hasField( QGL::TextureCoord0 ) ) task.myTextureCoordinates = geometry.texCoords( QGL::TextureCoord0 ).mid( minimumIndex, numberOfVertices );
+            task.myIndices.resize( count );
+            for( int i=0;  i < count;  i++ ) task.myIndices[i] = ( isIndexed ? (int)indices.at( start + i ) : start + i ) - minimumIndex;
+            tasks.append( task );
+         }
+      }
+   }
+
+   const QList<QGLSceneNode*> childSceneNodes = sceneNode.children();
+   for( QList<QGLSceneNode*>::const_iterator it = childSceneNodes.constBegin();  it != childSceneNodes.constEnd();  ++it )
+      AppendMeshesToSimplify( **it, visitedSceneNodes, tasks );
+}
+
+
+//------------------------------------------------------------------------------
+int  QSimMeshSimplifier::GenerateLevelsOfDetailForAllMeshes( QWidget* parentWidgetOrNull )
+{
+   QTime simplifyTimer;
+   simplifyTimer.start();
+   this->ClearMeshSimplifierStatistics();
+
+   // Copy the meshes, largest first (so the longest tasks start first and the worker threads finish at about the same time).
+   QVector<QSimMeshSimplifierTask> tasks;
+   QSet<QGLSceneNode*> visitedSceneNodes;
+   AppendMeshesToSimplify( myGLViewWidget.GetMostParentSceneNode(), visitedSceneNodes, tasks );
+   if( tasks.isEmpty() ) return 0;
+   std::sort( tasks.begin(), tasks.end() );
+
+   // All meshes are queued for the global thread pool, then waited for in order (the progress dialog processes events each time its value is set).
+   // Even when canceled, every task is finished before returning, as tasks refer to this method's data.
+   QProgressDialog progressDialog( tr("Simplifying %1 meshes...").arg( tasks.count() ), tr("Cancel"), 0, tasks.count(), parentWidgetOrNull );
+   progressDialog.setWindowModality( Qt::WindowModal );
+   progressDialog.setMinimumDuration( 500 );
+   QList< QFuture<void> > futures;
+   for( int i=0;  i < tasks.count();  i++ ) futures.append( QtConcurrent::run( SimplifyMeshOfTask, &tasks[i] ) );
+   bool wasCanceled = false;
+   for( int i=0;  i < futures.count();  i++ )
+   {
+      futures[i].waitForFinished();
+      progressDialog.setValue( i + 1 );
+      wasCanceled = wasCanceled || progressDialog.wasCanceled();
+   }
+   if( wasCanceled ) return 0;
+
+   // Replace each mesh by its chain of levels of detail (its finest level is the original mesh, without copying it).
+   for( int i=0;  i < tasks.count();  i++ )
+   {
+      QSimMeshSimplifierTask& task = tasks[i];
+      if( task.myLevels.isEmpty() ) continue;
+      QSimLevelOfDetailMesh* levelOfDetailMesh = new QSimLevelOfDetailMesh;
+      QGLSceneNode* parentSceneNode = NULL;
+      QGLSceneNode* finestSceneNode = NULL;
+      if( task.myCompactMeshOrNull )
+      {
+         parentSceneNode = qobject_cast<QGLSceneNode*>( task.myCompactMeshOrNull->parent() );
+         parentSceneNode->removeNode( task.myCompactMeshOrNull );
+         finestSceneNode = task.myCompactMeshOrNull;
+      }
+      else
+      {
+         parentSceneNode = task.mySceneNode;
+         finestSceneNode = new QGLSceneNode;
+         finestSceneNode->setGeometry( parentSceneNode->geometry() );
+         finestSceneNode->setStart( parentSceneNode->start() );
+         finestSceneNode->setCount( parentSceneNode->count() );
+         finestSceneNode->setDrawingMode( QGL::Triangles );
+         parentSceneNode->setStart( 0 );
+         parentSceneNode->setCount( 0 );
+         parentSceneNode->setGeometry( QGeometryData() );
+      }
+      QBox3D boundingBox;
+      for( int v=0;  v < task.myPositions.count();  v++ ) boundingBox.unite( task.myPositions.at(v) );
+      levelOfDetailMesh->SetBoundingBox( boundingBox );
+      levelOfDetailMesh->AddLevelOfDetail( finestSceneNode, 0, task.myIndices.count() / 3 );
+
+      // Coarser levels are new scene nodes (in the compact vertex format if the view uses it).
+      for( int level=0;  level < task.myLevels.count();  level++ )
+      {
+         const QSimSimplifiedMesh& simplifiedMesh = task.myLevels[level];
+         QGeometryData geometry;
+         geometry.appendVertexArray( simplifiedMesh.myPositions );
+         geometry.appendNormalArray( simplifiedMesh.myNormals );
+         if( !simplifiedMesh.myTextureCoordinates.isEmpty() ) geometry.appendTexCoordArray( simplifiedMesh.myTextureCoordinates );
+         QGL::IndexArray indices;
+         indices.reserve( simplifiedMesh.myIndices.count() );
+         for( int k=0;  k < simplifiedMesh.myIndices.count();  k++ ) indices.append( simplifiedMesh.myIndices[k] );
+         geometry.appendIndices( indices );
+         QGLSceneNode* levelSceneNode = new QGLSceneNode;
+         levelSceneNode->setGeometry( geometry );
+         levelSceneNode->setStart( 0 );
+         levelSceneNode->setCount( simplifiedMesh.myIndices.count() );
+         levelSceneNode->setDrawingMode( QGL::Triangles );
+         myGLViewWidget.ConvertToCompactVertexFormatIfUsed( *levelSceneNode );
+         levelOfDetailMesh->AddLevelOfDetail( levelSceneNode, simplifiedMesh.myGeometricError, simplifiedMesh.GetNumberOfTriangles() );
+      }
+      levelOfDetailMesh->setObjectName( parentSceneNode->objectName() );
+      parentSceneNode->addNode( levelOfDetailMesh );
+
+      // The object that owns the mesh (nearest QSimSceneNode) recalculates its bounds and statistics.
+      for( QObject* ancestor = parentSceneNode;  ancestor != NULL;  ancestor = ancestor->parent() )
+      {
+         QGLSceneNode* ancestorSceneNode = qobject_cast<QGLSceneNode*>( ancestor );
+         QSimSceneNode* ancestorQSimSceneNode = ancestorSceneNode ? QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( *ancestorSceneNode ) : NULL;
+         if( ancestorQSimSceneNode ) { ancestorQSimSceneNode->SetGeometryWasChanged();  break; }
+      }
+      ++myNumberOfMeshesSimplified;
+      myNumberOfTrianglesBefore += task.myIndices.count() / 3;
+      myNumberOfTrianglesInCoarsest += task.myLevels.last().GetNumberOfTriangles();
+   }
+   mySimplifyTimeInMilliseconds = simplifyTimer.elapsed();
+   myGLViewWidget.updateGL();
+   return myNumberOfMeshesSimplified;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
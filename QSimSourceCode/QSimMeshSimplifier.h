@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------------------
+// File:     QSimMeshSimplifier.h
+// Class:    QSimMeshSimplifier
+// Parents:  QObject
+// Purpose:  Simplifies the meshes in a scene (quadric error metrics) into chains of levels of detail, on worker threads.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMMESHSIMPLIFIER_H__
+#define  QSIMMESHSIMPLIFIER_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglscenenode.h"
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Forward declarations
+class  QSimGLViewWidget;
+
+
+//------------------------------------------------------------------------------
+// One simplified version of a mesh (three indices per triangle) and how far its surface may be from the original surface.
+struct QSimSimplifiedMesh
+{
+   QVector3DArray  myPositions;
+   QVector3DArray  myNormals;
+   QVector2DArray  myTextureCoordinates;   // Empty unless the original mesh has texture coordinates.
+   QVector<int>    myIndices;
+   qreal           myGeometricError;
+   int  GetNumberOfTriangles() const  { return myIndices.count() / 3; }
+};
+
+
+//------------------------------------------------------------------------------
+class QSimMeshSimplifier : public QObject
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimMeshSimplifier( QSimGLViewWidget& glViewWidget ) : QObject(NULL), myGLViewWidget(glViewWidget)  { this->ClearMeshSimplifierStatistics(); }
+  ~QSimMeshSimplifier()  {;}
+
+   // Simplify a triangle mesh by repeatedly collapsing the edge whose collapse adds the least quadric error (the sum of squared distances
+   // to the planes of the original triangles around the merged vertices).  Vertices at the same position are merged first, so seams do not
+   // open, and edges on a boundary are kept in place by extra planes perpendicular to their triangles.  Each edge collapses onto one of its
+   // vertices, so the remaining vertices keep their original positions and texture coordinates (normals are recalculated for each level).
+   // Returns up to maximumNumberOfLevels simplified meshes, each with about half as many triangles as the one before, and none with
+   // fewer than GetMinimumNumberOfTrianglesPerLevel() triangles.
+   static QList<QSimSimplifiedMesh>  SimplifyMeshIntoLevelsOfDetail( const QVector3DArray& positions, const QVector2DArray& textureCoordinates, const QVector<int>& indices, const int maximumNumberOfLevels );
+
+   // Replace every mesh in the view (imported meshes, primitives, and compact meshes) with at least GetMinimumNumberOfTrianglesToSimplify()
+   // triangles by a QSimLevelOfDetailMesh whose finest level is the original mesh.  Meshes are simplified in parallel on worker threads.
+   // Clustered meshes and meshes that already have levels of detail are left as they are.  Levels of detail are not written to scene files.
+   // Shows a progress dialog with a cancel button.  Returns the number of meshes that were given levels of detail (0 if canceled).
+   int  GenerateLevelsOfDetailForAllMeshes( QWidget* parentWidgetOrNull );
+
+   static int  GetMinimumNumberOfTrianglesToSimplify()   { return 1024; }
+   static int  GetMinimumNumberOfTrianglesPerLevel()     { return 64; }
+   static int  GetMaximumNumberOfLevelsOfDetail()        { return 6; }   // Not counting the original mesh.
+
+   // Statistics from the most recent call to GenerateLevelsOfDetailForAllMeshes (helpful for profiling).
+   unsigned int  GetNumberOfMeshesSimplified() const       { return myNumberOfMeshesSimplified; }
+   qint64        GetNumberOfTrianglesBefore() const        { return myNumberOfTrianglesBefore; }
+   qint64        GetNumberOfTrianglesInCoarsest() const    { return myNumberOfTrianglesInCoarsest; }
+   qint64        GetSimplifyTimeInMilliseconds() const     { return mySimplifyTimeInMilliseconds; }
+
+private:
+   // The view widget whose meshes are simplified.
+   QSimGLViewWidget&  myGLViewWidget;
+
+   // Statistics from the most recent call to GenerateLevelsOfDetailForAllMeshes.
+   void          ClearMeshSimplifierStatistics()  { myNumberOfMeshesSimplified = 0;  myNumberOfTrianglesBefore = myNumberOfTrianglesInCoarsest = mySimplifyTimeInMilliseconds = 0; }
+   unsigned int  myNumberOfMeshesSimplified;
+   qint64        myNumberOfTrianglesBefore;
+   qint64        myNumberOfTrianglesInCoarsest;
+   qint64        mySimplifyTimeInMilliseconds;
+
+   // Disable default constructors and copying.
+   QSimMeshSimplifier();
+   QSimMeshSimplifier( const QSimMeshSimplifier& );
+   QSimMeshSimplifier&  operator=( const QSimMeshSimplifier& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMMESHSIMPLIFIER_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,195 @@
+//-----------------------------------------------------------------------------
+// File:     QSimOffscreenRenderer.cpp
+// Class:    QSimOffscreenRenderer
+// Parents:  None
+// Purpose:  Draws the objects in a QSimGLViewWidget into an offscreen buffer (no window) and returns an image of any size.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "qglcamera.h"
+#include "qglframebufferobjectsurface.h"
+#include "QSimOffscreenRenderer.h"
+#include "QSimGLViewWidget.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimOffscreenRenderer::QSimOffscreenRenderer( QSimGLViewWidget& glViewWidget ) : myGLViewWidget(glViewWidget)
+{
+   myPixelBufferOrNull = NULL;
+   myFramebufferObjectOrNull = NULL;
+   if( !QGLPixelBuffer::hasOpenGLPbuffers() ) return;
+
+   // A small pixel buffer provides the OpenGL context (sharing textures with the view widget).
+   // If framebuffer objects are supported, tiles are drawn into one of those (with a depth buffer) at the largest convenient size.
+   QGLFormat pixelBufferFormat = glViewWidget.format();
+   pixelBufferFormat.setDepth( true );
+   myPixelBufferOrNull = new QGLPixelBuffer( QSize(16,16), pixelBufferFormat, &glViewWidget );
+   if( !myPixelBufferOrNull->isValid() || !myPixelBufferOrNull->makeCurrent() ) { delete myPixelBufferOrNull;  myPixelBufferOrNull = NULL;  return; }
+
+   GLint maxViewportDimensions[2] = { 0, 0 };
+   GLint maxTextureSize = 0;
+   glGetIntegerv( GL_MAX_VIEWPORT_DIMS, maxViewportDimensions );
+   glGetIntegerv( GL_MAX_TEXTURE_SIZE, &maxTextureSize );
+   const int maxTileDimension = qBound( 256, qMin( qMin( (int)maxViewportDimensions[0], (int)maxViewportDimensions[1] ), (int)maxTextureSize ), 2048 );
+   myTileSize = QSize( maxTileDimension, maxTileDimension );
+
+   if( QGLFramebufferObject::hasOpenGLFramebufferObjects() )
+   {
+      myFramebufferObjectOrNull = new QGLFramebufferObject( myTileSize, QGLFramebufferObject::Depth );
+      if( !myFramebufferObjectOrNull->isValid() ) { delete myFramebufferObjectOrNull;  myFramebufferObjectOrNull = NULL; }
+   }
+
+   // Without a framebuffer object, tiles are drawn directly into a pixel buffer of the tile size.
+   if( myFramebufferObjectOrNull == NULL )
+   {
+      myPixelBufferOrNull->doneCurrent();
+      delete myPixelBufferOrNull;
+      myTileSize = QSize( 1024, 1024 );
+      myPixelBufferOrNull = new QGLPixelBuffer( myTileSize, pixelBufferFormat, &glViewWidget );
+   }
+   myPixelBufferOrNull->doneCurrent();
+
+   // A tile size that is not set up would never advance the tiling loop, so the renderer is only valid with a usable pixel buffer and tile size.
+   if( !myPixelBufferOrNull->isValid() || myTileSize.isEmpty() ) { delete myPixelBufferOrNull;  myPixelBufferOrNull = NULL;  myTileSize = QSize(); }
+}
+
+
+//------------------------------------------------------------------------------
+QSimOffscreenRenderer::~QSimOffscreenRenderer()
+{
+   // The framebuffer object belongs to the pixel buffer's context, so delete it while that context is current.
+   if( myPixelBufferOrNull && myPixelBufferOrNull->isValid() ) myPixelBufferOrNull->makeCurrent();
+   delete myFramebufferObjectOrNull;
+   if( myPixelBufferOrNull && myPixelBufferOrNull->isValid() ) myPixelBufferOrNull->doneCurrent();
+   delete myPixelBufferOrNull;
+}
+
+
+//------------------------------------------------------------------------------
+QImage  QSimOffscreenRenderer::RenderSceneToImage( const QSize& imageSize, const QColor& backgroundColor )
+{
+   if( imageSize.isEmpty() || !this->IsOffscreenRendererValid() ) return QImage();
+   if( !myPixelBufferOrNull->makeCurrent() ) { qWarning( "QSimOffscreenRenderer: Cannot make the offscreen OpenGL context current." );  return QImage(); }
+
+   // The whole image uses the camera's projection for the image's aspect ratio.
+   const QGLCamera& camera = *( myGLViewWidget.camera() );
+   const qreal imageWidth  = imageSize.width();
+   const qreal imageHeight = imageSize.height();
+   const QMatrix4x4 projectionMatrix = camera.projectionMatrix( imageWidth / imageHeight );
+   const QMatrix4x4 modelViewMatrix = camera.modelViewMatrix();
+
+   QImage image( imageSize, QImage::Format_ARGB32_Premultiplied );
+   image.fill( backgroundColor.rgba() );
+   QPainter imagePainter( &image );
+   bool isEveryTileDrawn = true;
+   for( int top = 0;  top < imageSize.height() && isEveryTileDrawn;  top += myTileSize.height() )
+   {
+      for( int left = 0;  left < imageSize.width() && isEveryTileDrawn;  left += myTileSize.width() )
+      {
+         // Region of the full image covered by this tile in normalized device coordinates (y is up in OpenGL and down in the image).
+         // Scale and shift so this region fills the tile (tiles at the right or bottom edge may extend past the image and are clipped).
+         const qreal ndcLeft   = -1.0 + 2.0 * left / imageWidth;
+         const qreal ndcRight  = -1.0 + 2.0 * (left + myTileSize.width()) / imageWidth;
+         const qreal ndcTop    =  1.0 - 2.0 * top / imageHeight;
+         const qreal ndcBottom =  1.0 - 2.0 * (top + myTileSize.height()) / imageHeight;
+         QMatrix4x4 tileMatrix;
+         tileMatrix.scale( 2.0 / (ndcRight - ndcLeft), 2.0 / (ndcTop - ndcBottom), 1.0 );
+         tileMatrix.translate( -0.5 * (ndcRight + ndcLeft), -0.5 * (ndcTop + ndcBottom), 0.0 );
+
+         if( !this->RenderTile( tileMatrix * projectionMatrix, modelViewMatrix, backgroundColor ) ) isEveryTileDrawn = false;
+         else imagePainter.drawImage( left, top, this->ReadTileImage() );
+      }
+   }
+   imagePainter.end();
+   myPixelBufferOrNull->doneCurrent();
+   return isEveryTileDrawn ? image : QImage();
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimOffscreenRenderer::RenderSceneAndFinish( const QSize& imageSize, const QColor& backgroundColor )
+{
+   if( imageSize.isEmpty() || imageSize.width() > myTileSize.width() || imageSize.height() > myTileSize.height() ) return false;
+   if( !this->IsOffscreenRendererValid() || !myPixelBufferOrNull->makeCurrent() ) return false;
+
+   // The tile is larger than the image, so shrink the projection so the image fills the lower-left corner of the tile (as a tile does).
+   const QGLCamera& camera = *( myGLViewWidget.camera() );
+   const qreal imageWidth  = imageSize.width();
+   const qreal imageHeight = imageSize.height();
+   QMatrix4x4 tileMatrix;
+   tileMatrix.translate( imageWidth / myTileSize.width() - 1.0, imageHeight / myTileSize.height() - 1.0, 0.0 );
+   tileMatrix.scale( imageWidth / myTileSize.width(), imageHeight / myTileSize.height(), 1.0 );
+   const bool isSceneRendered = this->RenderTile( tileMatrix * camera.projectionMatrix( imageWidth / imageHeight ), camera.modelViewMatrix(), backgroundColor );
+   glFinish();
+   myPixelBufferOrNull->doneCurrent();
+   return isSceneRendered;
+}
+
+
+//------------------------------------------------------------------------------
+QString  QSimOffscreenRenderer::GetOpenGLDescription()
+{
+   if( !this->IsOffscreenRendererValid() || !myPixelBufferOrNull->makeCurrent() ) return QString();
+   const QString description = QString("%1, %2, OpenGL %3").arg( (const char*)glGetString(GL_VENDOR) ).arg( (const char*)glGetString(GL_RENDERER) ).arg( (const char*)glGetString(GL_VERSION) );
+   myPixelBufferOrNull->doneCurrent();
+   return description;
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimOffscreenRenderer::RenderTile( const QMatrix4x4& projectionMatrix, const QMatrix4x4& modelViewMatrix, const QColor& backgroundColor )
+{
+   // Paint on the pixel buffer's (current) context, redirected to the framebuffer object if there is one.
+   QGLPainter painter;
+   if( !painter.begin() ) return false;
+   QGLFramebufferObjectSurface framebufferObjectSurface( myFramebufferObjectOrNull );
+   if( myFramebufferObjectOrNull ) painter.pushSurface( &framebufferObjectSurface );
+
+   glClearColor( backgroundColor.redF(), backgroundColor.greenF(), backgroundColor.blueF(), backgroundColor.alphaF() );
+   glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+   glEnable( GL_DEPTH_TEST );
+
+   // Same objects and render order as the view widget, seen through the tile's portion of the camera's projection.
+   painter.projectionMatrix() = projectionMatrix;
+   painter.modelViewMatrix() = modelViewMatrix;
+   painter.setStandardEffect( QGL::LitMaterial );
+   myGLViewWidget.DrawAllObjectsInQSimGLViewWidget( painter );
+
+   if( myFramebufferObjectOrNull ) painter.popSurface();
+   painter.end();
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+// File:     QSimOffscreenRenderer.h
+// Class:    QSimOffscreenRenderer
+// Parents:  None
+// Purpose:  Draws the objects in a QSimGLViewWidget into an offscreen buffer (no window) and returns an image of any size.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMOFFSCREENRENDERER_H__
+#define  QSIMOFFSCREENRENDERER_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglpainter.h"
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Forward declarations
+class  QSimGLViewWidget;
+
+
+//------------------------------------------------------------------------------
+class QSimOffscreenRenderer
+{
+public:
+   // Constructors and destructors.
+   // The offscreen OpenGL context shares textures and other resources with the view widget's context,
+   // but draws into a pixel buffer (or a framebuffer object inside it) rather than a window.
+   QSimOffscreenRenderer( QSimGLViewWidget& glViewWidget );
+  ~QSimOffscreenRenderer();
+
+   // Returns false if this computer's OpenGL does not support offscreen rendering or the offscreen context could not be set up (then images are null).
+   bool  IsOffscreenRendererValid() const  { return myPixelBufferOrNull != NULL && myPixelBufferOrNull->isValid() && !myTileSize.isEmpty(); }
+
+   // Draw the view widget's objects, as seen by its camera, into an image of the given size.
+   // Images larger than the largest buffer OpenGL allows are drawn in tiles and assembled.  Returns a null image on failure.
+   QImage  RenderSceneToImage( const QSize& imageSize, const QColor& backgroundColor = Qt::black );
+
+   // Draw the scene (at most one tile in size) and wait for OpenGL to finish, without reading the image back (e.g., for benchmarks).
+   bool  RenderSceneAndFinish( const QSize& imageSize, const QColor& backgroundColor = Qt::black );
+
+   // OpenGL vendor, renderer, and version strings of the offscreen context (e.g., to record with benchmark results).
+   QString  GetOpenGLDescription();
+
+private:
+   // Draw one tile (the region of the full image selected by projectionMatrix) into the framebuffer object or pixel buffer.
+   bool    RenderTile( const QMatrix4x4& projectionMatrix, const QMatrix4x4& modelViewMatrix, const QColor& backgroundColor );
+   QImage  ReadTileImage()  { return myFramebufferObjectOrNull ? myFramebufferObjectOrNull->toImage() : myPixelBufferOrNull->toImage(); }
+
+   // The view widget whose objects, camera, and textures are drawn.
+   QSimGLViewWidget&  myGLViewWidget;
+
+   // Offscreen OpenGL context and the buffer that is drawn into (a framebuffer object if supported, otherwise the pixel buffer itself).
+   QGLPixelBuffer*         myPixelBufferOrNull;
+   QGLFramebufferObject*   myFramebufferObjectOrNull;
+   QSize                   myTileSize;
+
+   // Disable default constructors and copying.
+   QSimOffscreenRenderer();
+   QSimOffscreenRenderer( const QSimOffscreenRenderer& );
+   QSimOffscreenRenderer&  operator=( const QSimOffscreenRenderer& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMOFFSCREENRENDERER_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+// File:     QSimRenderQueue.cpp
+// Class:    QSimRenderQueue
+// Parents:  None
+// Purpose:  Sorts on-screen objects by render state (effect, texture, material, depth) and draws them with few state changes.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimRenderQueue.h"
+#include "QSimSceneNode.h"
+#include "QSimMaterialLibrary.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+void  QSimRenderQueue::ClearRenderQueue()
+{
+   // QVector::clear() frees memory, whereas resize(0) keeps the reserved capacity for the next frame.
+   myRenderQueueItems.resize( 0 );
+   myUserEffectRanks.clear();
+}
+
+
+//------------------------------------------------------------------------------
+quint64  QSimRenderQueue::GetUserEffectRank( const void* userEffect )
+{
+   // Ranks 0 and 1 are reserved for the standard effects LitMaterial and LitDecalTexture2D.
+   QHash<const void*, quint64>::const_iterator it = myUserEffectRanks.constFind( userEffect );
+   if( it != myUserEffectRanks.constEnd() ) return it.value();
+   const quint64 rank = qMin( (quint64)( 2 + myUserEffectRanks.count() ), (quint64)0xFF );
+   myUserEffectRanks.insert( userEffect, rank );
+   return rank;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimRenderQueue::AddSceneEntitiesToRenderQueue( const QSimSceneStore& sceneStore, const QVector<QSimSceneEntityId>& entityIds, const QMatrix4x4& viewMatrix, const qreal farPlaneDistance )
+{
+   // Only the camera's z-axis (third row of the view matrix) is needed for each object's depth.
+   const QVector4D viewMatrixRow2 = viewMatrix.row(2);
+   const int numberOfEntityIds = entityIds.count();
+   for( int i=0;  i < numberOfEntityIds;  i++ )
+   {
+      const QSimSceneEntityId id = entityIds[i];
+
+      // Effect rank.
+      const QGLAbstractEffect* userEffect = sceneStore.GetAbstractEffect( id );
+      const QSimTextureHandle textureHandle = sceneStore.GetTextureHandle( id );
+      const quint64 effectRank = userEffect ? this->GetUserEffectRank( userEffect ) : ( textureHandle ? 1 : 0 );
+
+      // Texture and material ranks (textures and materials are shared, so objects with the same texture or material have the same handle).
+      const quint64 textureRank  = textureHandle;
+      const quint64 materialRank = sceneStore.GetMaterialHandleBasedOnHoverStatus( id );
+
+      // Distance from the camera to the object's origin (camera looks down its negative z-axis), scaled to 24 bits.
+      const QVector3D origin = sceneStore.GetWorldMatrix( id ).column(3).toVector3D();
+      const qreal distanceFromCamera = -( viewMatrixRow2.x()*origin.x() + viewMatrixRow2.y()*origin.y() + viewMatrixRow2.z()*origin.z() + viewMatrixRow2.w() );
+      qreal depthFraction = farPlaneDistance > 0 ? distanceFromCamera / farPlaneDistance : 0;
+      if( depthFraction < 0 ) depthFraction = 0;
+      else if( depthFraction > 1 ) depthFraction = 1;
+      const quint64 depthRank = (quint64)( depthFraction * 0xFFFFFF );
+
+      QSimRenderQueueItem item;
+      item.mySortKey = (effectRank << 56) | (textureRank << 40) | (materialRank << 24) | depthRank;
+      item.mySceneEntityId = id;
+      myRenderQueueItems.append( item );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimRenderQueue::DrawRenderQueue( QGLPainter& painter, const QSimSceneStore& sceneStore, QSimTextureManager& textureManager )
+{
+   // Keep track of the most recently applied state so that redundant changes are skipped.
+   // The painter's state on entry is unknown, so the first object always sets everything.
+   const QGLAbstractEffect*  lastUserEffect = NULL;
+   QSimTextureHandle         lastTextureHandle = 0;
+   QSimMaterialHandle        lastMaterialHandle = 0;
+   bool                      isMaterialSet = false;
+   QGL::StandardEffect       lastStandardEffect = QGL::LitMaterial;
+   bool                      isEffectSet = false;
+
+   myNumberOfObjectsDrawnInLastFrame = 0;
+   myNumberOfStateChangesInLastFrame = 0;
+   myNumberOfDrawCallsInLastFrame = 0;
+   myNumberOfTrianglesInLastFrame = 0;
+
+   const int numberOfItems = myRenderQueueItems.count();
+   for( int i=0;  i < numberOfItems;  i++ )
+   {
+      const QSimSceneEntityId id = myRenderQueueItems[i].mySceneEntityId;
+
+      // Apply the material (and its color) only if it differs from the previous object's material.
+      const QSimMaterialHandle materialHandle = sceneStore.GetMaterialHandleBasedOnHoverStatus( id );
+      if( !isMaterialSet || materialHandle != lastMaterialHandle )
+      {
+         const QSimMaterialType& material = QSimMaterialLibrary::GetQSimMaterialLibrary().GetMaterial( materialHandle );
+         painter.setColor( material.diffuseColor() );
+         painter.setFaceMaterial( QGL::AllFaces, &material );
+         lastMaterialHandle = materialHandle;
+         isMaterialSet = true;
+         ++myNumberOfStateChangesInLastFrame;
+      }
+
+      // Apply the designated (or standard) abstract effect only if it changed.
+      QGLAbstractEffect* userEffect = sceneStore.GetAbstractEffect( id );
+      // An object whose texture is still being decoded (on a worker thread) is drawn without its texture.
+      const QSimTextureHandle textureHandle = textureManager.IsTextureReady( sceneStore.GetTextureHandle( id ) ) ? sceneStore.GetTextureHandle( id ) : 0;
+      if( userEffect )
+      {
+         if( !isEffectSet || userEffect != lastUserEffect )
+         {
+            painter.setUserEffect( userEffect );
+            lastUserEffect = userEffect;
+            isEffectSet = true;
+            ++myNumberOfStateChangesInLastFrame;
+         }
+      }
+      else
+      {
+         const QGL::StandardEffect standardEffect = textureHandle ? QGL::LitDecalTexture2D : QGL::LitMaterial;
+         if( !isEffectSet || lastUserEffect != NULL || standardEffect != lastStandardEffect )
+         {
+            painter.setStandardEffect( standardEffect );
+            lastStandardEffect = standardEffect;
+            lastUserEffect = NULL;
+            isEffectSet = true;
+            ++myNumberOfStateChangesInLastFrame;
+         }
+      }
+
+      // Bind the texture only if it differs from the texture that is already bound (the texture manager uploads it if needed).
+      if( textureHandle && textureHandle != lastTextureHandle )
+      {
+         textureManager.BindTexture( textureHandle );
+         lastTextureHandle = textureHandle;
+         ++myNumberOfStateChangesInLastFrame;
+      }
+
+      // Draw the geometry with the state that was just applied.
+      QSimSceneNode& sceneNode = sceneStore.GetSceneNode( id );
+      sceneNode.DrawOpenGLGeometryForQSimSceneNode( painter );
+      ++myNumberOfObjectsDrawnInLastFrame;
+      myNumberOfDrawCallsInLastFrame += sceneNode.GetNumberOfDrawCalls();
+      myNumberOfTrianglesInLastFrame += sceneNode.GetNumberOfTriangles();
+   }
+
+   // Leave the painter in its usual state (once, rather than after each object).
+   if( isEffectSet && (lastUserEffect != NULL || lastStandardEffect != QGL::LitMaterial) )
+      painter.setStandardEffect( QGL::LitMaterial );
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
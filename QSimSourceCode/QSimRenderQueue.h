@@ -0,0 +1,101 @@
+//-----------------------------------------------------------------------------
+// File:     QSimRenderQueue.h
+// Class:    QSimRenderQueue
+// Parents:  None
+// Purpose:  Sorts on-screen objects by render state (effect, texture, material, depth) and draws them with few state changes.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMRENDERQUEUE_H__
+#define  QSIMRENDERQUEUE_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglpainter.h"
+#include "CppStandardHeaders.h"
+#include "QSimTextureManager.h"
+#include "QSimSceneStore.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+//------------------------------------------------------------------------------
+class QSimRenderQueue
+{
+public:
+   // Constructors and destructors.
+   QSimRenderQueue()   { myRenderQueueItems.reserve( 100 );  this->ClearRenderQueue();  myNumberOfObjectsDrawnInLastFrame = myNumberOfStateChangesInLastFrame = myNumberOfDrawCallsInLastFrame = myNumberOfTrianglesInLastFrame = 0; }
+  ~QSimRenderQueue()   {;}
+
+   // Each frame: clear the queue, add every object that needs to be painted, sort, then draw.
+   // Objects are entities in sceneStore, whose world matrices must be up to date (e.g., after QSimSceneStore::AppendSceneEntitiesInViewFrustum).
+   // viewMatrix is the camera's model-view matrix and farPlaneDistance is used to scale the depth portion of the sort key.
+   void  ClearRenderQueue();
+   void  AddSceneEntitiesToRenderQueue( const QSimSceneStore& sceneStore, const QVector<QSimSceneEntityId>& entityIds, const QMatrix4x4& viewMatrix, const qreal farPlaneDistance );
+   void  SortRenderQueue()  { qSort( myRenderQueueItems.begin(), myRenderQueueItems.end() ); }
+   void  DrawRenderQueue( QGLPainter& painter, const QSimSceneStore& sceneStore, QSimTextureManager& textureManager );
+
+   // Statistics from the most recent call to DrawRenderQueue (helpful for profiling).
+   unsigned int  GetNumberOfObjectsDrawnInLastFrame() const   { return myNumberOfObjectsDrawnInLastFrame; }
+   unsigned int  GetNumberOfStateChangesInLastFrame() const   { return myNumberOfStateChangesInLastFrame; }
+   unsigned int  GetNumberOfDrawCallsInLastFrame() const      { return myNumberOfDrawCallsInLastFrame; }
+   unsigned int  GetNumberOfTrianglesInLastFrame() const      { return myNumberOfTrianglesInLastFrame; }
+
+private:
+   // The sort key packs render state from most to least expensive to change, so that sorting groups similar objects.
+   // Bits 63-56: effect rank (0 is LitMaterial, 1 is LitDecalTexture2D, 2 or more is a user effect).
+   // Bits 55-40: texture rank (the texture's handle in the texture manager, 0 is no texture).
+   // Bits 39-24: material rank (the material's handle in the shared material library).
+   // Bits 23-0:  distance from camera (front to back so nearby opaque objects hide far ones early).
+   struct QSimRenderQueueItem
+   {
+      quint64            mySortKey;
+      QSimSceneEntityId  mySceneEntityId;
+      bool  operator<( const QSimRenderQueueItem& other ) const  { return mySortKey < other.mySortKey; }
+   };
+   QVector<QSimRenderQueueItem>  myRenderQueueItems;
+
+   // User effects are given small per-frame ranks so they fit in the sort key.
+   QHash<const void*, quint64>  myUserEffectRanks;
+   quint64  GetUserEffectRank( const void* userEffect );
+
+   // Statistics from the most recent call to DrawRenderQueue.
+   unsigned int  myNumberOfObjectsDrawnInLastFrame;
+   unsigned int  myNumberOfStateChangesInLastFrame;
+   unsigned int  myNumberOfDrawCallsInLastFrame;
+   unsigned int  myNumberOfTrianglesInLastFrame;
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMRENDERQUEUE_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,386 @@
+//-----------------------------------------------------------------------------
+// File:     QSimRenderingBenchmark.cpp
+// Class:    QSimRenderingBenchmark
+// Parents:  None
+// Purpose:  Builds synthetic scenes, renders them offscreen along a scripted camera path, and writes the measurements as JSON.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "qglcamera.h"
+#include "QSimRenderingBenchmark.h"
+#include "QSimGLViewWidget.h"
+#include "QSimOffscreenRenderer.h"
+#include "QImageViewerDialog.h"
+#include "QGLExtrudedPolygon.h"
+#if defined(Q_OS_WIN)
+   #include <windows.h>
+   #include <psapi.h>
+#elif defined(Q_OS_MAC)
+   #include <mach/mach.h>
+#elif defined(Q_OS_UNIX)
+   #include <unistd.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+bool  QSimRenderingBenchmark::RunAllRenderingBenchmarks( const QString& jsonFilename )
+{
+   myResults.clear();
+   QString openGLDescription;
+   bool isEveryScenarioRun = true;
+
+   // Many spheres at each smoothness (how cost grows with triangles per object).
+   for( int smoothness = 1;  smoothness <= 9;  smoothness += 2 )
+   {
+      QSimRenderingBenchmarkResult result;
+      isEveryScenarioRun = isEveryScenarioRun && this->RunRenderingBenchmarkScenario( QString("Spheres smoothness %1").arg(smoothness), SceneOfSpheres, 500, smoothness, result, openGLDescription );
+      myResults.append( result );
+   }
+
+   // The smoothest spheres again, with vertices in the compact vertex format (how much less memory and bandwidth saves).
+   QSimRenderingBenchmarkResult compactResult;
+   isEveryScenarioRun = isEveryScenarioRun && this->RunRenderingBenchmarkScenario( "Spheres smoothness 9 compact vertices", SceneOfSpheresWithCompactVertices, 500, 9, compactResult, openGLDescription );
+   myResults.append( compactResult );
+
+   // Many objects of different types, half with textures (how cost grows with render-state changes).
+   // A deep chain of bodies, each positioned relative to its parent (how cost grows with hierarchy depth).
+   const unsigned int numberOfObjects[] = { 100, 1000 };
+   for( int i=0;  i < 2;  i++ )
+   {
+      QSimRenderingBenchmarkResult mixedResult, hierarchyResult;
+      isEveryScenarioRun = isEveryScenarioRun && this->RunRenderingBenchmarkScenario( QString("Mixed textured primitives %1").arg(numberOfObjects[i]), SceneOfMixedTexturedPrimitives, numberOfObjects[i], 5, mixedResult, openGLDescription );
+      myResults.append( mixedResult );
+      isEveryScenarioRun = isEveryScenarioRun && this->RunRenderingBenchmarkScenario( QString("Deep hierarchy %1").arg(numberOfObjects[i]/4), SceneWithDeepHierarchy, numberOfObjects[i]/4, 5, hierarchyResult, openGLDescription );
+      myResults.append( hierarchyResult );
+   }
+
+   // Extruded profiles with thousands of points and several holes (how scene setup time grows with triangulating large profiles).
+   // For this scene the smoothness argument is the number of points in each profile.
+   const unsigned int numberOfProfilePoints[] = { 1000, 8000 };
+   for( int i=0;  i < 2;  i++ )
+   {
+      QSimRenderingBenchmarkResult extrudedResult;
+      isEveryScenarioRun = isEveryScenarioRun && this->RunRenderingBenchmarkScenario( QString("Extruded polygons %1 profile points").arg(numberOfProfilePoints[i]), SceneOfExtrudedPolygons, 25, numberOfProfilePoints[i], extrudedResult, openGLDescription );
+      myResults.append( extrudedResult );
+   }
+
+   return isEveryScenarioRun && this->WriteRenderingBenchmarkResultsToJsonFile( jsonFilename, openGLDescription );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimRenderingBenchmark::BuildSceneOfSpheres( QSimGLViewWidget& glViewWidget, const unsigned int numberOfSpheres, const int smoothness, QList<QSimSceneNode*>& sceneNodes )
+{
+   // Spheres on a cubic grid centered at the origin.
+   const int numberPerSide = (int)ceil( pow( (double)numberOfSpheres, 1.0/3.0 ) );
+   const qreal spacing = 1.5;
+   for( unsigned int i=0;  i < numberOfSpheres;  i++ )
+   {
+      QSimSceneNode* sphere = glViewWidget.AddSceneNodeGeometrySphere( glViewWidget.GetMostParentSceneNode(), false, 1.0, smoothness );
+      const int x = i % numberPerSide,  y = (i / numberPerSide) % numberPerSide,  z = i / (numberPerSide * numberPerSide);
+      sphere->SetPosition( spacing * QVector3D( x - 0.5*(numberPerSide-1), y - 0.5*(numberPerSide-1), z - 0.5*(numberPerSide-1) ) );
+      sceneNodes.append( sphere );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimRenderingBenchmark::BuildSceneOfMixedTexturedPrimitives( QSimGLViewWidget& glViewWidget, const unsigned int numberOfObjects, QList<QSimSceneNode*>& sceneNodes, QList<QSimTextureHandle>& textureHandles )
+{
+   // Count the built-in images (used as textures).
+   unsigned int numberOfImages = 0;
+   while( QImageViewerDialog::GetStaticImageFilename( numberOfImages ) != NULL ) ++numberOfImages;
+
+   const int numberPerSide = (int)ceil( sqrt( (double)numberOfObjects ) );
+   const qreal spacing = 2.0;
+   QGLSceneNode& parentSceneNode = glViewWidget.GetMostParentSceneNode();
+   QSimTextureManager& textureManager = glViewWidget.GetTextureManager();
+   for( unsigned int i=0;  i < numberOfObjects;  i++ )
+   {
+      QSimSceneNode* sceneNode = NULL;
+      switch( i % 6 )
+      {
+         case 0:  sceneNode = glViewWidget.AddSceneNodeGeometryRectangularBox( parentSceneNode, false, 1.0, 0.8, 0.6 );            break;
+         case 1:  sceneNode = glViewWidget.AddSceneNodeGeometryCylinder( parentSceneNode, false, 0.8, 1.0, true, true );          break;
+         case 2:  sceneNode = glViewWidget.AddSceneNodeGeometryCone( parentSceneNode, false, 0.2, 0.8, 1.0, true, true );         break;
+         case 3:  sceneNode = glViewWidget.AddSceneNodeGeometryEllipsoid( parentSceneNode, false, 1.0, 0.7, 0.5, 5 );             break;
+         case 4:  sceneNode = glViewWidget.AddSceneNodeGeometrySphere( parentSceneNode, false, 1.0, 5 );                          break;
+         default: sceneNode = glViewWidget.AddSceneNodeGeometryTetrahedron( parentSceneNode, false, QVector3D(0,0,0), QVector3D(1,0,0), QVector3D(0,1,0), QVector3D(0,0,1) );  break;
+      }
+      const int x = i % numberPerSide,  y = i / numberPerSide;
+      sceneNode->SetPosition( spacing * QVector3D( x - 0.5*(numberPerSide-1), y - 0.5*(numberPerSide-1), 0 ) );
+
+      // Every other object is textured (cycling through the images so many textures are in use).
+      if( numberOfImages > 0 && i % 2 == 0 )
+      {
+         const QSimTextureHandle textureHandle = textureManager.AcquireTexture( QString( QImageViewerDialog::GetStaticImageFilename( (i/2) % numberOfImages ) ) );
+         sceneNode->SetTextureHandle( textureHandle );
+         textureHandles.append( textureHandle );
+      }
+      sceneNodes.append( sceneNode );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimRenderingBenchmark::BuildSceneWithDeepHierarchy( QSimGLViewWidget& glViewWidget, const unsigned int depthOfHierarchy, QList<QSimSceneNode*>& sceneNodes )
+{
+   // Each box is a child of the previous box, offset and rotated relative to it (so the chain curls into a helix).
+   QGLSceneNode* parentSceneNode = &( glViewWidget.GetMostParentSceneNode() );
+   for( unsigned int i=0;  i < depthOfHierarchy;  i++ )
+   {
+      QSimSceneNode* box = glViewWidget.AddSceneNodeGeometryRectangularBox( *parentSceneNode, false, 0.8, 0.4, 0.4 );
+      box->SetRotationAngleInDegreesAndVector( 15.0, QVector3D(0,1,1) );
+      box->SetPosition( i == 0 ? QVector3D( 0, 0, 0 ) : QVector3D( 0.25, 0.0, 0.0 ) );
+      sceneNodes.append( box );
+      parentSceneNode = &( box->GetQGLSceneNode() );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimRenderingBenchmark::BuildSceneOfExtrudedPolygons( QSimGLViewWidget& glViewWidget, const unsigned int numberOfObjects, const unsigned int numberOfProfilePoints, QList<QSimSceneNode*>& sceneNodes )
+{
+   // Each object is triangulated again (as if every profile were different): a wavy disk with 8 round holes, swept along a bent path.
+   // Half the profile's points are on the outer boundary and half are on the holes.
+   const int numberOfHoles = 8;
+   const int numberOfOuterPoints = qMax( 3, (int)numberOfProfilePoints / 2 );
+   const int numberOfPointsPerHole = qMax( 3, (int)numberOfProfilePoints / (2 * numberOfHoles) );
+   QVector2DArray outerBoundary;
+   for( int i = 0;  i < numberOfOuterPoints;  i++ )
+   {
+      const qreal angle = 2 * M_PI * i / numberOfOuterPoints,  radius = 1.0 + 0.05 * sin( 24 * angle );
+      outerBoundary.append( radius * cos(angle), radius * sin(angle) );
+   }
+   QVector3DArray path;
+   path.append( 0, 0, 0 );
+   path.append( 0, 0, 0.5 );
+   path.append( 0, 0.3, 1.0 );
+
+   const int numberPerSide = (int)ceil( sqrt( (double)numberOfObjects ) );
+   const qreal spacing = 2.5;
+   for( unsigned int i=0;  i < numberOfObjects;  i++ )
+   {
+      QGLExtrudedPolygon extrudedPolygon( outerBoundary, path );
+      for( int h = 0;  h < numberOfHoles;  h++ )
+      {
+         const qreal angle = 2 * M_PI * h / numberOfHoles;
+         extrudedPolygon.AddHole( QGLExtrudedPolygon::CreateCircularLoop( 0.6 * QVector2D( cos(angle), sin(angle) ), 0.15, numberOfPointsPerHole ) );
+      }
+      QSimSceneNode* sceneNode = glViewWidget.AddSceneNodeGeometryExtrudedPolygon( glViewWidget.GetMostParentSceneNode(), false, extrudedPolygon );
+      if( sceneNode == NULL ) continue;
+      const int x = i % numberPerSide,  y = i / numberPerSide;
+      sceneNode->SetPosition( spacing * QVector3D( x - 0.5*(numberPerSide-1), y - 0.5*(numberPerSide-1), 0 ) );
+      sceneNodes.append( sceneNode );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimRenderingBenchmark::RunRenderingBenchmarkScenario( const QString& scenarioName, const QSimBenchmarkScene scene, const unsigned int numberOfObjects, const int smoothness, QSimRenderingBenchmarkResult& result, QString& openGLDescription )
+{
+   result.myScenarioName = scenarioName;
+   result.myNumberOfObjects = numberOfObjects;
+   result.myNumberOfDrawCallsInScene = result.myNumberOfTrianglesInScene = 0;
+   result.myFrameTimesInMilliseconds.clear();
+   result.myProcessMemoryInBytesBeforeScene = QSimRenderingBenchmark::GetProcessMemoryInBytes();
+
+   // Build the scene in a view widget that is never shown.
+   QSimGLViewWidget glViewWidget( NULL, false );
+   QList<QSimSceneNode*> sceneNodes;
+   QList<QSimTextureHandle> textureHandles;
+   QElapsedTimer timer;
+   timer.start();
+   glViewWidget.SetUseCompactVertexFormat( scene == SceneOfSpheresWithCompactVertices );
+   if(      scene == SceneOfSpheres || scene == SceneOfSpheresWithCompactVertices )  QSimRenderingBenchmark::BuildSceneOfSpheres( glViewWidget, numberOfObjects, smoothness, sceneNodes );
+   else if( scene == SceneOfMixedTexturedPrimitives )                               QSimRenderingBenchmark::BuildSceneOfMixedTexturedPrimitives( glViewWidget, numberOfObjects, sceneNodes, textureHandles );
+   else if( scene == SceneOfExtrudedPolygons )                                      QSimRenderingBenchmark::BuildSceneOfExtrudedPolygons( glViewWidget, numberOfObjects, smoothness, sceneNodes );
+   else                                                                             QSimRenderingBenchmark::BuildSceneWithDeepHierarchy( glViewWidget, numberOfObjects, sceneNodes );
+
+   // Textures are decoded on worker threads, so wait (processing the signals) until all are ready.
+   // A texture that cannot be decoded would make this scene a different benchmark, so the scenario fails.
+   QSimTextureManager& textureManager = glViewWidget.GetTextureManager();
+   for( int i=0;  i < textureHandles.count();  i++ )
+   {
+      if( textureHandles[i] == 0 ) return false;
+      while( !textureManager.IsTextureReady( textureHandles[i] ) && !textureManager.HasTextureDecodeFailed( textureHandles[i] ) ) QCoreApplication::processEvents( QEventLoop::AllEvents, 10 );
+      if( textureManager.HasTextureDecodeFailed( textureHandles[i] ) ) return false;
+   }
+   result.mySceneSetupTimeInMilliseconds = timer.elapsed();
+
+   // Frame the whole scene: the camera orbits the center of the objects' origins at a distance based on their extent.
+   QVector3D sceneCenter;
+   for( int i=0;  i < sceneNodes.count();  i++ ) sceneCenter += sceneNodes[i]->GetWorldMatrix().map( QVector3D(0,0,0) );
+   if( !sceneNodes.isEmpty() ) sceneCenter /= sceneNodes.count();
+   qreal sceneRadius = 1.0;
+   for( int i=0;  i < sceneNodes.count();  i++ )
+   {
+      sceneRadius = qMax( sceneRadius, (sceneNodes[i]->GetWorldMatrix().map( QVector3D(0,0,0) ) - sceneCenter).length() + 1.0 );
+      result.myNumberOfDrawCallsInScene += sceneNodes[i]->GetNumberOfDrawCalls();
+      result.myNumberOfTrianglesInScene += sceneNodes[i]->GetNumberOfTriangles();
+   }
+   QGLCamera& camera = *( glViewWidget.camera() );
+   const qreal cameraDistance = 2.5 * sceneRadius;
+   camera.setCenter( sceneCenter );
+   camera.setUpVector( QVector3D(0,1,0) );
+   camera.setNearPlane( 0.01 * cameraDistance );
+   camera.setFarPlane( 3.0 * cameraDistance );
+
+   QSimOffscreenRenderer& offscreenRenderer = glViewWidget.GetOffscreenRenderer();
+   if( !offscreenRenderer.IsOffscreenRendererValid() ) return false;
+   if( openGLDescription.isEmpty() ) openGLDescription = offscreenRenderer.GetOpenGLDescription();
+
+   // One frame that is not measured (uploads textures and other one-time work).
+   camera.setEye( sceneCenter + QVector3D( 0, 0, cameraDistance ) );
+   if( !offscreenRenderer.RenderSceneAndFinish( myImageSize ) ) return false;
+
+   // Scripted camera path: one full orbit around the scene while rising and falling 30 degrees (the same path every run).
+   result.myFrameTimesInMilliseconds.reserve( myNumberOfFramesPerScenario );
+   for( unsigned int frame=0;  frame < myNumberOfFramesPerScenario;  frame++ )
+   {
+      const qreal fraction = qreal(frame) / myNumberOfFramesPerScenario;
+      const qreal azimuth = 2 * M_PI * fraction;
+      const qreal elevation = (M_PI / 6) * sin( 2 * M_PI * fraction );
+      camera.setEye( sceneCenter + cameraDistance * QVector3D( sin(azimuth) * cos(elevation), sin(elevation), cos(azimuth) * cos(elevation) ) );
+
+      timer.restart();
+      if( !offscreenRenderer.RenderSceneAndFinish( myImageSize ) ) return false;
+#if QT_VERSION >= 0x040800
+      result.myFrameTimesInMilliseconds.append( 1.0E-6 * timer.nsecsElapsed() );
+#else
+      result.myFrameTimesInMilliseconds.append( timer.elapsed() );   // Qt 4.7 only has millisecond resolution.
+#endif
+   }
+
+   // Memory while the scene is alive (the scene is destroyed when glViewWidget goes out of scope).
+   result.myProcessMemoryInBytesWithScene = QSimRenderingBenchmark::GetProcessMemoryInBytes();
+   result.myTextureMemoryInBytes = textureManager.GetResidentTextureMemoryInBytes();
+   for( int i=0;  i < textureHandles.count();  i++ ) textureManager.ReleaseTexture( textureHandles[i] );
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+double  QSimRenderingBenchmark::GetPercentile( const QVector<double>& sortedValues, const double fraction )
+{
+   // Nearest-rank percentile.
+   if( sortedValues.isEmpty() ) return 0;
+   const int index = qBound( 0, (int)( fraction * (sortedValues.count() - 1) + 0.5 ), sortedValues.count() - 1 );
+   return sortedValues[index];
+}
+
+
+//------------------------------------------------------------------------------
+qint64  QSimRenderingBenchmark::GetProcessMemoryInBytes()
+{
+   // Resident memory (working set) of this process.
+#if defined(Q_OS_WIN)
+   PROCESS_MEMORY_COUNTERS memoryCounters;
+   if( GetProcessMemoryInfo( GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters) ) ) return (qint64)memoryCounters.WorkingSetSize;
+#elif defined(Q_OS_MAC)
+   task_basic_info_data_t taskInfo;
+   mach_msg_type_number_t taskInfoCount = TASK_BASIC_INFO_COUNT;
+   if( task_info( mach_task_self(), TASK_BASIC_INFO, (task_info_t)&taskInfo, &taskInfoCount ) == KERN_SUCCESS ) return (qint64)taskInfo.resident_size;
+#elif defined(Q_OS_UNIX)
+   QFile statmFile( "/proc/self/statm" );
+   if( statmFile.open( QFile::ReadOnly ) )
+   {
+      const QList<QByteArray> fields = statmFile.readAll().split( ' ' );
+      if( fields.count() > 1 ) return fields[1].toLongLong() * sysconf( _SC_PAGESIZE );
+   }
+#endif
+   return -1;
+}
+
+
+//------------------------------------------------------------------------------
+static QString  QuoteStringForJson( const QString& string )
+{
+   QString quotedString = string;
+   quotedString.replace( "\\", "\\\\" ).replace( "\"", "\\\"" ).replace( "\n", "\\n" );
+   return "\"" + quotedString + "\"";
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimRenderingBenchmark::WriteRenderingBenchmarkResultsToJsonFile( const QString& jsonFilename, const QString& openGLDescription ) const
+{
+   QFile file( jsonFilename );
+   if( !file.open( QFile::WriteOnly | QFile::Text | QFile::Truncate ) ) return false;
+   QTextStream stream( &file );
+
+   // Enough about the build and hardware to compare results across versions and computers.
+   stream << "{\n";
+   stream << "  \"date\": " << QuoteStringForJson( QDateTime::currentDateTime().toString( Qt::ISODate ) ) << ",\n";
+   stream << "  \"qtVersion\": " << QuoteStringForJson( qVersion() ) << ",\n";
+   stream << "  \"openGL\": " << QuoteStringForJson( openGLDescription ) << ",\n";
+   stream << "  \"numberOfCores\": " << QThread::idealThreadCount() << ",\n";
+   stream << "  \"imageWidth\": " << myImageSize.width() << ",\n";
+   stream << "  \"imageHeight\": " << myImageSize.height() << ",\n";
+   stream << "  \"scenarios\": [\n";
+   for( int i=0;  i < myResults.count();  i++ )
+   {
+      const QSimRenderingBenchmarkResult& result = myResults[i];
+      QVector<double> sortedFrameTimes = result.myFrameTimesInMilliseconds;
+      qSort( sortedFrameTimes );
+      double totalTimeInMilliseconds = 0;
+      for( int j=0;  j < sortedFrameTimes.count();  j++ ) totalTimeInMilliseconds += sortedFrameTimes[j];
+      const double framesPerSecond = totalTimeInMilliseconds > 0 ? 1000.0 * sortedFrameTimes.count() / totalTimeInMilliseconds : 0;
+
+      stream << "    {\n";
+      stream << "      \"name\": " << QuoteStringForJson( result.myScenarioName ) << ",\n";
+      stream << "      \"objects\": " << result.myNumberOfObjects << ",\n";
+      stream << "      \"drawCallsInScene\": " << result.myNumberOfDrawCallsInScene << ",\n";
+      stream << "      \"trianglesInScene\": " << result.myNumberOfTrianglesInScene << ",\n";
+      stream << "      \"sceneSetupMilliseconds\": " << result.mySceneSetupTimeInMilliseconds << ",\n";
+      stream << "      \"frames\": " << sortedFrameTimes.count() << ",\n";
+      stream << "      \"framesPerSecond\": " << framesPerSecond << ",\n";
+      stream << "      \"frameMilliseconds\": { \"min\": " << QSimRenderingBenchmark::GetPercentile( sortedFrameTimes, 0.0 )
+             << ", \"p50\": " << QSimRenderingBenchmark::GetPercentile( sortedFrameTimes, 0.50 )
+             << ", \"p90\": " << QSimRenderingBenchmark::GetPercentile( sortedFrameTimes, 0.90 )
+             << ", \"p99\": " << QSimRenderingBenchmark::GetPercentile( sortedFrameTimes, 0.99 )
+             << ", \"max\": " << QSimRenderingBenchmark::GetPercentile( sortedFrameTimes, 1.0 ) << " },\n";
+      stream << "      \"processMemoryBytesBeforeScene\": " << result.myProcessMemoryInBytesBeforeScene << ",\n";
+      stream << "      \"processMemoryBytesWithScene\": " << result.myProcessMemoryInBytesWithScene << ",\n";
+      stream << "      \"textureMemoryBytes\": " << result.myTextureMemoryInBytes << "\n";
+      stream << "    }" << (i + 1 < myResults.count() ? "," : "") << "\n";
+   }
+   stream << "  ]\n";
+   stream << "}\n";
+   stream.flush();
+   return file.error() == QFile::NoError;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
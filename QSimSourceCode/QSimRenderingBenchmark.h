@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+// File:     QSimRenderingBenchmark.h
+// Class:    QSimRenderingBenchmark
+// Parents:  None
+// Purpose:  Builds synthetic scenes, renders them offscreen along a scripted camera path, and writes the measurements as JSON.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMRENDERINGBENCHMARK_H__
+#define  QSIMRENDERINGBENCHMARK_H__
+#include <QtCore>
+#include <QtGui>
+#include "CppStandardHeaders.h"
+#include "QSimTextureManager.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Forward declarations
+class  QSimGLViewWidget;
+class  QSimSceneNode;
+
+
+//------------------------------------------------------------------------------
+// Measurements for one scene.
+struct QSimRenderingBenchmarkResult
+{
+   QString          myScenarioName;
+   unsigned int     myNumberOfObjects;
+   unsigned int     myNumberOfDrawCallsInScene;          // Totals for drawing every object at its finest detail (not what a frame
+   unsigned int     myNumberOfTrianglesInScene;          // drew after culling, level-of-detail selection, and cluster streaming).
+   double           mySceneSetupTimeInMilliseconds;
+   QVector<double>  myFrameTimesInMilliseconds;
+   qint64           myProcessMemoryInBytesBeforeScene;   // -1 if unknown on this platform.
+   qint64           myProcessMemoryInBytesWithScene;
+   qint64           myTextureMemoryInBytes;
+};
+
+
+//------------------------------------------------------------------------------
+class QSimRenderingBenchmark
+{
+public:
+   // Constructors and destructors.
+   QSimRenderingBenchmark( const QSize& imageSize = QSize(800,600), const unsigned int numberOfFramesPerScenario = 240 ) : myImageSize(imageSize), myNumberOfFramesPerScenario(numberOfFramesPerScenario)  {;}
+  ~QSimRenderingBenchmark()  {;}
+
+   // Run every scenario and write the results to jsonFilename.  Returns false if offscreen rendering or writing the file fails.
+   bool  RunAllRenderingBenchmarks( const QString& jsonFilename );
+
+private:
+   // Synthetic scenes (each is built in an empty view widget, and returns the objects it added).
+   enum QSimBenchmarkScene { SceneOfSpheres, SceneOfSpheresWithCompactVertices, SceneOfMixedTexturedPrimitives, SceneWithDeepHierarchy, SceneOfExtrudedPolygons };
+   static void  BuildSceneOfSpheres( QSimGLViewWidget& glViewWidget, const unsigned int numberOfSpheres, const int smoothness, QList<QSimSceneNode*>& sceneNodes );
+   static void  BuildSceneOfMixedTexturedPrimitives( QSimGLViewWidget& glViewWidget, const unsigned int numberOfObjects, QList<QSimSceneNode*>& sceneNodes, QList<QSimTextureHandle>& textureHandles );
+   static void  BuildSceneWithDeepHierarchy( QSimGLViewWidget& glViewWidget, const unsigned int depthOfHierarchy, QList<QSimSceneNode*>& sceneNodes );
+   static void  BuildSceneOfExtrudedPolygons( QSimGLViewWidget& glViewWidget, const unsigned int numberOfObjects, const unsigned int numberOfProfilePoints, QList<QSimSceneNode*>& sceneNodes );
+
+   // Build one scene, move the camera along its path while rendering, and record the measurements.
+   bool  RunRenderingBenchmarkScenario( const QString& scenarioName, const QSimBenchmarkScene scene, const unsigned int numberOfObjects, const int smoothness, QSimRenderingBenchmarkResult& result, QString& openGLDescription );
+
+   // Results as JSON (frame times are summarized as frames per second and percentiles).
+   bool  WriteRenderingBenchmarkResultsToJsonFile( const QString& jsonFilename, const QString& openGLDescription ) const;
+   static double  GetPercentile( const QVector<double>& sortedValues, const double fraction );
+   static qint64  GetProcessMemoryInBytes();
+
+   QSize         myImageSize;
+   unsigned int  myNumberOfFramesPerScenario;
+   QList<QSimRenderingBenchmarkResult>  myResults;
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMRENDERINGBENCHMARK_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,139 @@
+//-----------------------------------------------------------------------------
+// File:     QSimResourcePack.cpp
+// Class:    QSimResourcePack
+// Parents:  None
+// Purpose:  Memory-maps the program's images from an external resource pack and keeps decoded images in a bounded cache.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimResourcePack.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimResourcePack&  QSimResourcePack::GetQSimResourcePack()  { static QSimResourcePack resourcePack;  return resourcePack; }
+
+
+//------------------------------------------------------------------------------
+bool  QSimResourcePack::OpenResourcePack( const QString& resourcePackFilename )
+{
+   QMutexLocker locker( &myMutex );
+   this->CloseResourcePack();
+
+   // QResource uses the mapped data in place (it checks the pack's header), so nothing is copied or decoded here.
+   myResourcePackFile.setFileName( resourcePackFilename );
+   if( !myResourcePackFile.open( QIODevice::ReadOnly ) ) return false;
+   uchar* mappedResourcePack = myResourcePackFile.map( 0, myResourcePackFile.size() );
+   if( mappedResourcePack && QResource::registerResource( mappedResourcePack ) )
+   {
+      myMappedResourcePackOrNull = mappedResourcePack;
+      return true;
+   }
+   if( mappedResourcePack ) myResourcePackFile.unmap( mappedResourcePack );
+   myResourcePackFile.close();
+   return false;
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimResourcePack::OpenDefaultResourcePack()
+{
+#ifdef QSIM_RESOURCES_COMPILED_IN
+   return true;
+#else
+   const QString applicationDirectory = QCoreApplication::applicationDirPath();
+   const char* relativeDirectories[] = { ".", "..", "../Resources", NULL };
+   for( unsigned int i = 0;  relativeDirectories[i];  i++ )
+   {
+      const QString resourcePackFilename = QDir( applicationDirectory + "/" + relativeDirectories[i] ).absoluteFilePath( GetDefaultResourcePackFilename() );
+      if( QFile::exists( resourcePackFilename ) && this->OpenResourcePack( resourcePackFilename ) ) return true;
+   }
+   return false;
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimResourcePack::CloseResourcePack()
+{
+   // Decoded images do not refer to the mapped data, but images from a different pack must not be found in the cache.
+   myDecodedImages.clear();
+   if( myMappedResourcePackOrNull )
+   {
+      QResource::unregisterResource( myMappedResourcePackOrNull );
+      myResourcePackFile.unmap( myMappedResourcePackOrNull );
+      myMappedResourcePackOrNull = NULL;
+   }
+   myResourcePackFile.close();
+}
+
+
+//------------------------------------------------------------------------------
+QImage  QSimResourcePack::GetImage( const QString& imageFilename )
+{
+   {
+      QMutexLocker locker( &myMutex );
+      const QImage* decodedImage = myDecodedImages.object( imageFilename );
+      if( decodedImage ) { ++myNumberOfDecodedImageCacheHits;  return *decodedImage; }
+   }
+
+   // Decode without holding the lock (other threads may use the cache meanwhile).  The reader reads the mapped pack through QResource.
+   QImageReader imageReader( imageFilename );
+   const QImage image = imageReader.read();
+   if( image.isNull() ) return image;
+
+   // Images larger than the whole cache are returned but not kept.
+   QMutexLocker locker( &myMutex );
+   ++myNumberOfImagesDecoded;
+   myDecodedImages.insert( imageFilename, new QImage( image ), qMax( 1, image.byteCount() / 1024 ) );
+   return image;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimResourcePack::SetMaximumDecodedImageCacheSizeInKilobytes( const int maximumSizeInKilobytes )
+{
+   QMutexLocker locker( &myMutex );
+   myDecodedImages.setMaxCost( qMax( 0, maximumSizeInKilobytes ) );
+}
+
+
+//------------------------------------------------------------------------------
+int  QSimResourcePack::GetMaximumDecodedImageCacheSizeInKilobytes() const
+{
+   QMutexLocker locker( &myMutex );
+   return myDecodedImages.maxCost();
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
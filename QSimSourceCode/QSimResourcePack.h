@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+// File:     QSimResourcePack.h
+// Class:    QSimResourcePack
+// Parents:  None
+// Purpose:  Memory-maps the program's images from an external resource pack and keeps decoded images in a bounded cache.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMRESOURCEPACK_H__
+#define  QSIMRESOURCEPACK_H__
+#include <QtCore>
+#include <QtGui>
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+class QSimResourcePack
+{
+public:
+   // There is one resource pack for the program (it may be used from any thread).
+   static QSimResourcePack&  GetQSimResourcePack();
+
+   // A resource pack is QSimResourceCollectionFile.qrc compiled by Qt's  rcc -binary  (the build makes QSimResources.rcc).
+   // The file is memory-mapped (not read) and registered, so its images have the same ":/..." paths they had when compiled into the program,
+   // and the operating system only reads the pages of images that are used.  Returns false if the file cannot be mapped or is not a resource pack.
+   bool  OpenResourcePack( const QString& resourcePackFilename );
+
+   // Looks for QSimResources.rcc next to the executable, in its parent folder (for debug/release build folders), and in a Macintosh bundle's Resources.
+   // Builds that compile the images into the program (QSIM_RESOURCES_COMPILED_IN, e.g., Visual Studio projects) return true without a pack.
+   bool  OpenDefaultResourcePack();
+   static const char*  GetDefaultResourcePackFilename()  { return "QSimResources.rcc"; }
+
+   bool       IsResourcePackOpen() const             { return myMappedResourcePackOrNull != NULL; }
+   QString    GetResourcePackFilename() const        { return myResourcePackFile.fileName(); }
+   QDateTime  GetResourcePackLastModified() const    { return QFileInfo( myResourcePackFile ).lastModified(); }
+
+   // Images are decoded the first time they are requested, and kept in a cache that drops the least recently used images when
+   // decoded images exceed the maximum size (default 32 MB).  Returns a null image if the image cannot be read.
+   QImage   GetImage( const QString& imageFilename );
+   QPixmap  GetPixmap( const QString& imageFilename )  { return QPixmap::fromImage( this->GetImage( imageFilename ) ); }   // GUI thread only.
+   void     SetMaximumDecodedImageCacheSizeInKilobytes( const int maximumSizeInKilobytes );
+   int      GetMaximumDecodedImageCacheSizeInKilobytes() const;
+
+   // Statistics (helpful for profiling).
+   unsigned int  GetNumberOfImagesDecoded() const        { return myNumberOfImagesDecoded; }
+   unsigned int  GetNumberOfDecodedImageCacheHits() const { return myNumberOfDecodedImageCacheHits; }
+
+private:
+   // Constructors and destructors (use GetQSimResourcePack).
+   QSimResourcePack() : myMappedResourcePackOrNull(NULL), myDecodedImages(32*1024), myNumberOfImagesDecoded(0), myNumberOfDecodedImageCacheHits(0)  {;}
+  ~QSimResourcePack()  { this->CloseResourcePack(); }
+   void  CloseResourcePack();
+
+   // The mapped resource pack (registered with QResource while it is open).
+   QFile   myResourcePackFile;
+   uchar*  myMappedResourcePackOrNull;
+
+   // Decoded images (the cost of each is its size in kilobytes).
+   mutable QMutex          myMutex;
+   QCache<QString,QImage>  myDecodedImages;
+   unsigned int            myNumberOfImagesDecoded;
+   unsigned int            myNumberOfDecodedImageCacheHits;
+
+   // Disable copying.
+   QSimResourcePack( const QSimResourcePack& );
+   QSimResourcePack&  operator=( const QSimResourcePack& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMRESOURCEPACK_H__
+//--------------------------------------------------------------------------
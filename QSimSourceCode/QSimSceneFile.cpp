@@ -0,0 +1,524 @@
+//-----------------------------------------------------------------------------
+// File:     QSimSceneFile.cpp
+// Class:    QSimSceneFile
+// Parents:  QObject
+// Purpose:  Reads and writes a view widget's objects (hierarchy, transforms, materials, textures, and geometry) as a binary scene file.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <QtConcurrentRun>
+#include "QSimSceneFile.h"
+#include "QSimSceneNode.h"
+#include "QSimGLViewWidget.h"
+#include "QSimMaterialLibrary.h"
+#include "QSimClusteredMesh.h"
+#include "QSimCompactMesh.h"
+#include "QSimLevelOfDetailMesh.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneFile::AppendQSimSceneNodesParentsFirst( const QGLSceneNode& sceneNode, const int parentObjectIndex, QList<QSimSceneNode*>& sceneNodes, QList<int>& parentObjectIndices )
+{
+   // Descend through QGLSceneNodes, noting each object (QSimSceneNode) before the objects attached to it.
+   const QList<QGLSceneNode*> childSceneNodes = sceneNode.children();
+   for( QList<QGLSceneNode*>::const_iterator it = childSceneNodes.constBegin();  it != childSceneNodes.constEnd();  ++it )
+   {
+      QSimSceneNode* childQSimSceneNode = QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( **it );
+      if( childQSimSceneNode == NULL ) { QSimSceneFile::AppendQSimSceneNodesParentsFirst( **it, parentObjectIndex, sceneNodes, parentObjectIndices );  continue; }
+      sceneNodes.append( childQSimSceneNode );
+      parentObjectIndices.append( parentObjectIndex );
+      QSimSceneFile::AppendQSimSceneNodesParentsFirst( **it, sceneNodes.count() - 1, sceneNodes, parentObjectIndices );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+QMatrix4x4  QSimSceneFile::GetTransformFromParentObject( const QSimSceneNode& sceneNode ) const
+{
+   // The reader attaches the object to its parent object (or the top of the scene) through one QGLSceneNode with this transform.
+   QMatrix4x4 transformFromParentObject;
+   const QGLSceneNode* mostParentSceneNode = &( myGLViewWidget.GetMostParentSceneNode() );
+   for( const QGLSceneNode* ancestor = qobject_cast<const QGLSceneNode*>( sceneNode.GetQGLSceneNode().parent() );  ancestor != NULL && ancestor != mostParentSceneNode;  ancestor = qobject_cast<const QGLSceneNode*>( ancestor->parent() ) )
+   {
+      if( QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( *ancestor ) ) break;
+      transformFromParentObject = ancestor->transform() * transformFromParentObject;
+   }
+   return transformFromParentObject;
+}
+
+
+//------------------------------------------------------------------------------
+QMatrix4x4  QSimSceneFile::GetObjectTransformWithoutPosition( const QGLSceneNode& sceneNode )
+{
+   // QGLSceneNode::transform() is its position followed by its local transform and transforms (the position is restored from the object's properties).
+   if( sceneNode.localTransform().isIdentity() && sceneNode.transforms().isEmpty() ) return QMatrix4x4();
+   QMatrix4x4 transformWithoutPosition;
+   transformWithoutPosition.translate( -sceneNode.position() );
+   return transformWithoutPosition * sceneNode.transform();
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimSceneFile::EncodeMesh( const QGLSceneNode& sceneNode, const QMatrix4x4& transform, QByteArray& encodedMesh )
+{
+   // Only the vertices used by this scene node are written (QGLBuilder puts the geometry of several scene nodes in one QGeometryData).
+   const QGeometryData geometry = sceneNode.geometry();
+   const int start = sceneNode.start();
+   const int count = sceneNode.count();
+   const QGL::IndexArray indices = geometry.indices();
+   const bool isIndexed = indices.count() > 0;
+   if( count <= 0 || start < 0 || start + count > ( isIndexed ? indices.count() : geometry.count() ) ) return false;
+   int minimumIndex = start, maximumIndex = start + count - 1;
+   if( isIndexed )
+   {
+      minimumIndex = maximumIndex = indices.at( start );
+      for( int i = start + 1;  i < start + count;  i++ ) { minimumIndex = qMin( minimumIndex, (int)indices.at(i) );  maximumIndex = qMax( maximumIndex, (int)indices.at(i) ); }
+   }
+   if( maximumIndex >= geometry.count() ) return false;
+   const int numberOfVertices = maximumIndex - minimumIndex + 1;
+
+   // Vertices are in the object's coordinates (the transforms of scene nodes between this one and the object are applied now).
+   QVector3DArray positions = geometry.vertices().mid( minimumIndex, numberOfVertices );
+   const bool hasNormals = geometry.hasField( QGL::Normal );
+   const bool hasTextureCoordinates = geometry.hasField( QGL::TextureCoord0 );
+   QVector3DArray normals = hasNormals ? geometry.normals().mid( minimumIndex, numberOfVertices ) : QVector3DArray();
+   if( !transform.isIdentity() )
+   {
+      for( int i=0;  i < numberOfVertices;  i++ ) positions[i] = transform.map( positions.at(i) );
+      if( hasNormals ) for( int i=0;  i < numberOfVertices;  i++ ) normals[i] = transform.mapVector( normals.at(i) ).normalized();
+   }
+
+   // Arrays are written as they are in memory (QVector3D and QVector2D are 3 and 2 floats, which is also how Qt3D uploads them).
+   QDataStream stream( &encodedMesh, QIODevice::WriteOnly );
+   QSimSceneFile::SetSceneFileDataStreamProperties( stream );
+   stream << (quint8)sceneNode.drawingMode() << (quint8)( (hasNormals ? 1 : 0) | (hasTextureCoordinates ? 2 : 0) ) << (quint32)numberOfVertices << (quint32)count;
+   stream.writeRawData( reinterpret_cast<const char*>( positions.constData() ), numberOfVertices * sizeof(QVector3D) );
+   if( hasNormals ) stream.writeRawData( reinterpret_cast<const char*>( normals.constData() ), numberOfVertices * sizeof(QVector3D) );
+   if( hasTextureCoordinates )
+   {
+      const QVector2DArray textureCoordinates = geometry.texCoords( QGL::TextureCoord0 ).mid( minimumIndex, numberOfVertices );
+      stream.writeRawData( reinterpret_cast<const char*>( textureCoordinates.constData() ), numberOfVertices * sizeof(QVector2D) );
+   }
+   QVector<quint32> meshIndices( count );
+   for( int i=0;  i < count;  i++ ) meshIndices[i] = isIndexed ? indices.at( start + i ) - minimumIndex : i;
+   stream.writeRawData( reinterpret_cast<const char*>( meshIndices.constData() ), count * sizeof(quint32) );
+   return stream.status() == QDataStream::Ok;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneFile::EncodeGeometryOfSceneNode( const QGLSceneNode& sceneNode, const QMatrix4x4& transform, QList<QByteArray>& encodedMeshes )
+{
+   // Geometry of this QGLSceneNode and of descendant QGLSceneNodes, except those of other objects (which are written separately).
+   QByteArray encodedMesh;
+   if( sceneNode.count() > 0 && QSimSceneFile::EncodeMesh( sceneNode, transform, encodedMesh ) ) encodedMeshes.append( encodedMesh );
+
+   // A compact mesh is written in full precision (it is compacted again when read if the view uses the compact vertex format).
+   const QSimCompactMesh* compactMesh = qobject_cast<const QSimCompactMesh*>( &sceneNode );
+   if( compactMesh && compactMesh->GetNumberOfTriangles() > 0 )
+   {
+      QGLSceneNode decodedSceneNode;
+      decodedSceneNode.setGeometry( compactMesh->GetDecodedGeometry() );
+      decodedSceneNode.setStart( 0 );
+      decodedSceneNode.setCount( 3 * compactMesh->GetNumberOfTriangles() );
+      decodedSceneNode.setDrawingMode( QGL::Triangles );
+      QByteArray encodedCompactMesh;
+      if( QSimSceneFile::EncodeMesh( decodedSceneNode, transform, encodedCompactMesh ) ) encodedMeshes.append( encodedCompactMesh );
+   }
+
+   // Levels of detail are not written (they are generated again on request), only the finest level.
+   const QSimLevelOfDetailMesh* levelOfDetailMesh = qobject_cast<const QSimLevelOfDetailMesh*>( &sceneNode );
+   if( levelOfDetailMesh && levelOfDetailMesh->GetNumberOfLevelsOfDetail() > 0 )
+   {
+      const QGLSceneNode& finestSceneNode = levelOfDetailMesh->GetLevelOfDetailSceneNode(0);
+      QSimSceneFile::EncodeGeometryOfSceneNode( finestSceneNode, transform * finestSceneNode.transform(), encodedMeshes );
+   }
+
+   // A clustered mesh may not fit in memory, so only the name of its file is written.
+   const QSimClusteredMesh* clusteredMesh = qobject_cast<const QSimClusteredMesh*>( &sceneNode );
+   if( clusteredMesh && clusteredMesh->GetNumberOfClusters() > 0 )
+   {
+      QByteArray encodedReference;
+      QDataStream stream( &encodedReference, QIODevice::WriteOnly );
+      QSimSceneFile::SetSceneFileDataStreamProperties( stream );
+      stream << QSimSceneFile::GetClusteredMeshDrawingMode() << QFileInfo( clusteredMesh->GetClusteredMeshFilename() ).absoluteFilePath();
+      encodedMeshes.append( encodedReference );
+   }
+   const QList<QGLSceneNode*> childSceneNodes = sceneNode.children();
+   for( QList<QGLSceneNode*>::const_iterator it = childSceneNodes.constBegin();  it != childSceneNodes.constEnd();  ++it )
+      if( QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( **it ) == NULL ) QSimSceneFile::EncodeGeometryOfSceneNode( **it, transform * (*it)->transform(), encodedMeshes );
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimSceneFile::WriteSceneFile( const QString& filename, QWidget* parentWidgetOrNull )
+{
+   // Objects, parents first (so each object's parent already exists when the file is read).
+   QList<QSimSceneNode*> sceneNodes;
+   QList<int> parentObjectIndices;
+   QSimSceneFile::AppendQSimSceneNodesParentsFirst( myGLViewWidget.GetMostParentSceneNode(), -1, sceneNodes, parentObjectIndices );
+   myNumberOfObjects = 0;
+
+   // Tables of the materials and textures used by the objects (each is written once, however many objects share it).
+   QHash<QSimMaterialHandle, qint32>  materialIndices;
+   QList<QSimMaterialHandle>          materialHandles;
+   QHash<QSimTextureHandle, qint32>   textureIndices;
+   QList<QSimTextureHandle>           textureHandles;
+   for( int i=0;  i < sceneNodes.count();  i++ )
+   {
+      const QSimSceneNodeProperties properties = sceneNodes[i]->GetSceneNodeProperties();
+      if( !materialIndices.contains( properties.myMaterialStandardHandle ) )  { materialIndices.insert( properties.myMaterialStandardHandle,  materialHandles.count() );  materialHandles.append( properties.myMaterialStandardHandle ); }
+      if( !materialIndices.contains( properties.myMaterialHighlightHandle ) ) { materialIndices.insert( properties.myMaterialHighlightHandle, materialHandles.count() );  materialHandles.append( properties.myMaterialHighlightHandle ); }
+      if( properties.myTextureHandle && !textureIndices.contains( properties.myTextureHandle ) ) { textureIndices.insert( properties.myTextureHandle, textureHandles.count() );  textureHandles.append( properties.myTextureHandle ); }
+   }
+
+   // Write to a temporary file first, so an existing file is only replaced by a complete one.
+   const QString temporaryFilename = filename + ".part";
+   QFile file( temporaryFilename );
+   if( !file.open( QFile::WriteOnly | QFile::Truncate ) )
+   {
+      QMessageBox::warning( parentWidgetOrNull, tr("Save file"), tr("Cannot write file %1:\n%2.").arg(temporaryFilename).arg(file.errorString()), QMessageBox::Ok, QMessageBox::NoButton );
+      return false;
+   }
+   QDataStream stream( &file );
+   QSimSceneFile::SetSceneFileDataStreamProperties( stream );
+   stream << QSimSceneFile::GetSceneFileMagicNumber() << QSimSceneFile::GetSceneFileVersion() << (quint8)( Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? 1 : 0 );
+
+   // Materials.
+   const QSimMaterialLibrary& materialLibrary = QSimMaterialLibrary::GetQSimMaterialLibrary();
+   stream << (quint32)materialHandles.count();
+   for( int i=0;  i < materialHandles.count();  i++ )
+   {
+      const QSimMaterialType& material = materialLibrary.GetMaterial( materialHandles[i] );
+      stream << (quint32)material.ambientColor().rgba() << (quint32)material.diffuseColor().rgba() << (quint32)material.specularColor().rgba() << (quint32)material.emittedLight().rgba() << (float)material.shininess();
+   }
+
+   // Textures (relative filenames, so a folder with a scene file and its images may be moved).
+   const QDir sceneFileFolder = QFileInfo( filename ).absoluteDir();
+   const QSimTextureManager& textureManager = myGLViewWidget.GetTextureManager();
+   stream << (quint32)textureHandles.count();
+   for( int i=0;  i < textureHandles.count();  i++ )
+   {
+      const QString imageFilename = textureManager.GetTextureImageFilename( textureHandles[i] );
+      stream << ( imageFilename.startsWith(':') ? imageFilename : sceneFileFolder.relativeFilePath( imageFilename ) );
+   }
+
+   // Objects.
+   QProgressDialog progressDialog( tr("Saving %1...").arg( QFileInfo(filename).fileName() ), QString(), 0, sceneNodes.count(), parentWidgetOrNull );
+   progressDialog.setWindowModality( Qt::WindowModal );
+   progressDialog.setMinimumDuration( 500 );
+   stream << (quint32)sceneNodes.count();
+   for( int i=0;  i < sceneNodes.count() && stream.status() == QDataStream::Ok;  i++ )
+   {
+      if( i % 64 == 0 ) progressDialog.setValue( i );
+      QSimSceneNode& sceneNode = *sceneNodes[i];
+      const QSimSceneNodeProperties properties = sceneNode.GetSceneNodeProperties();
+      stream << sceneNode.objectName() << (qint32)parentObjectIndices[i] << (quint8)( sceneNode.IsObjectPickable() ? 1 : 0 );
+      stream << (float)properties.myPosition.x() << (float)properties.myPosition.y() << (float)properties.myPosition.z();
+      stream << (float)properties.myRotationVector.x() << (float)properties.myRotationVector.y() << (float)properties.myRotationVector.z();
+      stream << (float)properties.myRotationAngleInDegrees << (float)properties.myScale;
+      const QMatrix4x4 transformFromParentObject = this->GetTransformFromParentObject( sceneNode );
+      for( int row=0;  row < 4;  row++ ) for( int column=0;  column < 4;  column++ ) stream << (float)transformFromParentObject( row, column );
+      stream << materialIndices.value( properties.myMaterialStandardHandle ) << materialIndices.value( properties.myMaterialHighlightHandle );
+      stream << ( properties.myTextureHandle ? textureIndices.value( properties.myTextureHandle ) : (qint32)-1 );
+
+      // Geometry block, preceded by its size (so the reader can hand it to a worker thread and move on to the next object).
+      QList<QByteArray> encodedMeshes;
+      QSimSceneFile::EncodeGeometryOfSceneNode( sceneNode.GetQGLSceneNode(), QSimSceneFile::GetObjectTransformWithoutPosition( sceneNode.GetQGLSceneNode() ), encodedMeshes );
+      quint32 numberOfBytesInGeometryBlock = sizeof(quint32);
+      for( int j=0;  j < encodedMeshes.count();  j++ ) numberOfBytesInGeometryBlock += encodedMeshes[j].size();
+      stream << numberOfBytesInGeometryBlock << (quint32)encodedMeshes.count();
+      for( int j=0;  j < encodedMeshes.count();  j++ ) stream.writeRawData( encodedMeshes[j].constData(), encodedMeshes[j].size() );
+      ++myNumberOfObjects;
+   }
+   progressDialog.setValue( sceneNodes.count() );
+
+   // Replace the existing file (if any) with the complete temporary file.
+   const bool isFileWritten = stream.status() == QDataStream::Ok && file.error() == QFile::NoError && file.flush();
+   file.close();
+   if( !isFileWritten || !ReplaceFileWithTemporaryFile( temporaryFilename, filename ) )
+   {
+      QFile::remove( temporaryFilename );
+      QMessageBox::warning( parentWidgetOrNull, tr("Save file"), tr("Cannot write file %1.").arg(filename), QMessageBox::Ok, QMessageBox::NoButton );
+      return false;
+   }
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+QSimSceneFile::QSimSceneFileGeometry  QSimSceneFile::DecodeGeometryBlock( const char* geometryBlock, const int numberOfBytes )
+{
+   // Runs on a worker thread (the block is part of the memory-mapped file, which is only read).
+   QSimSceneFileGeometry decodedGeometry;
+   decodedGeometry.myIsValid = false;
+   const QByteArray block = QByteArray::fromRawData( geometryBlock, numberOfBytes );
+   QDataStream stream( block );
+   QSimSceneFile::SetSceneFileDataStreamProperties( stream );
+   quint32 numberOfMeshes = 0;
+   stream >> numberOfMeshes;
+   for( quint32 i=0;  i < numberOfMeshes && stream.status() == QDataStream::Ok;  i++ )
+   {
+      quint8 drawingMode = 0, optionalArrays = 0;
+      quint32 numberOfVertices = 0, numberOfIndices = 0;
+      stream >> drawingMode;
+      if( drawingMode == QSimSceneFile::GetClusteredMeshDrawingMode() )
+      {
+         QString clusteredMeshFilename;
+         stream >> clusteredMeshFilename;
+         decodedGeometry.myClusteredMeshFilenames.append( clusteredMeshFilename );
+         continue;
+      }
+      stream >> optionalArrays >> numberOfVertices >> numberOfIndices;
+
+      // Sizes are checked against the bytes remaining, so a damaged file cannot cause a huge allocation.
+      const qint64 numberOfBytesRemaining = numberOfBytes - stream.device()->pos();
+      const qint64 numberOfBytesNeeded = (qint64)numberOfVertices * ( sizeof(QVector3D) + ((optionalArrays & 1) ? sizeof(QVector3D) : 0) + ((optionalArrays & 2) ? sizeof(QVector2D) : 0) ) + (qint64)numberOfIndices * sizeof(quint32);
+      if( stream.status() != QDataStream::Ok || numberOfBytesNeeded > numberOfBytesRemaining ) return decodedGeometry;
+
+      QGeometryData geometry;
+      QVector3DArray positions;
+      positions.resize( numberOfVertices );
+      stream.readRawData( reinterpret_cast<char*>( positions.data() ), numberOfVertices * sizeof(QVector3D) );
+      geometry.appendVertexArray( positions );
+      if( optionalArrays & 1 )
+      {
+         QVector3DArray normals;
+         normals.resize( numberOfVertices );
+         stream.readRawData( reinterpret_cast<char*>( normals.data() ), numberOfVertices * sizeof(QVector3D) );
+         geometry.appendNormalArray( normals );
+      }
+      if( optionalArrays & 2 )
+      {
+         QVector2DArray textureCoordinates;
+         textureCoordinates.resize( numberOfVertices );
+         stream.readRawData( reinterpret_cast<char*>( textureCoordinates.data() ), numberOfVertices * sizeof(QVector2D) );
+         geometry.appendTexCoordArray( textureCoordinates );
+      }
+      QVector<quint32> meshIndices( numberOfIndices );
+      stream.readRawData( reinterpret_cast<char*>( meshIndices.data() ), numberOfIndices * sizeof(quint32) );
+      QGL::IndexArray indices;
+      indices.reserve( numberOfIndices );
+      for( quint32 j=0;  j < numberOfIndices;  j++ )
+      {
+         if( meshIndices[j] >= numberOfVertices ) return decodedGeometry;
+         indices.append( meshIndices[j] );
+      }
+      geometry.appendIndices( indices );
+      decodedGeometry.myMeshes.append( geometry );
+      decodedGeometry.myDrawingModes.append( drawingMode );
+   }
+   decodedGeometry.myIsValid = stream.status() == QDataStream::Ok;
+   return decodedGeometry;
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimSceneFile::ReadSceneFile( const QString& filename, QWidget* parentWidgetOrNull )
+{
+   myNumberOfObjects = 0;
+
+   // Map the file into memory (or if that is not possible, read all of it).  The mapping is released when file is destroyed.
+   QFile file( filename );
+   if( !file.open( QFile::ReadOnly ) )
+   {
+      QMessageBox::warning( parentWidgetOrNull, tr("Open file"), tr("Cannot read file %1:\n%2.").arg(filename).arg(file.errorString()), QMessageBox::Ok, QMessageBox::NoButton );
+      return false;
+   }
+   QByteArray fileContentsIfNotMapped;
+   const int numberOfBytesInFile = (int)qMin( file.size(), (qint64)INT_MAX );
+   const char* fileContents = reinterpret_cast<const char*>( file.map( 0, numberOfBytesInFile ) );
+   if( fileContents == NULL ) { fileContentsIfNotMapped = file.readAll();  fileContents = fileContentsIfNotMapped.constData(); }
+   const QByteArray mappedFile = QByteArray::fromRawData( fileContents, numberOfBytesInFile );
+   QDataStream stream( mappedFile );
+   QSimSceneFile::SetSceneFileDataStreamProperties( stream );
+
+   // Header.
+   quint32 magicNumber = 0, version = 0;
+   quint8  isLittleEndian = 0;
+   stream >> magicNumber >> version >> isLittleEndian;
+   QString errorMessage;
+   if( stream.status() != QDataStream::Ok || magicNumber != QSimSceneFile::GetSceneFileMagicNumber() ) errorMessage = tr("%1 is not a QSim scene file.").arg(filename);
+   else if( version > QSimSceneFile::GetSceneFileVersion() )                                       errorMessage = tr("%1 was saved by a newer version of QSim.").arg(filename);
+   else if( isLittleEndian != ( Q_BYTE_ORDER == Q_LITTLE_ENDIAN ? 1 : 0 ) )                          errorMessage = tr("%1 was saved on a computer with a different byte order.").arg(filename);
+   if( !errorMessage.isEmpty() )
+   {
+      QMessageBox::warning( parentWidgetOrNull, tr("Open file"), errorMessage, QMessageBox::Ok, QMessageBox::NoButton );
+      return false;
+   }
+
+   // Materials (each holds a reference while the file is read, so objects can share it).
+   QSimMaterialLibrary& materialLibrary = QSimMaterialLibrary::GetQSimMaterialLibrary();
+   QVector<QSimMaterialHandle> materialHandles;
+   quint32 numberOfMaterials = 0;
+   stream >> numberOfMaterials;
+   for( quint32 i=0;  i < numberOfMaterials && stream.status() == QDataStream::Ok;  i++ )
+   {
+      quint32 ambientColor = 0, diffuseColor = 0, specularColor = 0, emittedColor = 0;
+      float shininess = 0;
+      stream >> ambientColor >> diffuseColor >> specularColor >> emittedColor >> shininess;
+      QGLMaterial material;
+      material.setAmbientColor( QColor::fromRgba(ambientColor) );
+      material.setDiffuseColor( QColor::fromRgba(diffuseColor) );
+      material.setSpecularColor( QColor::fromRgba(specularColor) );
+      material.setEmittedLight( QColor::fromRgba(emittedColor) );
+      material.setShininess( shininess );
+      materialHandles.append( materialLibrary.AcquireMaterial( material ) );
+   }
+
+   // Textures (decoded on the texture manager's worker threads while the objects are read).
+   QSimTextureManager& textureManager = myGLViewWidget.GetTextureManager();
+   const QDir sceneFileFolder = QFileInfo( filename ).absoluteDir();
+   QVector<QSimTextureHandle> textureHandles;
+   quint32 numberOfTextures = 0;
+   stream >> numberOfTextures;
+   for( quint32 i=0;  i < numberOfTextures && stream.status() == QDataStream::Ok;  i++ )
+   {
+      QString imageFilename;
+      stream >> imageFilename;
+      textureHandles.append( textureManager.AcquireTexture( imageFilename.startsWith(':') ? imageFilename : sceneFileFolder.absoluteFilePath( imageFilename ) ) );
+   }
+
+   // The file's objects replace the current ones.
+   myGLViewWidget.RemoveAllSceneNodes();
+   quint32 numberOfObjects = 0;
+   stream >> numberOfObjects;
+   QProgressDialog progressDialog( tr("Opening %1...").arg( QFileInfo(filename).fileName() ), tr("Cancel"), 0, numberOfObjects, parentWidgetOrNull );
+   progressDialog.setWindowModality( Qt::WindowModal );
+   progressDialog.setMinimumDuration( 500 );
+
+   // Objects whose geometry is being decoded on worker threads (oldest first).
+   // Limit how many are in flight so reading faster than decoding does not hold every object's geometry in memory.
+   QList<QSimSceneFileObject>               objectsBeingDecoded;
+   QList< QFuture<QSimSceneFileGeometry> >  geometryBeingDecoded;
+   QVector<QGLSceneNode*>                   objectSceneNodes;
+   const int maxNumberOfObjectsBeingDecoded = 4 * qMax( 1, QThread::idealThreadCount() );
+   QStringList                              clusteredMeshErrorMessages;
+   bool isFileValid = stream.status() == QDataStream::Ok;
+   bool wasCanceled = false;
+   quint32 numberOfObjectsRead = 0;
+
+   while( true )
+   {
+      // Read objects (only their small fixed part - each geometry block is handed to a worker thread and skipped).
+      while( isFileValid && !wasCanceled && numberOfObjectsRead < numberOfObjects && geometryBeingDecoded.count() < maxNumberOfObjectsBeingDecoded )
+      {
+         QSimSceneFileObject object;
+         quint8 isObjectPickable = 0;
+         float x, y, z, rotationX, rotationY, rotationZ, rotationAngleInDegrees, scale;
+         quint32 numberOfBytesInGeometryBlock = 0;
+         stream >> object.myObjectName >> object.myParentObjectIndex >> isObjectPickable >> x >> y >> z >> rotationX >> rotationY >> rotationZ >> rotationAngleInDegrees >> scale;
+         if( version >= 3 ) for( int row=0;  row < 4;  row++ ) for( int column=0;  column < 4;  column++ ) { float value = 0;  stream >> value;  object.myTransformFromParentObject( row, column ) = value; }
+         stream >> object.myMaterialStandardIndex >> object.myMaterialHighlightIndex >> object.myTextureIndex >> numberOfBytesInGeometryBlock;
+         const qint64 geometryBlockPosition = stream.device()->pos();
+         isFileValid = stream.status() == QDataStream::Ok && geometryBlockPosition + numberOfBytesInGeometryBlock <= numberOfBytesInFile
+                    && object.myMaterialStandardIndex  >= 0  && object.myMaterialStandardIndex  < materialHandles.count()
+                    && object.myMaterialHighlightIndex >= 0  && object.myMaterialHighlightIndex < materialHandles.count()
+                    && object.myTextureIndex >= -1           && object.myTextureIndex < textureHandles.count();
+         if( !isFileValid ) break;
+         object.myIsObjectPickable = isObjectPickable != 0;
+         object.myProperties.myPosition = QVector3D( x, y, z );
+         object.myProperties.myRotationVector = QVector3D( rotationX, rotationY, rotationZ );
+         object.myProperties.myRotationAngleInDegrees = rotationAngleInDegrees;
+         object.myProperties.myScale = scale;
+         stream.skipRawData( numberOfBytesInGeometryBlock );
+         objectsBeingDecoded.append( object );
+         geometryBeingDecoded.append( QtConcurrent::run( QSimSceneFile::DecodeGeometryBlock, fileContents + geometryBlockPosition, (int)numberOfBytesInGeometryBlock ) );
+         ++numberOfObjectsRead;
+      }
+      if( geometryBeingDecoded.isEmpty() ) break;
+
+      // Add the oldest object (waiting for its geometry if necessary, while the others continue to be decoded).
+      const QSimSceneFileObject object = objectsBeingDecoded.takeFirst();
+      const QSimSceneFileGeometry geometry = geometryBeingDecoded.takeFirst().result();
+      if( !geometry.myIsValid ) { isFileValid = false;  objectSceneNodes.append( NULL );  continue; }
+
+      // The first mesh is drawn by the object's QGLSceneNode and the others by its children.
+      QGLSceneNode* sceneNode = new QGLSceneNode;
+      for( int i=0;  i < geometry.myMeshes.count();  i++ )
+      {
+         QGLSceneNode* meshSceneNode = ( i == 0 ) ? sceneNode : new QGLSceneNode( sceneNode );
+         meshSceneNode->setGeometry( geometry.myMeshes[i] );
+         meshSceneNode->setStart( 0 );
+         meshSceneNode->setCount( geometry.myMeshes[i].indexCount() );
+         meshSceneNode->setDrawingMode( (QGL::DrawingMode)geometry.myDrawingModes[i] );
+      }
+
+      // Clustered meshes are streamed from their own files (a missing file leaves the object without that mesh).
+      for( int i=0;  i < geometry.myClusteredMeshFilenames.count();  i++ )
+      {
+         QSimClusteredMesh* clusteredMesh = new QSimClusteredMesh( sceneNode );
+         QString errorMessage;
+         if( clusteredMesh->OpenClusteredMeshFile( geometry.myClusteredMeshFilenames[i], errorMessage ) ) QObject::connect( clusteredMesh, SIGNAL(ClusterIsReadySignal()), &myGLViewWidget, SLOT(updateGL()) );
+         else clusteredMeshErrorMessages.append( errorMessage );
+      }
+
+      // Attach the object to its parent object (which precedes it in the file) or to the top of the scene, through a QGLSceneNode with
+      // the transform of the QGLSceneNodes that were between them (if that is not the identity).
+      const qint32 parentObjectIndex = object.myParentObjectIndex;
+      const bool hasParentObject = parentObjectIndex >= 0 && parentObjectIndex < objectSceneNodes.count() && objectSceneNodes[parentObjectIndex] != NULL;
+      QGLSceneNode* parentSceneNode = hasParentObject ? objectSceneNodes[parentObjectIndex] : &( myGLViewWidget.GetMostParentSceneNode() );
+      if( !object.myTransformFromParentObject.isIdentity() )
+      {
+         QGLSceneNode* transformSceneNode = new QGLSceneNode;
+         QSimSceneNode::SetLocalTransformOfQGLSceneNode( *transformSceneNode, object.myTransformFromParentObject );
+         parentSceneNode->addNode( transformSceneNode );
+         parentSceneNode = transformSceneNode;
+      }
+      QSimSceneNode* qsimSceneNode = myGLViewWidget.AddSceneNodeFromQGLSceneNode( *parentSceneNode, *sceneNode, object.myIsObjectPickable, object.myObjectName.toLatin1().constData() );
+      QSimSceneNodeProperties properties = object.myProperties;
+      properties.myMaterialStandardHandle  = materialHandles[ object.myMaterialStandardIndex ];
+      properties.myMaterialHighlightHandle = materialHandles[ object.myMaterialHighlightIndex ];
+      properties.myTextureHandle = object.myTextureIndex >= 0 ? textureHandles[ object.myTextureIndex ] : 0;
+      qsimSceneNode->SetSceneNodeProperties( properties );
+      objectSceneNodes.append( sceneNode );
+      ++myNumberOfObjects;
+
+      // The progress dialog processes events (including its cancel button) each time its value is set.
+      if( myNumberOfObjects % 16 == 0 ) { progressDialog.setValue( myNumberOfObjects );  wasCanceled = wasCanceled || progressDialog.wasCanceled(); }
+   }
+   progressDialog.setValue( numberOfObjects );
+
+   // Objects now hold their own references to materials and textures.
+   for( int i=0;  i < materialHandles.count();  i++ ) materialLibrary.ReleaseMaterial( materialHandles[i] );
+   for( int i=0;  i < textureHandles.count();  i++ )  textureManager.ReleaseTexture( textureHandles[i] );
+   myGLViewWidget.updateGL();
+
+   if( !isFileValid ) QMessageBox::warning( parentWidgetOrNull, tr("Open file"), tr("File %1 is damaged (read %2 of %3 objects).").arg(filename).arg(myNumberOfObjects).arg(numberOfObjects), QMessageBox::Ok, QMessageBox::NoButton );
+   else if( !clusteredMeshErrorMessages.isEmpty() ) QMessageBox::warning( parentWidgetOrNull, tr("Open file"), clusteredMeshErrorMessages.join("\n"), QMessageBox::Ok, QMessageBox::NoButton );
+   return isFileValid && !wasCanceled;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -0,0 +1,151 @@
+//-----------------------------------------------------------------------------
+// File:     QSimSceneFile.h
+// Class:    QSimSceneFile
+// Parents:  QObject
+// Purpose:  Reads and writes a view widget's objects (hierarchy, transforms, materials, textures, and geometry) as a binary scene file.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMSCENEFILE_H__
+#define  QSIMSCENEFILE_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglscenenode.h"
+#include "qgeometrydata.h"
+#include "CppStandardHeaders.h"
+#include "QSimSceneNode.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Forward declarations
+class  QSimGLViewWidget;
+
+
+//------------------------------------------------------------------------------
+// File layout (version 1).  Scalars are little-endian, floats are single precision, and strings are QDataStream QStrings.
+// Geometry arrays are stored as they are in memory (so they are copied, not converted, when read), so the header records the byte order.
+//   Header:    magic number, version, byte order of geometry arrays (1 is little-endian).
+//   Materials: count, then for each: ambient, diffuse, specular, and emitted colors (QRgb) and shininess.
+//   Textures:  count, then for each: image filename (relative to the scene file's folder, unless it is a resource such as ":/...").
+//   Objects:   count, then for each (parents before children): name, index of parent object (or -1), whether pickable, position,
+//              rotation vector, rotation angle (degrees), scale, standard and highlight material indices, texture index (or -1),
+//              the transform of the QGLSceneNodes between the object and its parent object (version 3, 16 floats row by row),
+//              and the size in bytes of a geometry block that follows.
+//   Geometry:  number of meshes, then for each: drawing mode, which optional arrays are present (1 normals, 2 texture coordinates),
+//              number of vertices and indices, then positions, normals, texture coordinates, and 32-bit indices.
+//              A clustered mesh (version 2) is drawing mode 255 followed by its file's name (its triangles stay in that file).
+class QSimSceneFile : public QObject
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimSceneFile( QSimGLViewWidget& glViewWidget ) : QObject(NULL), myGLViewWidget(glViewWidget), myNumberOfObjects(0)  {;}
+  ~QSimSceneFile()  {;}
+
+   // Usual filename extension and the filter for file dialogs.
+   static QString  GetSceneFileSuffix()                { return "qsimscene"; }
+   static QString  GetSceneFileDialogNameFilter()      { return tr("QSim scene files (*.qsimscene)"); }
+
+   // Write every object in the view widget (geometry is written as drawn, so it is not rebuilt when read).
+   // The file is written under a temporary name and then replaced (see ReplaceFileWithTemporaryFile), so a failed write keeps an existing file.
+   // Shows a message box and returns false on error.
+   bool  WriteSceneFile( const QString& filename, QWidget* parentWidgetOrNull );
+
+   // Replace the view widget's objects with those in the file.  The file is memory-mapped and read from start to end while worker
+   // threads decode each object's geometry, and objects are added as soon as their geometry is ready (textures are decoded on the
+   // texture manager's worker threads).  Shows a progress dialog with a cancel button (objects read before canceling are kept).
+   // Shows a message box and returns false on error or if canceled.
+   bool  ReadSceneFile( const QString& filename, QWidget* parentWidgetOrNull );
+
+   // Number of objects written or added by the most recent call to WriteSceneFile or ReadSceneFile.
+   unsigned int  GetNumberOfObjects() const  { return myNumberOfObjects; }
+
+   // Objects in the order they are written (parents before children), with the index of each object's parent object (or -1).
+   static void  AppendQSimSceneNodesParentsFirst( const QGLSceneNode& sceneNode, const int parentObjectIndex, QList<QSimSceneNode*>& sceneNodes, QList<int>& parentObjectIndices );
+
+private:
+   // Format identification.
+   static quint32  GetSceneFileMagicNumber()  { return 0x5153494D; }  // "QSIM"
+   static quint32  GetSceneFileVersion()      { return 3; }
+   static quint8   GetClusteredMeshDrawingMode()  { return 0xFF; }
+
+   // Geometry of one object (decoded on a worker thread).  Each mesh is drawn with its drawing mode (e.g., QGL::Triangles).
+   struct QSimSceneFileGeometry
+   {
+      bool                  myIsValid;
+      QList<QGeometryData>  myMeshes;
+      QList<int>            myDrawingModes;
+      QStringList           myClusteredMeshFilenames;
+   };
+   static QSimSceneFileGeometry  DecodeGeometryBlock( const char* geometryBlock, const int numberOfBytes );
+
+   // Properties of an object whose geometry is being decoded (materials and textures are indices into the file's tables).
+   struct QSimSceneFileObject
+   {
+      QString                  myObjectName;
+      qint32                   myParentObjectIndex;
+      bool                     myIsObjectPickable;
+      QSimSceneNodeProperties  myProperties;
+      QMatrix4x4               myTransformFromParentObject;
+      qint32                   myMaterialStandardIndex, myMaterialHighlightIndex, myTextureIndex;
+   };
+
+   // An object's position, rotation, and scale are written as properties, and everything else that moves its vertices is kept too: the transforms of
+   // QGLSceneNodes between the object and its parent object are written as a matrix, and the rest of the object's own QGLSceneNode transform
+   // (e.g., a local transform from an importer) is applied to its vertices.
+   QMatrix4x4         GetTransformFromParentObject( const QSimSceneNode& sceneNode ) const;
+   static QMatrix4x4  GetObjectTransformWithoutPosition( const QGLSceneNode& sceneNode );
+
+   // Geometry of an object (its QGLSceneNode and descendants that are not other objects), in the object's coordinates.
+   static void  EncodeGeometryOfSceneNode( const QGLSceneNode& sceneNode, const QMatrix4x4& transform, QList<QByteArray>& encodedMeshes );
+   static bool  EncodeMesh( const QGLSceneNode& sceneNode, const QMatrix4x4& transform, QByteArray& encodedMesh );
+
+   // Set the usual stream properties for this format.
+   static void  SetSceneFileDataStreamProperties( QDataStream& stream )  { stream.setVersion( QDataStream::Qt_4_6 );  stream.setByteOrder( QDataStream::LittleEndian );  stream.setFloatingPointPrecision( QDataStream::SinglePrecision ); }
+
+   // The view widget whose objects are read or written.
+   QSimGLViewWidget&  myGLViewWidget;
+   unsigned int       myNumberOfObjects;
+
+   // Disable default constructors and copying.
+   QSimSceneFile();
+   QSimSceneFile( const QSimSceneFile& );
+   QSimSceneFile&  operator=( const QSimSceneFile& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMSCENEFILE_H__
+//--------------------------------------------------------------------------
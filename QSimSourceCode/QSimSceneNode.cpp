@@ -1,204 +1,533 @@
-//-----------------------------------------------------------------------------
-// File:     QSimSceneNode.cpp
-// Class:    QSimSceneNode
-// Parents:  QObject
-// Purpose:  QSimSceneNode and QSimGLViewWidget work together for painting/picking on-screen objects.
-/* ---------------------------------------------------------------------------- *
-* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
-* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
-* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
-* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
-*                                                                               *
-* To the extent possible under law, the author(s) and contributor(s) have       *
-* dedicated all copyright and related and neighboring rights to this software   *
-* to the public domain worldwide. This software is distributed without warranty.*
-*                                                                               *
-* Authors: Paul Mitiguy (2011)                                                  *
-* Contributors: Ayman Habib, Michael Sherman                                    *
-*                                                                               *
-* Permission is granted, free of charge, to any person obtaining a copy of this *
-* software and associated documentation files (the "Software"), to deal in the  *
-* Software without restriction, including without limitation the rights to use, *
-* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
-* the Software and to permit persons to whom the Software is furnished to do so.*
-*                                                                               *
-* Include this sentence, the above public domain and permission notices, and the*
-* following disclaimer in all copies or substantial portions of the Software.   *
-*                                                                               *
-* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
-* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
-* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
-* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
-* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
-* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
-* ----------------------------------------------------------------------------- */
-#include "qglpainter.h"
-#include "qglview.h"
-#include "QSimSceneNode.h"
-#include "QSimGLViewWidget.h"
-#include "QSimRigidBodyTabWidget.h"
-
-
-//------------------------------------------------------------------------------
-namespace QSim {
-
-
-//------------------------------------------------------------------------------
-//  Initialize Class static data
-unsigned long  QSimSceneNode::myNextUniqueID = 0;
-
-
-//------------------------------------------------------------------------------
-QSimSceneNode::QSimSceneNode( QGLSceneNode &sceneNode, QSimGLViewWidget& glViewWidget, const bool isObjectPickable, const char *objectNameOrNull ) : QObject(&sceneNode), myQGLSceneNode(sceneNode), mySceneNodeQSimGLViewWidget(glViewWidget)
-{
-   // Immediately set object to not pickable and then set other default properties.
-   this->InitializeQSimSceneNode();
-
-   // Name the object or assign the default name "Object".
-   this->setObjectName( objectNameOrNull != NULL ? objectNameOrNull : "Object" );
-
-   // This actually determines whether or not the object is pickable.
-   this->SetObjectPickable( isObjectPickable );
-}
-
-
-//------------------------------------------------------------------------------
-void  QSimSceneNode::DrawOpenGLForQSimSceneNode( QGLPainter& painter )
-{
-   // If hovering on the object, update the status bar.
-   if( this->GetHoverStatus() && this->IsObjectPickable()  )
-   {
-      QString messageToStatusBar;   this->GetObjectNameAndObjectIdInsideSquareBrackets( messageToStatusBar );
-      this->GetSceneNodeQSimGLViewWidget().WriteMessageToMainWindowStatusBarFromGLViewWidget( messageToStatusBar, 0 );
-   }
-
-   // Position the model at its designated position, scale, and orientation.
-   painter.modelViewMatrix().push();
-
-   // Possibly rotate, translate, or scale.
-   if( this->GetRotationAngleInDegrees() != 0.0 ) painter.modelViewMatrix().rotate( this->GetRotationAngleInDegrees(), this->GetRotationVector() );
-   if( this->GetPosition() != QVector3D(0,0,0) )  painter.modelViewMatrix().translate( this->GetPosition() );
-   if( this->GetScale() != 1.0 )                  painter.modelViewMatrix().scale( this->GetScale() );
-
-   // Apply the material and effect to the painter.
-   const QSimMaterialType& material = this->GetMaterialBasedOnHoverStatus();
-   const QColor diffuseColor = material.diffuseColor();
-   painter.setColor( diffuseColor );
-   painter.setFaceMaterial( QGL::AllFaces, &material );
-
-   // Apply the designated (or standard) abstract effect to the painter.
-   if( this->GetAbstractEffect() )                            painter.setUserEffect( myAbstractEffect );
-   else if( myRigidBodyTabWidget.GetTextureOrNullIfEmpty() )  painter.setStandardEffect( QGL::LitDecalTexture2D );
-   else                                                       painter.setStandardEffect( QGL::LitMaterial );
-
-   // Mark the object for object picking purposes.
-   const int prevObjectId = painter.objectPickId();
-   if( myObjectId != -1 ) painter.setObjectPickId( myObjectId );
-
-   // Draw the geometry.
-   myQGLSceneNode.draw( &painter );
-
-   // Turn off the user effect, if present.
-   if( this->GetAbstractEffect() || myRigidBodyTabWidget.GetTextureOrNullIfEmpty() )
-      painter.setStandardEffect( QGL::LitMaterial );
-
-   // Revert to the previous object identifier.
-   painter.setObjectPickId( prevObjectId );
-
-   // Restore the modelview matrix.
-   painter.modelViewMatrix().pop();
-}
-
-
-//------------------------------------------------------------------------------
-bool  QSimSceneNode::event( QEvent* event )
-{
-   // Convert the raw event into a signal representing the user's action.
-   if( event->type() == QEvent::MouseButtonPress )
-   {
-      QMouseEvent *mouseEvent = static_cast<QMouseEvent*>( event );
-      if( mouseEvent->button() == Qt::LeftButton )  emit mouseButtonPressed();
-   }
-   else if( event->type() == QEvent::MouseButtonRelease )
-   {
-      QMouseEvent *mouseEvent = static_cast<QMouseEvent*>( event );
-      if( mouseEvent->button() == Qt::LeftButton )
-      {
-         emit mouseButtonReleased();
-         // Determine if click is inside or outside an object.
-         // mouseEvent->x() is positive inside an object and negative outside.
-         if( mouseEvent->x() >= 0 )  emit mouseButtonClicked();
-      }
-   }
-   else if( event->type() == QEvent::MouseButtonDblClick )
-   {
-      emit mouseButtonDoubleClicked();
-   }
-   else if( event->type() == QEvent::Enter )
-   {
-      this->SetHoverStatus( true );
-      emit mouseHoverChanged();
-   }
-   else if( event->type() == QEvent::Leave )
-   {
-      // Maybe update status bar that no-longer hovering over object.
-      if( this->GetHoverStatus() && this->IsObjectPickable()  )
-         this->GetSceneNodeQSimGLViewWidget().WriteMessageToMainWindowStatusBarFromGLViewWidget( QString(""), 0 );
-
-      this->SetHoverStatus( false );
-      emit mouseHoverChanged();
-   }
-   return QObject::event( event );
-}
-
-
-//------------------------------------------------------------------------------
-void  QSimSceneNode::ObjectWasDoubleClicked()
-{
-   // Each scene node may be associated with a rigid body.
-   myRigidBodyTabWidget.ShowRigidBodyTabWidget( *this );
-
-   this->SetThisObjectWasSelectedAndDeselectOthers();
-}
-
-
-//------------------------------------------------------------------------------
-void  QSimSceneNode::SetThisObjectWasSelectedAndDeselectOthers()
-{
-   this->GetSceneNodeQSimGLViewWidget().DeselectAllPaintedObjectsInQSimGLViewWidget();
-   this->SetObjectIsSelected( true );
-}
-
-
-//------------------------------------------------------------------------------
-void  QSimSceneNode::SetSceneObjectPickableToFalseDeregisterDisconnect()
-{
-   // If already registered and connected, deregister this object (must also do this before object is destroyed) and disconnect signals.
-   if( this->IsObjectPickable() )
-   {
-      mySceneNodeQSimGLViewWidget.deregisterObject( this->GetObjectId() );
-      this->disconnect();
-      myObjectIsPickable = false;
-   }
-}
-
-
-//------------------------------------------------------------------------------
-void  QSimSceneNode::SetObjectPickable( const bool isObjectPickable )
-{
-   // If already registered and connected, deregister this object (must also do this before object is destroyed) and disconnect signals.
-   this->SetSceneObjectPickableToFalseDeregisterDisconnect();
-
-   // Register this object for object picking and connect signals to listen to mouse/other events.
-   if( (myObjectIsPickable = isObjectPickable) == true )
-   {
-      mySceneNodeQSimGLViewWidget.registerObject( this->GetObjectId(), this );
-      QObject::connect( this,  SIGNAL(mouseHoverChanged()),        &mySceneNodeQSimGLViewWidget, SIGNAL(SignalToUpdateGL()) );
-      QObject::connect( this,  SIGNAL(mouseButtonClicked()),       this,                         SLOT(ObjectWasSoleSelected())  );
-      QObject::connect( this,  SIGNAL(mouseButtonDoubleClicked()), this,                         SLOT(ObjectWasDoubleClicked())  );
-   }
-}
-
-
-//------------------------------------------------------------------------------
-}  // End of namespace QSim
+//-----------------------------------------------------------------------------
+// File:     QSimSceneNode.cpp
+// Class:    QSimSceneNode
+// Parents:  QObject
+// Purpose:  QSimSceneNode and QSimGLViewWidget work together for painting/picking on-screen objects.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "qglpainter.h"
+#include "qglview.h"
+#include "qbox3d.h"
+#include "QSimSceneNode.h"
+#include "QSimGLViewWidget.h"
+#include "QSimRigidBodyTabWidget.h"
+#include "QSimClusteredMesh.h"
+#include "QSimCompactMesh.h"
+#include "QSimLevelOfDetailMesh.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimSceneNode::QSimSceneNode( QGLSceneNode &sceneNode, QSimGLViewWidget& glViewWidget, const bool isObjectPickable, const char *objectNameOrNull ) : QObject(&sceneNode), mySceneStore(glViewWidget.GetSceneStore()), mySceneEntityId(mySceneStore.AddSceneEntity(*this)), mySceneNodeHandle(mySceneStore.GetSceneNodeHandle(mySceneEntityId)), myQGLSceneNode(sceneNode), mySceneNodeQSimGLViewWidget(glViewWidget)
+{
+   // The scene store added this object as not pickable, so set the other default properties.
+   this->InitializeQSimSceneNode();
+
+   // Name the object or assign the default name "Object".
+   this->setObjectName( objectNameOrNull != NULL ? objectNameOrNull : "Object" );
+
+   // This actually determines whether or not the object is pickable.
+   this->SetObjectPickable( isObjectPickable );
+
+   // Hide this object from an ancestor object's draw (its world matrix became dirty when the scene store added it).
+   this->HideIfAncestorIsQSimSceneNode();
+}
+
+
+//------------------------------------------------------------------------------
+QSimSceneNode::~QSimSceneNode()
+{
+   this->SetSceneObjectPickableToFalseDeregisterDisconnect();
+
+   // The selection set must not refer to this object.
+   this->SetObjectIsSelected( false );
+
+   // If the shared property dialog box is showing this object, it must no longer refer to it.
+   mySceneNodeQSimGLViewWidget.UnbindRigidBodyTabWidgetIfBoundToSceneNode( *this );
+
+   // Release this object's references to shared materials.
+   QSimMaterialLibrary& materialLibrary = QSimMaterialLibrary::GetQSimMaterialLibrary();
+   materialLibrary.ReleaseMaterial( this->GetMaterialStandardHandle() );
+   materialLibrary.ReleaseMaterial( this->GetMaterialHighlightHandle() );
+
+   // Release this object's reference to its texture.
+   mySceneNodeQSimGLViewWidget.GetTextureManager().ReleaseTexture( this->GetTextureHandle() );
+
+   // This object's entity ID may now be reused.
+   mySceneStore.RemoveSceneEntity( mySceneEntityId );
+}
+
+
+//------------------------------------------------------------------------------
+QSimBlockPool&  QSimSceneNode::GetSceneNodeBlockPoolForModification()
+{
+   // Chunks of 256 scene nodes (a chunk is allocated only when all blocks in earlier chunks are in use).
+   static QSimBlockPool sceneNodeBlockPool( sizeof(QSimSceneNode), 256 );
+   return sceneNodeBlockPool;
+}
+
+
+//------------------------------------------------------------------------------
+void*  QSimSceneNode::operator new( size_t sizeInBytes )
+{
+   // A class derived from QSimSceneNode may be larger than a block, so it is allocated on the heap.
+   if( sizeInBytes != sizeof(QSimSceneNode) ) return ::operator new( sizeInBytes );
+   return QSimSceneNode::GetSceneNodeBlockPoolForModification().AllocateBlock();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::operator delete( void* sceneNode, size_t sizeInBytes )
+{
+   if( sizeInBytes != sizeof(QSimSceneNode) ) ::operator delete( sceneNode );
+   else QSimSceneNode::GetSceneNodeBlockPoolForModification().FreeBlock( sceneNode );
+}
+
+
+//------------------------------------------------------------------------------
+QSimSceneNodeProperties  QSimSceneNode::GetSceneNodeProperties() const
+{
+   QSimSceneNodeProperties properties;
+   properties.myPosition = this->GetPosition();
+   properties.myRotationVector = this->GetRotationVector();
+   properties.myRotationAngleInDegrees = this->GetRotationAngleInDegrees();
+   properties.myScale = this->GetScale();
+   properties.myMaterialStandardHandle = this->GetMaterialStandardHandle();
+   properties.myMaterialHighlightHandle = this->GetMaterialHighlightHandle();
+   properties.myTextureHandle = this->GetTextureHandle();
+   return properties;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetSceneNodeProperties( const QSimSceneNodeProperties& properties )
+{
+   // Material and texture handles are acquired for this object (the caller keeps its own references, if any).
+   this->SetPosition( properties.myPosition );
+   this->SetRotationAngleInDegreesAndVector( properties.myRotationAngleInDegrees, properties.myRotationVector );
+   this->SetScale( properties.myScale );
+   this->SetMaterialStandardHandle(  properties.myMaterialStandardHandle );
+   this->SetMaterialHighlightHandle( properties.myMaterialHighlightHandle );
+   this->SetTextureHandle( properties.myTextureHandle );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::ReplaceMaterialHandle( QSimMaterialHandle& handleToReplace, const QSimMaterialHandle newMaterialHandle )
+{
+   // Acquire the new material before releasing the old one (they may be the same material).
+   // If the library was full, the scene node keeps its current material.
+   if( newMaterialHandle == QSimMaterialLibrary::GetInvalidMaterialHandle() ) return;
+   QSimMaterialLibrary& materialLibrary = QSimMaterialLibrary::GetQSimMaterialLibrary();
+   materialLibrary.AcquireMaterial( newMaterialHandle );
+   materialLibrary.ReleaseMaterial( handleToReplace );
+   handleToReplace = newMaterialHandle;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetTextureHandle( const QSimTextureHandle newTextureHandle )
+{
+   // Acquire the new texture before releasing the old one (they may be the same texture).
+   QSimTextureManager& textureManager = mySceneNodeQSimGLViewWidget.GetTextureManager();
+   textureManager.AcquireTexture( newTextureHandle );
+   textureManager.ReleaseTexture( this->GetTextureHandle() );
+   mySceneStore.SetTextureHandle( mySceneEntityId, newTextureHandle );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetMaterialStandard( const QGLMaterial& newMaterial )
+{
+   // Find (or add) a shared material with these properties.
+   QSimMaterialLibrary& materialLibrary = QSimMaterialLibrary::GetQSimMaterialLibrary();
+   const QSimMaterialHandle newMaterialHandle = materialLibrary.AcquireMaterial( newMaterial );
+   this->SetMaterialStandardHandle( newMaterialHandle );
+   materialLibrary.ReleaseMaterial( newMaterialHandle );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetMaterialHighlight( const QGLMaterial& newMaterial )
+{
+   // Find (or add) a shared material with these properties.
+   QSimMaterialLibrary& materialLibrary = QSimMaterialLibrary::GetQSimMaterialLibrary();
+   const QSimMaterialHandle newMaterialHandle = materialLibrary.AcquireMaterial( newMaterial );
+   this->SetMaterialHighlightHandle( newMaterialHandle );
+   materialLibrary.ReleaseMaterial( newMaterialHandle );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::UpdateModelMatrix() const
+{
+   // Possibly rotate, translate, or scale (same order as the painter's model-view matrix is modified).
+   QMatrix4x4 modelMatrix;
+   if( this->GetRotationAngleInDegrees() != 0.0 ) modelMatrix.rotate( this->GetRotationAngleInDegrees(), this->GetRotationVector() );
+   if( this->GetPosition() != QVector3D(0,0,0) )  modelMatrix.translate( this->GetPosition() );
+   if( this->GetScale() != 1.0 )                  modelMatrix.scale( this->GetScale() );
+   mySceneStore.SetModelMatrix( mySceneEntityId, modelMatrix );
+   this->SetSceneEntityFlag( QSimSceneStore::EntityModelMatrixIsDirty, false );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::UpdateWorldMatrix() const
+{
+   // Accumulate the transforms of ancestor QGLSceneNodes (applied when they are drawn) up to the nearest ancestor QSimSceneNode,
+   // whose world matrix is itself cached (so a deep chain of bodies is not walked to the root each time).
+   QMatrix4x4 parentWorldMatrix;
+   for( const QGLSceneNode* ancestor = qobject_cast<const QGLSceneNode*>( myQGLSceneNode.parent() );  ancestor != NULL;  ancestor = qobject_cast<const QGLSceneNode*>( ancestor->parent() ) )
+   {
+      parentWorldMatrix = ancestor->transform() * parentWorldMatrix;
+      const QSimSceneNode* ancestorQSimSceneNode = QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( *ancestor );
+      if( ancestorQSimSceneNode ) { parentWorldMatrix = ancestorQSimSceneNode->GetWorldMatrix() * parentWorldMatrix;  break; }
+   }
+   mySceneStore.SetWorldMatrix( mySceneEntityId, parentWorldMatrix * this->GetModelMatrix() );
+   this->SetSceneEntityFlag( QSimSceneStore::EntityWorldMatrixIsDirty, false );
+}
+
+
+//------------------------------------------------------------------------------
+static void  UniteBoundingBoxOfGeometryInSceneNode( const QGLSceneNode& sceneNode, const QMatrix4x4& parentTransform, QBox3D& boundingBox )
+{
+   // Geometry of this QGLSceneNode (drawn with its own transform) and of descendant QGLSceneNodes, except those of other objects (which have their own bounds).
+   // Clustered, compact, and level-of-detail meshes have no QGeometryData, but know their bounds.
+   const QMatrix4x4 transform = parentTransform * sceneNode.transform();
+   if( sceneNode.count() > 0 ) boundingBox.unite( sceneNode.geometry().boundingBox().transformed( transform ) );
+   const QSimClusteredMesh* clusteredMesh = qobject_cast<const QSimClusteredMesh*>( &sceneNode );
+   if( clusteredMesh && clusteredMesh->GetNumberOfClusters() > 0 ) boundingBox.unite( clusteredMesh->GetBoundingBox().transformed( transform ) );
+   const QSimCompactMesh* compactMesh = qobject_cast<const QSimCompactMesh*>( &sceneNode );
+   if( compactMesh && compactMesh->GetNumberOfTriangles() > 0 ) boundingBox.unite( compactMesh->GetBoundingBox().transformed( transform ) );
+   const QSimLevelOfDetailMesh* levelOfDetailMesh = qobject_cast<const QSimLevelOfDetailMesh*>( &sceneNode );
+   if( levelOfDetailMesh && levelOfDetailMesh->GetBoundingBox().isFinite() ) boundingBox.unite( levelOfDetailMesh->GetBoundingBox().transformed( transform ) );
+   const QList<QGLSceneNode*> childSceneNodes = sceneNode.children();
+   for( QList<QGLSceneNode*>::const_iterator it = childSceneNodes.constBegin();  it != childSceneNodes.constEnd();  ++it )
+      if( QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( **it ) == NULL ) UniteBoundingBoxOfGeometryInSceneNode( **it, transform, boundingBox );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::UpdateLocalBoundingSphere() const
+{
+   // The geometry's bounding box (a sphere around it is quick to test against the view frustum).
+   // Objects with no finite bounds get a negative radius so they are never culled.
+   QBox3D boundingBox;
+   UniteBoundingBoxOfGeometryInSceneNode( myQGLSceneNode, QMatrix4x4(), boundingBox );
+   if( boundingBox.isFinite() ) mySceneStore.SetLocalBoundingSphere( mySceneEntityId, QVector4D( boundingBox.center(), 0.5 * boundingBox.size().length() ) );
+   else                         mySceneStore.SetLocalBoundingSphere( mySceneEntityId, QVector4D( 0, 0, 0, -1 ) );
+   this->SetSceneEntityFlag( QSimSceneStore::EntityBoundsAreDirty, false );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetWorldMatrixIsDirty()
+{
+   // If the world matrix is already dirty, so are the world matrices of all descendants (nothing more to do).
+   if( this->GetSceneEntityFlag( QSimSceneStore::EntityWorldMatrixIsDirty ) ) return;
+   this->SetSceneEntityFlag( QSimSceneStore::EntityWorldMatrixIsDirty, true );
+   QSimSceneNode::SetWorldMatrixIsDirtyForDescendantsOf( myQGLSceneNode );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetWorldMatrixIsDirtyForDescendantsOf( const QGLSceneNode& sceneNode )
+{
+   // Descend through QGLSceneNodes until reaching a QSimSceneNode (which takes care of its own descendants).
+   const QList<QGLSceneNode*> childSceneNodes = sceneNode.children();
+   for( QList<QGLSceneNode*>::const_iterator it = childSceneNodes.constBegin();  it != childSceneNodes.constEnd();  ++it )
+   {
+      QSimSceneNode* childQSimSceneNode = QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( **it );
+      if( childQSimSceneNode ) childQSimSceneNode->SetWorldMatrixIsDirty();
+      else                     QSimSceneNode::SetWorldMatrixIsDirtyForDescendantsOf( **it );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetTransformOfQGLSceneNodeIsDirty( const QGLSceneNode& sceneNode )
+{
+   // An object's own QGLSceneNode transform is applied to its geometry (so its bounds change) and to the objects below it.
+   QSimSceneNode* qSimSceneNode = QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( sceneNode );
+   if( qSimSceneNode == NULL ) { QSimSceneNode::SetWorldMatrixIsDirtyForDescendantsOf( sceneNode );  return; }
+   qSimSceneNode->SetSceneEntityFlag( QSimSceneStore::EntityBoundsAreDirty, true );
+   qSimSceneNode->SetWorldMatrixIsDirty();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::CalculateNumberOfDrawCallsAndTriangles() const
+{
+   // Each QGLSceneNode with indices is one draw call (a set avoids counting a node twice, as allChildren() may list it twice).
+   QSet<QGLSceneNode*> sceneNodes = myQGLSceneNode.allChildren().toSet();
+   sceneNodes.insert( &myQGLSceneNode );
+   int numberOfDrawCalls = 0,  numberOfTriangles = 0;
+   for( QSet<QGLSceneNode*>::const_iterator it = sceneNodes.constBegin();  it != sceneNodes.constEnd();  ++it )
+   {
+      // A clustered mesh is counted as if all its clusters are drawn (one draw call each), a compact mesh is one draw call,
+      // and a level-of-detail mesh is counted as its finest level (its levels are not child QGLSceneNodes, so are not in the set).
+      const QGLSceneNode& sceneNode = **it;
+      const QSimClusteredMesh* clusteredMesh = qobject_cast<const QSimClusteredMesh*>( &sceneNode );
+      if( clusteredMesh ) { numberOfDrawCalls += clusteredMesh->GetNumberOfClusters();  numberOfTriangles += (int)clusteredMesh->GetNumberOfTriangles(); }
+      const QSimCompactMesh* compactMesh = qobject_cast<const QSimCompactMesh*>( &sceneNode );
+      if( compactMesh && compactMesh->GetNumberOfTriangles() > 0 ) { ++numberOfDrawCalls;  numberOfTriangles += compactMesh->GetNumberOfTriangles(); }
+      const QSimLevelOfDetailMesh* levelOfDetailMesh = qobject_cast<const QSimLevelOfDetailMesh*>( &sceneNode );
+      if( levelOfDetailMesh && levelOfDetailMesh->GetNumberOfLevelsOfDetail() > 0 ) { ++numberOfDrawCalls;  numberOfTriangles += levelOfDetailMesh->GetNumberOfTrianglesOfLevel(0); }
+      if( sceneNode.count() <= 0 ) continue;
+      ++numberOfDrawCalls;
+      if( sceneNode.drawingMode() == QGL::Triangles ) numberOfTriangles += sceneNode.count() / 3;
+   }
+   mySceneStore.SetNumberOfDrawCallsAndTriangles( mySceneEntityId, numberOfDrawCalls, numberOfTriangles );
+}
+
+
+//------------------------------------------------------------------------------
+QSimSceneNode*  QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( const QGLSceneNode& sceneNode )
+{
+   // A QSimSceneNode is a QObject child of its QGLSceneNode (QGLSceneNode::children() only lists child QGLSceneNodes).
+   const QObjectList& childObjects = static_cast<const QObject&>( sceneNode ).children();
+   for( QObjectList::const_iterator it = childObjects.constBegin();  it != childObjects.constEnd();  ++it )
+   {
+      QSimSceneNode* qSimSceneNode = qobject_cast<QSimSceneNode*>( *it );
+      if( qSimSceneNode ) return qSimSceneNode;
+   }
+   return NULL;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::HideIfAncestorIsQSimSceneNode()
+{
+   // This object does not listen to updated() from its own or ancestor QGLSceneNodes: Qt/3D forwards updated() from every child to its parent,
+   // so each change anywhere below the most-parent scene node would make every object's world matrix dirty.  Instead, this object's setters
+   // mark only its own subtree dirty, and other transforms are changed through SetLocalTransformOfQGLSceneNode or SetPositionOfQGLSceneNode.
+   bool hasAncestorQSimSceneNode = false;
+   for( QGLSceneNode* ancestor = qobject_cast<QGLSceneNode*>( myQGLSceneNode.parent() );  ancestor != NULL && !hasAncestorQSimSceneNode;  ancestor = qobject_cast<QGLSceneNode*>( ancestor->parent() ) )
+      hasAncestorQSimSceneNode = QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( *ancestor ) != NULL;
+   this->SetSceneEntityFlag( QSimSceneStore::EntityHasAncestorQSimSceneNode, hasAncestorQSimSceneNode );
+
+   // Hide this object from its ancestor's QGLSceneNode::draw (otherwise it is drawn twice).
+   if( hasAncestorQSimSceneNode )
+   {
+      myQGLSceneNode.blockSignals( true );
+      myQGLSceneNode.setOptions( myQGLSceneNode.options() | QGLSceneNode::HideNode );
+      myQGLSceneNode.blockSignals( false );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::DrawOpenGLForQSimSceneNode( QGLPainter& painter )
+{
+   // Apply the material and effect to the painter.
+   const QSimMaterialType& material = this->GetMaterialBasedOnHoverStatus();
+   const QColor diffuseColor = material.diffuseColor();
+   painter.setColor( diffuseColor );
+   painter.setFaceMaterial( QGL::AllFaces, &material );
+
+   // Apply the designated (or standard) abstract effect to the painter.
+   // An object whose texture is still being decoded (on a worker thread) is drawn without its texture.
+   QSimTextureManager& textureManager = mySceneNodeQSimGLViewWidget.GetTextureManager();
+   const bool isTextureReady = textureManager.IsTextureReady( this->GetTextureHandle() );
+   if( this->GetAbstractEffect() )  painter.setUserEffect( this->GetAbstractEffect() );
+   else if( isTextureReady )        painter.setStandardEffect( QGL::LitDecalTexture2D );
+   else                             painter.setStandardEffect( QGL::LitMaterial );
+   if( isTextureReady ) textureManager.BindTexture( this->GetTextureHandle() );
+
+   // Draw the geometry.
+   this->DrawOpenGLGeometryForQSimSceneNode( painter );
+
+   // Turn off the user effect, if present.
+   if( this->GetAbstractEffect() || isTextureReady )
+      painter.setStandardEffect( QGL::LitMaterial );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::DrawOpenGLGeometryForQSimSceneNode( QGLPainter& painter )
+{
+   // If hovering on the object, update the status bar.
+   if( this->GetHoverStatus() && this->IsObjectPickable()  )
+   {
+      QString messageToStatusBar;   this->GetObjectNameAndObjectIdInsideSquareBrackets( messageToStatusBar );
+      this->GetSceneNodeQSimGLViewWidget().WriteMessageToMainWindowStatusBarFromGLViewWidget( messageToStatusBar, 0 );
+   }
+
+   // Position the model at its designated position, scale, and orientation (the cached world matrix includes its ancestors).
+   painter.modelViewMatrix().push();
+   const QMatrix4x4& worldMatrix = this->GetWorldMatrix();
+   if( !worldMatrix.isIdentity() ) painter.modelViewMatrix() *= worldMatrix;
+
+   // Mark the object for object picking purposes (and record which object the picking buffer has for this picking ID).
+   const int prevObjectId = painter.objectPickId();
+   painter.setObjectPickId( this->GetObjectId() );
+   if( painter.isPicking() ) mySceneStore.SetSceneNodeHandleInPickBuffer( mySceneEntityId );
+
+   // Draw the geometry (an object with an ancestor object is normally hidden - see HideIfAncestorIsQSimSceneNode).
+   // Signals are blocked so showing and hiding does not look like a change to the QGLSceneNode.
+   if( this->HasAncestorQSimSceneNode() )
+   {
+      myQGLSceneNode.blockSignals( true );
+      myQGLSceneNode.setOptions( myQGLSceneNode.options() & ~QGLSceneNode::HideNode );
+      myQGLSceneNode.draw( &painter );
+      myQGLSceneNode.setOptions( myQGLSceneNode.options() | QGLSceneNode::HideNode );
+      myQGLSceneNode.blockSignals( false );
+   }
+   else myQGLSceneNode.draw( &painter );
+
+   // Revert to the previous object identifier.
+   painter.setObjectPickId( prevObjectId );
+
+   // Restore the modelview matrix.
+   painter.modelViewMatrix().pop();
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimSceneNode::event( QEvent* event )
+{
+   // The view widget sends a pick to the object now registered for the picked ID.  The picking buffer may be from a frame drawn before
+   // the ID was reused by this object, so ignore the pick unless the buffer was drawn with this object's handle (leaving is always accepted).
+   if( event->type() != QEvent::Leave && mySceneStore.GetSceneNodeHandleInPickBuffer( mySceneEntityId ) != mySceneNodeHandle ) return QObject::event( event );
+
+   // Convert the raw event into a signal representing the user's action.
+   if( event->type() == QEvent::MouseButtonPress )
+   {
+      QMouseEvent *mouseEvent = static_cast<QMouseEvent*>( event );
+      if( mouseEvent->button() == Qt::LeftButton )  emit mouseButtonPressed();
+   }
+   else if( event->type() == QEvent::MouseButtonRelease )
+   {
+      QMouseEvent *mouseEvent = static_cast<QMouseEvent*>( event );
+      if( mouseEvent->button() == Qt::LeftButton )
+      {
+         emit mouseButtonReleased();
+         // Determine if click is inside or outside an object.
+         // mouseEvent->x() is positive inside an object and negative outside.
+         if( mouseEvent->x() >= 0 )  emit mouseButtonClicked();
+      }
+   }
+   else if( event->type() == QEvent::MouseButtonDblClick )
+   {
+      emit mouseButtonDoubleClicked();
+   }
+   else if( event->type() == QEvent::Enter )
+   {
+      this->SetHoverStatus( true );
+      emit mouseHoverChanged();
+   }
+   else if( event->type() == QEvent::Leave )
+   {
+      // Maybe update status bar that no-longer hovering over object.
+      if( this->GetHoverStatus() && this->IsObjectPickable()  )
+         this->GetSceneNodeQSimGLViewWidget().WriteMessageToMainWindowStatusBarFromGLViewWidget( QString(""), 0 );
+
+      this->SetHoverStatus( false );
+      emit mouseHoverChanged();
+   }
+   return QObject::event( event );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::ObjectWasDoubleClicked()
+{
+   // Each scene node may be associated with a rigid body (shown in the view widget's shared property dialog box).
+   mySceneNodeQSimGLViewWidget.ShowRigidBodyTabWidgetForSceneNode( *this );
+
+   this->SetThisObjectWasSelectedAndDeselectOthers();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetThisObjectWasSelectedAndDeselectOthers()
+{
+   mySceneNodeQSimGLViewWidget.GetSceneSelection().SetSelectionToOnly( mySceneNodeHandle );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetObjectIsSelected( const bool isObjectSelected )
+{
+   QSimSceneSelection& sceneSelection = mySceneNodeQSimGLViewWidget.GetSceneSelection();
+   if( isObjectSelected ) sceneSelection.AddToSelection( mySceneNodeHandle );
+   else                   sceneSelection.RemoveFromSelection( mySceneNodeHandle );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::ObjectWasClicked()
+{
+   // Click selects only this object, control-click adds or removes it from the selection, and shift-click adds it.
+   const Qt::KeyboardModifiers modifiers = QApplication::keyboardModifiers();
+   QSimSceneSelection& sceneSelection = mySceneNodeQSimGLViewWidget.GetSceneSelection();
+   if(      modifiers & Qt::ControlModifier )  sceneSelection.ToggleSelection( mySceneNodeHandle );
+   else if( modifiers & Qt::ShiftModifier )    sceneSelection.AddToSelection( mySceneNodeHandle );
+   else                                        sceneSelection.SetSelectionToOnly( mySceneNodeHandle );
+   mySceneNodeQSimGLViewWidget.updateGL();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetSceneObjectPickableToFalseDeregisterDisconnect()
+{
+   // If already registered and connected, deregister this object (must also do this before object is destroyed) and disconnect signals.
+   if( this->IsObjectPickable() )
+   {
+      mySceneNodeQSimGLViewWidget.deregisterObject( this->GetObjectId() );
+      this->disconnect();
+      this->SetSceneEntityFlag( QSimSceneStore::EntityIsPickable, false );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneNode::SetObjectPickable( const bool isObjectPickable )
+{
+   // If already registered and connected, deregister this object (must also do this before object is destroyed) and disconnect signals.
+   this->SetSceneObjectPickableToFalseDeregisterDisconnect();
+
+   // Register this object for object picking and connect signals to listen to mouse/other events.
+   this->SetSceneEntityFlag( QSimSceneStore::EntityIsPickable, isObjectPickable );
+   if( isObjectPickable )
+   {
+      mySceneNodeQSimGLViewWidget.registerObject( this->GetObjectId(), this );
+      QObject::connect( this,  SIGNAL(mouseHoverChanged()),        &mySceneNodeQSimGLViewWidget, SIGNAL(SignalToUpdateGL()) );
+      QObject::connect( this,  SIGNAL(mouseButtonClicked()),       this,                         SLOT(ObjectWasClicked())  );
+      QObject::connect( this,  SIGNAL(mouseButtonDoubleClicked()), this,                         SLOT(ObjectWasDoubleClicked())  );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -1,183 +1,265 @@
-//-----------------------------------------------------------------------------
-// File:     QSimSceneNode.h
-// Class:    QSimSceneNode  
-// Parents:  QObject 
-// Purpose:  QSimSceneNode and QSimGLViewWidget work together for painting/picking on-screen objects.
-/* ---------------------------------------------------------------------------- *
-* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
-* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
-* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
-* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
-*                                                                               *
-* To the extent possible under law, the author(s) and contributor(s) have       *
-* dedicated all copyright and related and neighboring rights to this software   *
-* to the public domain worldwide. This software is distributed without warranty.*
-*                                                                               *
-* Authors: Paul Mitiguy (2011)                                                  *
-* Contributors: Ayman Habib, Michael Sherman                                    *
-*                                                                               *
-* Permission is granted, free of charge, to any person obtaining a copy of this *
-* software and associated documentation files (the "Software"), to deal in the  *
-* Software without restriction, including without limitation the rights to use, *
-* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
-* the Software and to permit persons to whom the Software is furnished to do so.*
-*                                                                               *
-* Include this sentence, the above public domain and permission notices, and the*
-* following disclaimer in all copies or substantial portions of the Software.   *
-*                                                                               *
-* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
-* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
-* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
-* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
-* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
-* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
-* ----------------------------------------------------------------------------- */
-#ifndef  QSIMSCENENODE_H__ 
-#define  QSIMSCENENODE_H__
-#include <QtCore>
-#include <QtGui>
-#include <QtOpenGL>
-#include "qglview.h"
-#include "qglscenenode.h"
-#include "qglpainter.h"
-#include "CppStandardHeaders.h"
-#include "QSimGenericFunctions.h"
-#include "QSimMaterialType.h"
-#include "QSimRigidBodyTabWidget.h"
-
-
-//------------------------------------------------------------------------------
-namespace QSim {
-
-// Forward declarations
-class  QSimScenePickListAndPaint;
-class  QSimGLViewWidget;
-
-
-//------------------------------------------------------------------------------
-class QSimSceneNode : public QObject
-{
-   Q_OBJECT
-
-public:
-   // Constructors and destructors.
-   QSimSceneNode( QGLSceneNode& sceneNode, QSimGLViewWidget& glViewWidget, const bool isObjectPickable, const char *objectNameOrNull );
-  ~QSimSceneNode()  { this->SetSceneObjectPickableToFalseDeregisterDisconnect(); }
-
-   // This object can be rotated by a certain angle (in degrees) about a certain vector.
-   void  SetRotationAngleInDegreesAndVector( const qreal newRotationAngleInDegrees, const QVector3D& newRotationVector ) { this->SetRotationAngleInDegrees(newRotationAngleInDegrees); this->SetRotationVector(newRotationVector); }
-
-   // This object can be translated by a certain vector amount.
-   QVector3D  GetPosition() const                          { return myPosition; }
-   void       SetPosition( const QVector3D& newPosition )  { myQGLSceneNode.setPosition( myPosition = newPosition ); }
-
-   // Material that is regularly displayed, or if object is pickable, when it is highlighted (e.g., mouse hovers on it).
-   const QSimMaterialType&  GetMaterialStandard() const                             { return myMaterialStandard;  }
-   const QSimMaterialType&  GetMaterialHighlight() const                            { return myMaterialHighlight; }
-   const QSimMaterialType&  GetMaterialBasedOnHoverStatus() const                   { return this->GetHoverStatus() ? this->GetMaterialHighlight() : this->GetMaterialStandard(); }
-   void                     SetMaterialStandard(  const QGLMaterial& newMaterial )  { myMaterialStandard.SetQSimMaterialType( newMaterial ); }
-   void                     SetMaterialHighlight( const QGLMaterial& newMaterial )  { myMaterialHighlight.SetQSimMaterialType( newMaterial ); }
-
-   const QGLAbstractEffect*  GetAbstractEffect() const                                 { return myAbstractEffect; }
-   void                      SetAbstractEffect( QGLAbstractEffect* newAbstractEffect ) { myAbstractEffect = newAbstractEffect; }
-
-   // Determine whether or not this object can be picked by the user.
-   void   SetObjectPickable( const bool isObjectPickable );
-   bool   IsObjectPickable( )  { return myObjectIsPickable; }
-
-   // Keep track of whether or not the object was selected (or should be de-selected).
-   void  SetThisObjectWasSelectedAndDeselectOthers();
-   void  SetObjectIsSelected( const bool isObjectSelected )  { myObjectIsSelected = isObjectSelected; }
-   bool  IsObjectSelected()                                  { return myObjectIsSelected; }
-
-   // Each instance of this class is always associated with an OpenGL view widget (set in constructor).
-   QSimGLViewWidget&  GetSceneNodeQSimGLViewWidget()   { return mySceneNodeQSimGLViewWidget; }
-   void               SetSceneObjectPickableToFalseDeregisterDisconnect();
-
-   // Each instance of this class is always associated with a QGLSceneNode.
-         QGLSceneNode&  GetQGLSceneNode()        { return myQGLSceneNode; }
-   const QGLSceneNode&  GetQGLSceneNode() const  { return myQGLSceneNode; }
-
-   // When creating a new object, get a unique ID number.
-   static unsigned long  GetNextUniqueID()   { return myNextUniqueID++; } 
-   long  GetObjectId() const                 { return myObjectId; }
-   long  SetObjectId( const long objectId )  { return myObjectId = objectId; }
-
-   // Get objectName[objectID], e.g., cylinder[2].
-   void  GetObjectNameAndObjectIdInsideSquareBrackets( QString& objectNameAndIdInsideSquareBrackets )  { QTextStream( &objectNameAndIdInsideSquareBrackets ) << this->objectName() << "[" << this->GetObjectId() << "]"; }
-
-   // Special information for initializing and drawing instances of this class.
-   void  DrawOpenGLForQSimSceneNode( QGLPainter& painter );
-
-signals:
-   void  mouseButtonPressed();
-   void  mouseButtonReleased();
-   void  mouseButtonClicked();
-   void  mouseButtonDoubleClicked();
-   void  mouseHoverChanged();
-
-protected:
-   bool  event( QEvent *e );
-
-private slots:
-   void  ObjectWasSoleSelected()    { this->SetThisObjectWasSelectedAndDeselectOthers(); }
-   void  ObjectWasDoubleClicked();
-
-private:
-   // First set myObjectIsPickable to false, then initialize all the relevant fields in this object.
-   void  InitializeQSimSceneNode()  { myObjectIsPickable = myObjectIsSelected = false;  myAbstractEffect = NULL;  this->SetMaterialStandard( QSimMaterialType::GetChinaMaterialStandard() );  this->SetMaterialHighlight( QSimMaterialType::GetChinaMaterialHighlight() );  this->SetHoverStatus(false);  this->SetRotationAngleInDegreesAndVector( 0, QVector3D(1,0,0) );  this->SetPosition( QVector3D(1,0,0) );  this->SetScale(1.0);  this->SetObjectId( QSimSceneNode::GetNextUniqueID() );  }
-
-   // This object can be rotated by a certain angle (in degrees) about a certain vector.
-   qreal      myRotationAngleInDegrees;
-   QVector3D  myRotationVector;
-   qreal      GetRotationAngleInDegrees() const                                   { return myRotationAngleInDegrees; }
-   QVector3D  GetRotationVector() const                                           { return myRotationVector; }
-   void       SetRotationAngleInDegrees( const qreal newRotationAngleInDegrees )  { myRotationAngleInDegrees = newRotationAngleInDegrees; }
-   void       SetRotationVector( const QVector3D& newRotationVector )             { myRotationVector = newRotationVector; }
-
-   // This object can be translated by a certain vector amount.
-   QVector3D  myPosition;
-
-   // This object can be scaled.
-   qreal  myScale;
-   qreal  GetScale() const                  { return myScale; }
-   void   SetScale( const qreal newScale )  { myScale = newScale; }
-
-   // Keep track of whether or not the mouse entered or left an object.
-   bool  myHoverStatus;
-   void  SetHoverStatus( const bool newHoverStatus )  { myHoverStatus = newHoverStatus; }
-   bool  GetHoverStatus() const                       { return myHoverStatus; }
-
-   // Keep track of whether or not the object is pickable.
-   // Keep track of whether or not the object was selected (or should be de-selected).
-   bool  myObjectIsPickable;
-   bool  myObjectIsSelected;
-
-   // Need to check out what this is.
-   QGLAbstractEffect* myAbstractEffect;
-
-   // Each instance of this class is always associated with a QGLSceneNode (set in constructor).
-   QGLSceneNode&  myQGLSceneNode;
-
-   // Each instance of this class is always associated with an OpenGL view widget (set in constructor).
-   QSimGLViewWidget&  mySceneNodeQSimGLViewWidget;
-
-   // Each instance of this class has one associated dialogue box for its properties.
-   // Although this wastes some memory - it also ensures the dialogue boxes disappears when the object is deleted.
-   QSimRigidBodyTabWidget  myRigidBodyTabWidget;
- 
-   // Material that is regularly displayed, or if object is pickable, when it is highlighted (e.g., mouse hovers on it).
-   QSimMaterialType  myMaterialStandard;
-   QSimMaterialType  myMaterialHighlight;
-
-   // When creating a new object, get a unique ID number.
-   long                  myObjectId;
-   static unsigned long  myNextUniqueID;
-};
-
-
-//------------------------------------------------------------------------------
-}  // End of namespace QSim
-//--------------------------------------------------------------------------
-#endif  // QSIMSCENENODE_H__
-//--------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// File:     QSimSceneNode.h
+// Class:    QSimSceneNode  
+// Parents:  QObject 
+// Purpose:  QSimSceneNode and QSimGLViewWidget work together for painting/picking on-screen objects.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMSCENENODE_H__ 
+#define  QSIMSCENENODE_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglview.h"
+#include "qglscenenode.h"
+#include "qglpainter.h"
+#include "CppStandardHeaders.h"
+#include "QSimGenericFunctions.h"
+#include "QSimMaterialType.h"
+#include "QSimMaterialLibrary.h"
+#include "QSimTextureManager.h"
+#include "QSimSceneStore.h"
+#include "QSimBlockPool.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Forward declarations
+class  QSimScenePickListAndPaint;
+class  QSimGLViewWidget;
+
+
+//------------------------------------------------------------------------------
+// Per-object properties in a plain struct (a copy of the values held in the view widget's scene store).
+// Each material and texture handle in the scene store holds one reference, released when the handle is replaced or the object is destroyed.
+struct QSimSceneNodeProperties
+{
+   QVector3D           myPosition;
+   QVector3D           myRotationVector;
+   qreal               myRotationAngleInDegrees;
+   qreal               myScale;
+   QSimMaterialHandle  myMaterialStandardHandle;
+   QSimMaterialHandle  myMaterialHighlightHandle;
+   QSimTextureHandle   myTextureHandle;
+};
+
+
+//------------------------------------------------------------------------------
+// Each object's data lives in its view widget's scene store (in arrays shared with all other objects), so this class
+// is a thin view that holds the object's entity ID plus what Qt needs for picking and signals.
+class QSimSceneNode : public QObject
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimSceneNode( QGLSceneNode& sceneNode, QSimGLViewWidget& glViewWidget, const bool isObjectPickable, const char *objectNameOrNull );
+  ~QSimSceneNode();
+
+   // QSimSceneNodes (not their QGLSceneNodes or geometry, which Qt/3D allocates) are allocated from a pool of equal-size blocks shared by
+   // all view widgets, so repeatedly adding and removing many objects reuses the same memory instead of fragmenting the heap.
+   static void*  operator new( size_t sizeInBytes );
+   static void   operator delete( void* sceneNode, size_t sizeInBytes );
+   static const QSimBlockPool&  GetSceneNodeBlockPool()  { return QSimSceneNode::GetSceneNodeBlockPoolForModification(); }
+
+   // This object can be rotated by a certain angle (in degrees) about a certain vector.
+   void  SetRotationAngleInDegreesAndVector( const qreal newRotationAngleInDegrees, const QVector3D& newRotationVector ) { this->SetRotationAngleInDegrees(newRotationAngleInDegrees); this->SetRotationVector(newRotationVector); }
+
+   // This object can be translated by a certain vector amount.
+   QVector3D  GetPosition() const                          { return mySceneStore.GetPosition( mySceneEntityId ); }
+   void       SetPosition( const QVector3D& newPosition )  { myQGLSceneNode.setPosition( newPosition );  mySceneStore.SetPosition( mySceneEntityId, newPosition );  this->SetModelMatrixIsDirty(); }
+
+   // Material that is regularly displayed, or if object is pickable, when it is highlighted (e.g., mouse hovers on it or it is selected).
+   // Materials are shared (immutable) entries in the material library - to change a material, set a different handle.
+   QSimMaterialHandle       GetMaterialStandardHandle() const                       { return mySceneStore.GetMaterialStandardHandle( mySceneEntityId );  }
+   QSimMaterialHandle       GetMaterialHighlightHandle() const                      { return mySceneStore.GetMaterialHighlightHandle( mySceneEntityId ); }
+   QSimMaterialHandle       GetMaterialHandleBasedOnHoverStatus() const             { return mySceneStore.GetMaterialHandleBasedOnHoverStatus( mySceneEntityId ); }
+   const QSimMaterialType&  GetMaterialStandard() const                             { return QSimMaterialLibrary::GetQSimMaterialLibrary().GetMaterial( this->GetMaterialStandardHandle() );  }
+   const QSimMaterialType&  GetMaterialHighlight() const                            { return QSimMaterialLibrary::GetQSimMaterialLibrary().GetMaterial( this->GetMaterialHighlightHandle() ); }
+   const QSimMaterialType&  GetMaterialBasedOnHoverStatus() const                   { return QSimMaterialLibrary::GetQSimMaterialLibrary().GetMaterial( this->GetMaterialHandleBasedOnHoverStatus() ); }
+   void                     SetMaterialStandardHandle(  const QSimMaterialHandle newMaterialHandle )  { QSimSceneNode::ReplaceMaterialHandle( mySceneStore.GetMaterialStandardHandleReference( mySceneEntityId ),  newMaterialHandle ); }
+   void                     SetMaterialHighlightHandle( const QSimMaterialHandle newMaterialHandle )  { QSimSceneNode::ReplaceMaterialHandle( mySceneStore.GetMaterialHighlightHandleReference( mySceneEntityId ), newMaterialHandle ); }
+   void                     SetMaterialStandard(  const QGLMaterial& newMaterial );
+   void                     SetMaterialHighlight( const QGLMaterial& newMaterial );
+
+   QGLAbstractEffect*  GetAbstractEffect() const                                 { return mySceneStore.GetAbstractEffect( mySceneEntityId ); }
+   void                SetAbstractEffect( QGLAbstractEffect* newAbstractEffect ) { mySceneStore.SetAbstractEffect( mySceneEntityId, newAbstractEffect ); }
+
+   // All the properties of this object (e.g., for displaying in the property dialog box).
+   QSimSceneNodeProperties  GetSceneNodeProperties() const;
+   void                     SetSceneNodeProperties( const QSimSceneNodeProperties& properties );
+
+   // Texture (if any) that is drawn on this object, as a handle to a texture shared through the view widget's texture manager.
+   // Handle 0 means no texture.  The texture is only bound when the object is drawn.
+   QSimTextureHandle  GetTextureHandle() const  { return mySceneStore.GetTextureHandle( mySceneEntityId ); }
+   bool               HasTexture() const        { return this->GetTextureHandle() != 0; }
+   void               SetTextureHandle( const QSimTextureHandle newTextureHandle );
+
+   // Determine whether or not this object can be picked by the user.
+   void   SetObjectPickable( const bool isObjectPickable );
+   bool   IsObjectPickable( )  { return mySceneStore.GetSceneEntityFlag( mySceneEntityId, QSimSceneStore::EntityIsPickable ); }
+
+   // Keep track of whether or not the object was selected (or should be de-selected), in the view widget's selection set.
+   void  SetThisObjectWasSelectedAndDeselectOthers();
+   void  SetObjectIsSelected( const bool isObjectSelected );
+   bool  IsObjectSelected()                                  { return mySceneStore.GetSceneEntityFlag( mySceneEntityId, QSimSceneStore::EntityIsSelected ); }
+
+   // Each instance of this class is always associated with an OpenGL view widget (set in constructor).
+   QSimGLViewWidget&  GetSceneNodeQSimGLViewWidget()   { return mySceneNodeQSimGLViewWidget; }
+   void               SetSceneObjectPickableToFalseDeregisterDisconnect();
+
+   // Each instance of this class is always associated with a QGLSceneNode.
+         QGLSceneNode&  GetQGLSceneNode()        { return myQGLSceneNode; }
+   const QGLSceneNode&  GetQGLSceneNode() const  { return myQGLSceneNode; }
+
+   // Index of this object's data in its view widget's scene store.
+   QSimSceneEntityId  GetSceneEntityId() const  { return mySceneEntityId; }
+
+   // Each object's ID (used for picking) is its index in the scene store, which is small enough for the picking colors.
+   // The index is reused after the object is removed, so references to an object are kept as handles (see QSimSceneNodeHandle),
+   // and a pick is only accepted if the picking buffer was drawn with this object's handle (not that of an earlier object with the same ID).
+   long                 GetObjectId() const          { return mySceneEntityId; }
+   QSimSceneNodeHandle  GetSceneNodeHandle() const   { return mySceneNodeHandle; }
+
+   // Get objectName[objectID], e.g., cylinder[2].
+   void  GetObjectNameAndObjectIdInsideSquareBrackets( QString& objectNameAndIdInsideSquareBrackets )  { QTextStream( &objectNameAndIdInsideSquareBrackets ) << this->objectName() << "[" << this->GetObjectId() << "]"; }
+
+   // Matrix that positions this object (rotation, translation, and scale) relative to its parent, and relative to the world
+   // (the model matrix preceded by the transforms of all ancestor scene nodes).  Both are cached and only recalculated after
+   // this object or one of its ancestors changes, so objects that do not move cost nothing per frame.
+   const QMatrix4x4&  GetModelMatrix() const  { if( this->GetSceneEntityFlag( QSimSceneStore::EntityModelMatrixIsDirty ) ) this->UpdateModelMatrix();  return mySceneStore.GetModelMatrix( mySceneEntityId ); }
+   const QMatrix4x4&  GetWorldMatrix() const  { if( this->GetSceneEntityFlag( QSimSceneStore::EntityWorldMatrixIsDirty ) ) this->UpdateWorldMatrix();  return mySceneStore.GetWorldMatrix( mySceneEntityId ); }
+
+   // Change the transform of any QGLSceneNode in a scene with objects (an object's own QGLSceneNode, or a QGLSceneNode between objects).
+   // Objects do not listen to QGLSceneNode::updated() (Qt/3D forwards it from every descendant), so transforms are changed only through
+   // these, which make the bounds of the node's object (if any) and the world matrices of all objects at or below the node dirty.
+   static void  SetLocalTransformOfQGLSceneNode( QGLSceneNode& sceneNode, const QMatrix4x4& localTransform )  { sceneNode.setLocalTransform( localTransform );  QSimSceneNode::SetTransformOfQGLSceneNodeIsDirty( sceneNode ); }
+   static void  SetPositionOfQGLSceneNode( QGLSceneNode& sceneNode, const QVector3D& position )                { sceneNode.setPosition( position );  QSimSceneNode::SetTransformOfQGLSceneNodeIsDirty( sceneNode ); }
+
+   // Bounding sphere of this object's geometry (center in x, y, z and radius in w) in the coordinates of its world matrix.
+   const QVector4D&  GetLocalBoundingSphere() const  { if( this->GetSceneEntityFlag( QSimSceneStore::EntityBoundsAreDirty ) ) this->UpdateLocalBoundingSphere();  return mySceneStore.GetLocalBoundingSphere( mySceneEntityId ); }
+   void              UpdateWorldMatrixAndBoundsIfDirty() const  { this->GetWorldMatrix();  this->GetLocalBoundingSphere(); }
+
+   // Number of OpenGL draw calls and triangles needed to draw this object's geometry (calculated once, until the geometry is changed).
+   unsigned int  GetNumberOfDrawCalls() const  { if( mySceneStore.GetNumberOfTrianglesOrMinus1( mySceneEntityId ) < 0 ) this->CalculateNumberOfDrawCallsAndTriangles();  return mySceneStore.GetNumberOfDrawCalls( mySceneEntityId ); }
+   unsigned int  GetNumberOfTriangles() const  { if( mySceneStore.GetNumberOfTrianglesOrMinus1( mySceneEntityId ) < 0 ) this->CalculateNumberOfDrawCallsAndTriangles();  return mySceneStore.GetNumberOfTrianglesOrMinus1( mySceneEntityId ); }
+
+   // Call after replacing geometry in this object's QGLSceneNodes (e.g., with levels of detail), so its bounds and statistics are recalculated.
+   void  SetGeometryWasChanged()  { this->SetSceneEntityFlag( QSimSceneStore::EntityBoundsAreDirty, true );  mySceneStore.SetNumberOfDrawCallsAndTriangles( mySceneEntityId, 0, -1 ); }
+
+   // The QSimSceneNode (if any) associated with a QGLSceneNode.
+   static QSimSceneNode*  GetQSimSceneNodeForQGLSceneNodeOrNull( const QGLSceneNode& sceneNode );
+
+   // Special information for initializing and drawing instances of this class.
+   // DrawOpenGLForQSimSceneNode applies this object's material, effect, and texture to the painter and then draws it.
+   // DrawOpenGLGeometryForQSimSceneNode only draws, as the render state was already applied (e.g., by QSimRenderQueue).
+   void  DrawOpenGLForQSimSceneNode( QGLPainter& painter );
+   void  DrawOpenGLGeometryForQSimSceneNode( QGLPainter& painter );
+
+signals:
+   void  mouseButtonPressed();
+   void  mouseButtonReleased();
+   void  mouseButtonClicked();
+   void  mouseButtonDoubleClicked();
+   void  mouseHoverChanged();
+
+protected:
+   bool  event( QEvent *e );
+
+private slots:
+   void  ObjectWasClicked();
+   void  ObjectWasDoubleClicked();
+
+private:
+   // Pool from which every QSimSceneNode is allocated (only used from the GUI thread).
+   static QSimBlockPool&  GetSceneNodeBlockPoolForModification();
+
+   // The scene store has already cleared the flags (so the object is not pickable), and the matrices and bounds are dirty.
+   void  InitializeQSimSceneNode()  { mySceneStore.GetMaterialStandardHandleReference( mySceneEntityId ) = QSimMaterialLibrary::GetQSimMaterialLibrary().AcquireMaterial( QSimMaterialLibrary::GetChinaMaterialStandardHandle() );  mySceneStore.GetMaterialHighlightHandleReference( mySceneEntityId ) = QSimMaterialLibrary::GetQSimMaterialLibrary().AcquireMaterial( QSimMaterialLibrary::GetChinaMaterialHighlightHandle() );  this->SetHoverStatus(false);  this->SetRotationAngleInDegreesAndVector( 0, QVector3D(1,0,0) );  this->SetPosition( QVector3D(1,0,0) );  this->SetScale(1.0);  }
+
+   // This object can be rotated by a certain angle (in degrees) about a certain vector.
+   qreal      GetRotationAngleInDegrees() const                                   { return mySceneStore.GetRotationAngleInDegrees( mySceneEntityId ); }
+   QVector3D  GetRotationVector() const                                           { return mySceneStore.GetRotationVector( mySceneEntityId ); }
+   void       SetRotationAngleInDegrees( const qreal newRotationAngleInDegrees )  { mySceneStore.SetRotationAngleInDegrees( mySceneEntityId, newRotationAngleInDegrees );  this->SetModelMatrixIsDirty(); }
+   void       SetRotationVector( const QVector3D& newRotationVector )             { mySceneStore.SetRotationVector( mySceneEntityId, newRotationVector );  this->SetModelMatrixIsDirty(); }
+
+   // This object can be scaled.
+   qreal  GetScale() const                  { return mySceneStore.GetScale( mySceneEntityId ); }
+   void   SetScale( const qreal newScale )  { mySceneStore.SetScale( mySceneEntityId, newScale );  this->SetModelMatrixIsDirty(); }
+
+   // Keep track of whether or not the mouse entered or left an object.
+   void  SetHoverStatus( const bool newHoverStatus )  { this->SetSceneEntityFlag( QSimSceneStore::EntityHasHoverStatus, newHoverStatus ); }
+   bool  GetHoverStatus() const                       { return this->GetSceneEntityFlag( QSimSceneStore::EntityHasHoverStatus ); }
+
+   // Flags (e.g., whether the object is pickable, selected, or has dirty matrices) are bits in the scene store.
+   bool  GetSceneEntityFlag( const QSimSceneStore::QSimSceneEntityFlag flag ) const        { return mySceneStore.GetSceneEntityFlag( mySceneEntityId, flag ); }
+   void  SetSceneEntityFlag( const QSimSceneStore::QSimSceneEntityFlag flag, const bool value ) const  { mySceneStore.SetSceneEntityFlag( mySceneEntityId, flag, value ); }
+
+   // The scene store (owned by the view widget, which outlives this object) and this object's index in it.
+   QSimSceneStore&            mySceneStore;
+   const QSimSceneEntityId    mySceneEntityId;
+   const QSimSceneNodeHandle  mySceneNodeHandle;
+
+   // Each instance of this class is always associated with a QGLSceneNode (set in constructor).
+   QGLSceneNode&  myQGLSceneNode;
+
+   // Each instance of this class is always associated with an OpenGL view widget (set in constructor).
+   QSimGLViewWidget&  mySceneNodeQSimGLViewWidget;
+
+   // Materials are replaced in the scene store (the property dialog box is shared by all objects and owned by the view widget).
+   static void  ReplaceMaterialHandle( QSimMaterialHandle& handleToReplace, const QSimMaterialHandle newMaterialHandle );
+
+   // Cached model and world matrices.  When this object changes, its model and world matrices (and bounds) become dirty.
+   // When this object changes, the world matrices of this object and all its descendants become dirty (and nothing else).
+   // A clean world matrix implies the world matrices of all ancestors are clean, so a dirty world matrix implies all descendants are already dirty.
+   void         UpdateModelMatrix() const;
+   void         UpdateWorldMatrix() const;
+   void         UpdateLocalBoundingSphere() const;
+   void         SetModelMatrixIsDirty()  { this->SetSceneEntityFlag( QSimSceneStore::EntityModelMatrixIsDirty, true );  this->SetSceneEntityFlag( QSimSceneStore::EntityBoundsAreDirty, true );  this->SetWorldMatrixIsDirty(); }
+   void         SetWorldMatrixIsDirty();
+   static void  SetWorldMatrixIsDirtyForDescendantsOf( const QGLSceneNode& sceneNode );
+   static void  SetTransformOfQGLSceneNodeIsDirty( const QGLSceneNode& sceneNode );
+   void         HideIfAncestorIsQSimSceneNode();
+
+   // An object whose QGLSceneNode descends from another object's QGLSceneNode draws itself (with its own cached world matrix),
+   // so it is hidden while the ancestor's QGLSceneNode draws its children (the flag EntityHasAncestorQSimSceneNode is set).
+   bool  HasAncestorQSimSceneNode() const  { return this->GetSceneEntityFlag( QSimSceneStore::EntityHasAncestorQSimSceneNode ); }
+
+   // Geometry statistics (for profiling).
+   void  CalculateNumberOfDrawCallsAndTriangles() const;
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMSCENENODE_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+// File:     QSimSceneSelection.cpp
+// Class:    QSimSceneSelection
+// Parents:  None
+// Purpose:  Set of selected objects in a view widget, so selecting and deselecting costs time proportional to the selection (not the scene).
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimSceneSelection.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneSelection::AddToSelection( const QSimSceneNodeHandle handle )
+{
+   // Handles to objects that no longer exist are ignored.
+   if( !mySceneStore.IsSceneNodeHandleValid( handle ) ) return;
+   mySelectedSceneNodeHandles.insert( handle );
+   mySceneStore.SetSceneEntityFlag( QSimSceneStore::GetSceneEntityIdForHandle( handle ), QSimSceneStore::EntityIsSelected, true );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneSelection::RemoveFromSelection( const QSimSceneNodeHandle handle )
+{
+   if( !mySelectedSceneNodeHandles.remove( handle ) ) return;
+   mySceneStore.SetSceneEntityFlag( QSimSceneStore::GetSceneEntityIdForHandle( handle ), QSimSceneStore::EntityIsSelected, false );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneSelection::ClearSelection()
+{
+   // Only the selected objects are visited.
+   for( QSet<QSimSceneNodeHandle>::const_iterator it = mySelectedSceneNodeHandles.constBegin();  it != mySelectedSceneNodeHandles.constEnd();  ++it )
+      mySceneStore.SetSceneEntityFlag( QSimSceneStore::GetSceneEntityIdForHandle( *it ), QSimSceneStore::EntityIsSelected, false );
+   mySelectedSceneNodeHandles.clear();
+}
+
+
+//------------------------------------------------------------------------------
+int  QSimSceneSelection::AddToSelectionObjectsInViewportRectangle( const QMatrix4x4& projectionViewMatrix, const QSize& viewportSize, const QRect& rectangle )
+{
+   if( viewportSize.isEmpty() || rectangle.isEmpty() ) return 0;
+
+   // The rectangle in normalized device coordinates (x and y from -1 to 1, with y up).
+   const qreal left   = 2.0 * rectangle.left()       / viewportSize.width()  - 1.0;
+   const qreal right  = 2.0 * (rectangle.right()+1)  / viewportSize.width()  - 1.0;
+   const qreal top    = 1.0 - 2.0 * rectangle.top()        / viewportSize.height();
+   const qreal bottom = 1.0 - 2.0 * (rectangle.bottom()+1) / viewportSize.height();
+
+   // Stretch the rectangle to fill normalized device coordinates, so the objects in it are those in the narrower view frustum.
+   QMatrix4x4 rectangleMatrix;
+   rectangleMatrix.scale( 2.0 / (right - left), 2.0 / (top - bottom), 1.0 );
+   rectangleMatrix.translate( -0.5 * (left + right), -0.5 * (top + bottom), 0.0 );
+   QVector<QSimSceneEntityId> entityIds;
+   mySceneStore.AppendSceneEntitiesInViewFrustum( rectangleMatrix * projectionViewMatrix, entityIds );
+
+   // Only objects the user can pick may be selected.  Objects without finite bounds are in every view frustum (so they are never culled),
+   // but are not known to be inside the rectangle, so they are skipped.
+   int numberOfObjectsAdded = 0;
+   for( int i=0;  i < entityIds.count();  i++ )
+   {
+      const QSimSceneEntityId id = entityIds[i];
+      if( !mySceneStore.GetSceneEntityFlag( id, QSimSceneStore::EntityIsPickable ) || mySceneStore.GetSceneEntityFlag( id, QSimSceneStore::EntityIsSelected ) ) continue;
+      if( mySceneStore.GetLocalBoundingSphere( id ).w() < 0 ) continue;
+      this->AddToSelection( mySceneStore.GetSceneNodeHandle( id ) );
+      ++numberOfObjectsAdded;
+   }
+   return numberOfObjectsAdded;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
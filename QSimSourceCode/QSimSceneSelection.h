@@ -0,0 +1,83 @@
+//-----------------------------------------------------------------------------
+// File:     QSimSceneSelection.h
+// Class:    QSimSceneSelection
+// Parents:  None
+// Purpose:  Set of selected objects in a view widget, so selecting and deselecting costs time proportional to the selection (not the scene).
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMSCENESELECTION_H__
+#define  QSIMSCENESELECTION_H__
+#include <QtCore>
+#include <QtGui>
+#include "CppStandardHeaders.h"
+#include "QSimSceneStore.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+class QSimSceneSelection
+{
+public:
+   // Constructors and destructors.
+   QSimSceneSelection( QSimSceneStore& sceneStore ) : mySceneStore(sceneStore)  {;}
+  ~QSimSceneSelection()  {;}
+
+   // Each object's EntityIsSelected flag in the scene store is kept equal to its membership in this set (so either can be queried quickly).
+   // Objects must be removed from the selection before they are destroyed (QSimSceneNode does this).
+   void  AddToSelection( const QSimSceneNodeHandle handle );
+   void  RemoveFromSelection( const QSimSceneNodeHandle handle );
+   void  ToggleSelection( const QSimSceneNodeHandle handle )      { if( this->IsSelected( handle ) ) this->RemoveFromSelection( handle );  else this->AddToSelection( handle ); }
+   void  SetSelectionToOnly( const QSimSceneNodeHandle handle )   { this->ClearSelection();  this->AddToSelection( handle ); }
+   void  ClearSelection();
+   bool  IsSelected( const QSimSceneNodeHandle handle ) const     { return mySelectedSceneNodeHandles.contains( handle ); }
+
+   // Add every pickable object whose finite bounds overlap a rectangle on the screen (e.g., a rubber band dragged with the mouse).
+   // projectionViewMatrix is the camera's projection times view matrix for a viewport of size viewportSize.
+   // Returns the number of objects that were added.
+   int  AddToSelectionObjectsInViewportRectangle( const QMatrix4x4& projectionViewMatrix, const QSize& viewportSize, const QRect& rectangle );
+
+   // The selected objects (in no particular order).
+   int                         GetNumberOfSelectedObjects() const   { return mySelectedSceneNodeHandles.count(); }
+   QList<QSimSceneNodeHandle>  GetSelectedSceneNodeHandles() const  { return mySelectedSceneNodeHandles.toList(); }
+
+private:
+   QSimSceneStore&            mySceneStore;
+   QSet<QSimSceneNodeHandle>  mySelectedSceneNodeHandles;
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMSCENESELECTION_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,173 @@
+//-----------------------------------------------------------------------------
+// File:     QSimSceneStore.cpp
+// Class:    QSimSceneStore
+// Parents:  None
+// Purpose:  Per-object transforms, bounds, render state, and flags for one view widget, in contiguous arrays indexed by entity ID.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimSceneStore.h"
+#include "QSimSceneNode.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimSceneEntityId  QSimSceneStore::AddSceneEntity( QSimSceneNode& sceneNode )
+{
+   // Reuse the ID of a removed entity, otherwise grow every array by one element.
+   QSimSceneEntityId id;
+   if( !myFreeSceneEntityIds.isEmpty() ) { id = myFreeSceneEntityIds.last();  myFreeSceneEntityIds.pop_back(); }
+   else
+   {
+      id = myFlags.count();
+      Q_ASSERT( id <= 0x3FFFFF );   // Entity IDs must fit in the low 22 bits of a handle.
+      myFlags.append( 0 );
+      myGenerations.append( 0 );
+      mySceneNodes.append( NULL );
+      myPositions.append( QVector3D() );
+      myRotationVectors.append( QVector3D() );
+      myRotationAnglesInDegrees.append( 0 );
+      myScales.append( 1 );
+      myModelMatrices.append( QMatrix4x4() );
+      myWorldMatrices.append( QMatrix4x4() );
+      myLocalBoundingSpheres.append( QVector4D() );
+      myMaterialStandardHandles.append( 0 );
+      myMaterialHighlightHandles.append( 0 );
+      myTextureHandles.append( 0 );
+      myAbstractEffects.append( NULL );
+      myNumberOfDrawCalls.append( 0 );
+      myNumberOfTrianglesOrMinus1.append( -1 );
+      myHandlesInPickBuffer.append( QSimSceneStore::GetInvalidSceneNodeHandle() );
+   }
+
+   // Matrices and bounds are calculated when first needed.
+   myFlags[id] = EntityIsInUse | EntityModelMatrixIsDirty | EntityWorldMatrixIsDirty | EntityBoundsAreDirty;
+   mySceneNodes[id] = &sceneNode;
+   return id;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneStore::RemoveSceneEntity( const QSimSceneEntityId id )
+{
+   // Reset the elements to default values (the caller has already released the entity's materials and texture).
+   myFlags[id] = 0;
+   mySceneNodes[id] = NULL;
+   myPositions[id] = myRotationVectors[id] = QVector3D();
+   myRotationAnglesInDegrees[id] = 0;
+   myScales[id] = 1;
+   myMaterialStandardHandles[id] = myMaterialHighlightHandles[id] = 0;
+   myTextureHandles[id] = 0;
+   myAbstractEffects[id] = NULL;
+   myNumberOfDrawCalls[id] = 0;
+   myNumberOfTrianglesOrMinus1[id] = -1;
+
+   // Handles to the removed entity no longer match this ID, as its generation changes.
+   myGenerations[id] = ( myGenerations[id] + 1 ) & 0x1FF;
+   if( myGenerations[id] != 0 ) myFreeSceneEntityIds.append( id );
+   else                         ++myNumberOfRetiredSceneEntityIds;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneStore::ReserveSceneEntities( const int numberOfEntities )
+{
+   myFlags.reserve( numberOfEntities );
+   myGenerations.reserve( numberOfEntities );
+   mySceneNodes.reserve( numberOfEntities );
+   myPositions.reserve( numberOfEntities );
+   myRotationVectors.reserve( numberOfEntities );
+   myRotationAnglesInDegrees.reserve( numberOfEntities );
+   myScales.reserve( numberOfEntities );
+   myModelMatrices.reserve( numberOfEntities );
+   myWorldMatrices.reserve( numberOfEntities );
+   myLocalBoundingSpheres.reserve( numberOfEntities );
+   myMaterialStandardHandles.reserve( numberOfEntities );
+   myMaterialHighlightHandles.reserve( numberOfEntities );
+   myTextureHandles.reserve( numberOfEntities );
+   myAbstractEffects.reserve( numberOfEntities );
+   myNumberOfDrawCalls.reserve( numberOfEntities );
+   myNumberOfTrianglesOrMinus1.reserve( numberOfEntities );
+   myHandlesInPickBuffer.reserve( numberOfEntities );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimSceneStore::AppendSceneEntitiesInViewFrustum( const QMatrix4x4& projectionViewMatrix, QVector<QSimSceneEntityId>& entityIds )
+{
+   // The six planes of the view frustum (left, right, bottom, top, near, far) in world coordinates, normalized so that
+   // plane.x*x + plane.y*y + plane.z*z + plane.w is the signed distance of point (x,y,z) from the plane (positive is inside).
+   QVector4D frustumPlanes[6];
+   const QVector4D row3 = projectionViewMatrix.row(3);
+   for( int i=0;  i < 3;  i++ )
+   {
+      const QVector4D rowi = projectionViewMatrix.row(i);
+      frustumPlanes[2*i]   = row3 + rowi;
+      frustumPlanes[2*i+1] = row3 - rowi;
+   }
+   for( int i=0;  i < 6;  i++ )
+   {
+      const qreal normalLength = frustumPlanes[i].toVector3D().length();
+      if( normalLength > 0 ) frustumPlanes[i] /= normalLength;
+   }
+
+   // Stale matrices and bounds are recalculated by the scene node (which knows its ancestors), then the test reads only the arrays.
+   const int numberOfEntityIds = myFlags.count();
+   for( int id=0;  id < numberOfEntityIds;  id++ )
+   {
+      const quint8 flags = myFlags[id];
+      if( !(flags & EntityIsInUse) ) continue;
+      if( flags & (EntityWorldMatrixIsDirty | EntityBoundsAreDirty) ) mySceneNodes[id]->UpdateWorldMatrixAndBoundsIfDirty();
+
+      // Entities without finite bounds are always drawn.
+      const QVector4D& localBoundingSphere = myLocalBoundingSpheres[id];
+      if( localBoundingSphere.w() < 0 ) { entityIds.append( id );  continue; }
+
+      // Bounding sphere in world coordinates (the radius grows with the largest scale factor in the world matrix).
+      const QMatrix4x4& worldMatrix = myWorldMatrices[id];
+      const QVector3D center = worldMatrix.map( localBoundingSphere.toVector3D() );
+      qreal largestScaleSquared = 0;
+      for( int column=0;  column < 3;  column++ )
+         largestScaleSquared = qMax( largestScaleSquared, worldMatrix(0,column)*worldMatrix(0,column) + worldMatrix(1,column)*worldMatrix(1,column) + worldMatrix(2,column)*worldMatrix(2,column) );
+      const qreal radius = localBoundingSphere.w() * sqrt( largestScaleSquared );
+
+      // The entity is culled if its bounding sphere is entirely outside any plane.
+      bool isInViewFrustum = true;
+      for( int i=0;  i < 6 && isInViewFrustum;  i++ )
+         isInViewFrustum = frustumPlanes[i].x()*center.x() + frustumPlanes[i].y()*center.y() + frustumPlanes[i].z()*center.z() + frustumPlanes[i].w() >= -radius;
+      if( isInViewFrustum ) entityIds.append( id );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------------
+// File:     QSimSceneStore.h
+// Class:    QSimSceneStore
+// Parents:  None
+// Purpose:  Per-object transforms, bounds, render state, and flags for one view widget, in contiguous arrays indexed by entity ID.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMSCENESTORE_H__
+#define  QSIMSCENESTORE_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglabstracteffect.h"
+#include "CppStandardHeaders.h"
+#include "QSimMaterialLibrary.h"
+#include "QSimTextureManager.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Forward declarations
+class  QSimSceneNode;
+
+// Each object in a view widget is an entity, identified by its index in the scene store's arrays.
+typedef unsigned int  QSimSceneEntityId;
+
+// A handle combines an entity ID (low 22 bits) with the generation of that ID (high 9 bits), which changes each time the ID is reused.
+// A handle to a removed object is therefore never mistaken for a newer object with the same ID.  The entity ID alone is the object's
+// picking ID (picking colors only distinguish small IDs), so picking IDs are reused.  The scene store records the handle drawn with
+// each picking ID in the picking buffer, and a pick is only accepted if that handle is the handle of the object now using the ID.
+typedef unsigned int  QSimSceneNodeHandle;
+
+
+//------------------------------------------------------------------------------
+class QSimSceneStore
+{
+public:
+   // Constructors and destructors.
+   QSimSceneStore()   { myNumberOfRetiredSceneEntityIds = 0; }
+  ~QSimSceneStore()   {;}
+
+   // Bits in each entity's flags.
+   enum QSimSceneEntityFlag
+   {
+      EntityIsInUse                  = 0x01,
+      EntityIsPickable               = 0x02,
+      EntityIsSelected               = 0x04,
+      EntityHasHoverStatus           = 0x08,
+      EntityModelMatrixIsDirty       = 0x10,
+      EntityWorldMatrixIsDirty       = 0x20,
+      EntityBoundsAreDirty           = 0x40,
+      EntityHasAncestorQSimSceneNode = 0x80
+   };
+
+   // Add an entity (reusing the ID of a removed entity if there is one) with default values and dirty matrices and bounds.
+   // Removing an entity does not move other entities, so IDs of other entities remain valid.  Both take constant time.
+   QSimSceneEntityId  AddSceneEntity( QSimSceneNode& sceneNode );
+   void               RemoveSceneEntity( const QSimSceneEntityId id );
+   void               ReserveSceneEntities( const int numberOfEntities );
+
+   // Handle to the entity currently using an ID, and the object (if it still exists) that a handle refers to, in constant time.
+   QSimSceneNodeHandle        GetSceneNodeHandle( const QSimSceneEntityId id ) const                      { return ( (QSimSceneNodeHandle)myGenerations[id] << 22 ) | id; }
+   static QSimSceneEntityId   GetSceneEntityIdForHandle( const QSimSceneNodeHandle handle )               { return handle & 0x3FFFFF; }
+   static QSimSceneNodeHandle GetInvalidSceneNodeHandle()                                                 { return 0xFFFFFFFF; }
+   bool                       IsSceneNodeHandleValid( const QSimSceneNodeHandle handle ) const            { const QSimSceneEntityId id = QSimSceneStore::GetSceneEntityIdForHandle( handle );  return id < (QSimSceneEntityId)myFlags.count() && (myFlags[id] & EntityIsInUse) && this->GetSceneNodeHandle( id ) == handle; }
+   QSimSceneNode*             GetSceneNodeForHandleOrNull( const QSimSceneNodeHandle handle ) const       { return this->IsSceneNodeHandleValid( handle ) ? mySceneNodes[ QSimSceneStore::GetSceneEntityIdForHandle( handle ) ] : NULL; }
+
+   // Loops visit IDs 0 to GetNumberOfSceneEntityIds()-1 and skip IDs that are not in use.
+   unsigned int    GetNumberOfSceneEntityIds() const                       { return myFlags.count(); }
+   unsigned int    GetNumberOfSceneEntitiesInUse() const                   { return myFlags.count() - myFreeSceneEntityIds.count() - myNumberOfRetiredSceneEntityIds; }
+   bool            IsSceneEntityInUse( const QSimSceneEntityId id ) const  { return (myFlags[id] & EntityIsInUse) != 0; }
+   QSimSceneNode&  GetSceneNode( const QSimSceneEntityId id ) const        { return *( mySceneNodes[id] ); }
+
+   // Flags.
+   bool  GetSceneEntityFlag( const QSimSceneEntityId id, const QSimSceneEntityFlag flag ) const  { return (myFlags[id] & flag) != 0; }
+   void  SetSceneEntityFlag( const QSimSceneEntityId id, const QSimSceneEntityFlag flag, const bool value )  { if( value ) myFlags[id] |= flag;  else myFlags[id] &= ~flag; }
+
+   // Rotation (by an angle in degrees about a vector), position, and scale of an entity relative to its parent.
+   const QVector3D&  GetPosition( const QSimSceneEntityId id ) const                { return myPositions[id]; }
+   const QVector3D&  GetRotationVector( const QSimSceneEntityId id ) const          { return myRotationVectors[id]; }
+   qreal             GetRotationAngleInDegrees( const QSimSceneEntityId id ) const  { return myRotationAnglesInDegrees[id]; }
+   qreal             GetScale( const QSimSceneEntityId id ) const                   { return myScales[id]; }
+   void  SetPosition( const QSimSceneEntityId id, const QVector3D& newPosition )                        { myPositions[id] = newPosition; }
+   void  SetRotationVector( const QSimSceneEntityId id, const QVector3D& newRotationVector )            { myRotationVectors[id] = newRotationVector; }
+   void  SetRotationAngleInDegrees( const QSimSceneEntityId id, const qreal newRotationAngleInDegrees ) { myRotationAnglesInDegrees[id] = newRotationAngleInDegrees; }
+   void  SetScale( const QSimSceneEntityId id, const qreal newScale )                                   { myScales[id] = newScale; }
+
+   // Cached model and world matrices (QSimSceneNode decides when they are recalculated).
+   const QMatrix4x4&  GetModelMatrix( const QSimSceneEntityId id ) const                      { return myModelMatrices[id]; }
+   const QMatrix4x4&  GetWorldMatrix( const QSimSceneEntityId id ) const                      { return myWorldMatrices[id]; }
+   void  SetModelMatrix( const QSimSceneEntityId id, const QMatrix4x4& newModelMatrix )       { myModelMatrices[id] = newModelMatrix; }
+   void  SetWorldMatrix( const QSimSceneEntityId id, const QMatrix4x4& newWorldMatrix )       { myWorldMatrices[id] = newWorldMatrix; }
+
+   // Bounding sphere (center in x, y, z and radius in w) in the coordinates of the entity's world matrix.
+   // A negative radius means the entity has no finite bounds (it is never culled).
+   const QVector4D&  GetLocalBoundingSphere( const QSimSceneEntityId id ) const                     { return myLocalBoundingSpheres[id]; }
+   void  SetLocalBoundingSphere( const QSimSceneEntityId id, const QVector4D& newBoundingSphere )   { myLocalBoundingSpheres[id] = newBoundingSphere; }
+
+   // Shared materials, texture, and effect used to draw the entity.
+   QSimMaterialHandle  GetMaterialStandardHandle( const QSimSceneEntityId id ) const            { return myMaterialStandardHandles[id]; }
+   QSimMaterialHandle  GetMaterialHighlightHandle( const QSimSceneEntityId id ) const           { return myMaterialHighlightHandles[id]; }
+   QSimMaterialHandle  GetMaterialHandleBasedOnHoverStatus( const QSimSceneEntityId id ) const  { return (myFlags[id] & (EntityHasHoverStatus | EntityIsSelected)) ? myMaterialHighlightHandles[id] : myMaterialStandardHandles[id]; }
+   QSimTextureHandle   GetTextureHandle( const QSimSceneEntityId id ) const                     { return myTextureHandles[id]; }
+   QGLAbstractEffect*  GetAbstractEffect( const QSimSceneEntityId id ) const                    { return myAbstractEffects[id]; }
+   QSimMaterialHandle&  GetMaterialStandardHandleReference( const QSimSceneEntityId id )        { return myMaterialStandardHandles[id]; }
+   QSimMaterialHandle&  GetMaterialHighlightHandleReference( const QSimSceneEntityId id )       { return myMaterialHighlightHandles[id]; }
+   void  SetTextureHandle( const QSimSceneEntityId id, const QSimTextureHandle newTextureHandle )      { myTextureHandles[id] = newTextureHandle; }
+   void  SetAbstractEffect( const QSimSceneEntityId id, QGLAbstractEffect* newAbstractEffect )        { myAbstractEffects[id] = newAbstractEffect; }
+
+   // Geometry statistics (a negative number of triangles means they have not been counted yet).
+   int   GetNumberOfDrawCalls( const QSimSceneEntityId id ) const         { return myNumberOfDrawCalls[id]; }
+   int   GetNumberOfTrianglesOrMinus1( const QSimSceneEntityId id ) const { return myNumberOfTrianglesOrMinus1[id]; }
+   void  SetNumberOfDrawCallsAndTriangles( const QSimSceneEntityId id, const int numberOfDrawCalls, const int numberOfTriangles )  { myNumberOfDrawCalls[id] = numberOfDrawCalls;  myNumberOfTrianglesOrMinus1[id] = numberOfTriangles; }
+
+   // Handle of the entity drawn with each picking ID (entity ID) when the picking buffer was last drawn, or an invalid handle.
+   // The record outlives the entity (the picking buffer may be older than the entity's removal, and its ID may since be reused).
+   QSimSceneNodeHandle  GetSceneNodeHandleInPickBuffer( const QSimSceneEntityId id ) const   { return myHandlesInPickBuffer[id]; }
+   void                 SetSceneNodeHandleInPickBuffer( const QSimSceneEntityId id )         { myHandlesInPickBuffer[id] = this->GetSceneNodeHandle( id ); }
+
+   // Append the IDs of entities whose bounds are at least partly inside the view frustum of projectionViewMatrix (projection times view matrix).
+   // Stale world matrices and bounds are recalculated first.
+   void  AppendSceneEntitiesInViewFrustum( const QMatrix4x4& projectionViewMatrix, QVector<QSimSceneEntityId>& entityIds );
+
+private:
+   // One element per entity in each array (arrays are the same length, and elements for unused IDs hold default values).
+   QVector<quint8>              myFlags;
+   QVector<quint16>             myGenerations;
+   QVector<QSimSceneNode*>      mySceneNodes;
+   QVector<QVector3D>           myPositions;
+   QVector<QVector3D>           myRotationVectors;
+   QVector<qreal>               myRotationAnglesInDegrees;
+   QVector<qreal>               myScales;
+   QVector<QMatrix4x4>          myModelMatrices;
+   QVector<QMatrix4x4>          myWorldMatrices;
+   QVector<QVector4D>           myLocalBoundingSpheres;
+   QVector<QSimMaterialHandle>  myMaterialStandardHandles;
+   QVector<QSimMaterialHandle>  myMaterialHighlightHandles;
+   QVector<QSimTextureHandle>   myTextureHandles;
+   QVector<QGLAbstractEffect*>  myAbstractEffects;
+   QVector<int>                 myNumberOfDrawCalls;
+   QVector<int>                 myNumberOfTrianglesOrMinus1;
+   QVector<QSimSceneNodeHandle> myHandlesInPickBuffer;
+
+   // IDs of removed entities (reused before the arrays grow).
+   // An ID whose generation has used all 9 bits is retired rather than reused, so an old handle can never match a new object.
+   QVector<QSimSceneEntityId>  myFreeSceneEntityIds;
+   unsigned int                myNumberOfRetiredSceneEntityIds;
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMSCENESTORE_H__
+//--------------------------------------------------------------------------
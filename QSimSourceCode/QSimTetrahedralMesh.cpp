@@ -0,0 +1,299 @@
+//-----------------------------------------------------------------------------
+// File:     QSimTetrahedralMesh.cpp
+// Class:    QSimTetrahedralMesh
+// Parents:  QGLSceneNode
+// Purpose:  Volume mesh of tetrahedra sharing vertices, drawn as its boundary faces (in one buffer) colored by element quality.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include <QtConcurrentRun>
+#include <algorithm>
+#include "QSimTetrahedralMesh.h"
+#include "QSimSceneNode.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+// Vertices of each face of a tetrahedron, counter-clockwise viewed from outside if its signed volume is positive (the same faces as QGLTetrahedron).
+static const int  QSimTetrahedronFaceVertices[4][3] = { {0,1,2}, {0,3,1}, {0,2,3}, {1,3,2} };
+
+
+//------------------------------------------------------------------------------
+QSimTetrahedralMesh::QSimTetrahedralMesh( QObject* parent ) : QGLSceneNode(parent)
+{
+   myTotalVolume = myMinimumQuality = myMeanQuality = 0;
+   myNumberOfNegativeVolumeTetrahedra = 0;
+   myPoorQualityThreshold = 0;
+   myIsColoredByQuality = true;
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimTetrahedralMesh::SetTetrahedralMesh( const QVector3DArray& vertices, const QVector<int>& tetrahedronVertexIndices )
+{
+   const int numberOfVertices = vertices.count();
+   const int numberOfIndices = tetrahedronVertexIndices.count();
+   if( numberOfIndices < 4 || numberOfIndices % 4 != 0 ) return false;
+   const int* indices = tetrahedronVertexIndices.constData();
+   for( int i=0;  i < numberOfIndices;  i++ ) if( indices[i] < 0 || indices[i] >= numberOfVertices ) return false;
+   myVertices = vertices;
+   myTetrahedronVertexIndices = tetrahedronVertexIndices;
+   this->CalculateVolumesAndQualities();
+   this->FindBoundaryFaces();
+   this->UpdateFacesGeometry();
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+// A range of tetrahedra whose volumes and qualities are calculated on one worker thread (with statistics for just this range).
+struct QSimTetrahedronQualityRange
+{
+   const QVector3D*  myVertices;
+   const int*        myTetrahedronVertexIndices;
+   qreal*            myVolumes;
+   qreal*            myQualities;
+   int               myFirstTetrahedron,  myEndTetrahedron;
+   qreal             myTotalVolume,  myMinimumQuality,  mySumOfQualities;
+   int               myNumberOfNegativeVolumeTetrahedra;
+};
+
+
+//------------------------------------------------------------------------------
+static void  CalculateVolumesAndQualitiesInRange( QSimTetrahedronQualityRange* range )
+{
+   // The loop has no branches other than the conditional expressions, and reads the shared arrays in order of the tetrahedra.
+   const qreal qualityScale = 6 * sqrt( 2.0 );
+   const QVector3D* vertices = range->myVertices;
+   qreal totalVolume = 0,  minimumQuality = 1,  sumOfQualities = 0;
+   int numberOfNegativeVolumeTetrahedra = 0;
+   for( int t = range->myFirstTetrahedron;  t < range->myEndTetrahedron;  t++ )
+   {
+      const int* v = range->myTetrahedronVertexIndices + 4*t;
+      const QVector3D& p0 = vertices[ v[0] ];
+      const QVector3D& p1 = vertices[ v[1] ];
+      const QVector3D& p2 = vertices[ v[2] ];
+      const QVector3D& p3 = vertices[ v[3] ];
+      const QVector3D e01 = p1 - p0,  e02 = p2 - p0,  e03 = p3 - p0,  e12 = p2 - p1,  e13 = p3 - p1,  e23 = p3 - p2;
+      const qreal volume = -1.0 / 6.0 * QVector3D::dotProduct( QVector3D::crossProduct( e01, e02 ), e03 );
+      const qreal meanSquaredEdgeLength = ( e01.lengthSquared() + e02.lengthSquared() + e03.lengthSquared() + e12.lengthSquared() + e13.lengthSquared() + e23.lengthSquared() ) / 6;
+      const qreal rmsEdgeLengthCubed = meanSquaredEdgeLength * sqrt( meanSquaredEdgeLength );
+      const qreal quality = rmsEdgeLengthCubed > 0 ? qualityScale * volume / rmsEdgeLengthCubed : 0;
+      range->myVolumes[t] = volume;
+      range->myQualities[t] = quality;
+      totalVolume += volume;
+      sumOfQualities += quality;
+      minimumQuality = quality < minimumQuality ? quality : minimumQuality;
+      numberOfNegativeVolumeTetrahedra += volume < 0 ? 1 : 0;
+   }
+   range->myTotalVolume = totalVolume;
+   range->myMinimumQuality = minimumQuality;
+   range->mySumOfQualities = sumOfQualities;
+   range->myNumberOfNegativeVolumeTetrahedra = numberOfNegativeVolumeTetrahedra;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTetrahedralMesh::CalculateVolumesAndQualities()
+{
+   // Ranges of at least 64K tetrahedra (so small meshes are not split), and several per worker thread (so threads finish together).
+   const int numberOfTetrahedra = this->GetNumberOfTetrahedra();
+   myVolumes.resize( numberOfTetrahedra );
+   myQualities.resize( numberOfTetrahedra );
+   const int numberOfRanges = qBound( 1, numberOfTetrahedra / 65536, 4 * qMax( 1, QThread::idealThreadCount() ) );
+   QVector<QSimTetrahedronQualityRange> ranges( numberOfRanges );
+   QList< QFuture<void> > futures;
+   for( int i=0;  i < numberOfRanges;  i++ )
+   {
+      QSimTetrahedronQualityRange& range = ranges[i];
+      range.myVertices = myVertices.constData();
+      range.myTetrahedronVertexIndices = myTetrahedronVertexIndices.constData();
+      range.myVolumes = myVolumes.data();
+      range.myQualities = myQualities.data();
+      range.myFirstTetrahedron = (int)( (qint64)numberOfTetrahedra * i / numberOfRanges );
+      range.myEndTetrahedron   = (int)( (qint64)numberOfTetrahedra * (i+1) / numberOfRanges );
+      futures.append( QtConcurrent::run( CalculateVolumesAndQualitiesInRange, &range ) );
+   }
+
+   // Combine the statistics of the ranges.
+   qreal sumOfQualities = 0;
+   myTotalVolume = 0;
+   myMinimumQuality = 1;
+   myNumberOfNegativeVolumeTetrahedra = 0;
+   for( int i=0;  i < numberOfRanges;  i++ )
+   {
+      futures[i].waitForFinished();
+      myTotalVolume += ranges[i].myTotalVolume;
+      myMinimumQuality = qMin( myMinimumQuality, ranges[i].myMinimumQuality );
+      sumOfQualities += ranges[i].mySumOfQualities;
+      myNumberOfNegativeVolumeTetrahedra += ranges[i].myNumberOfNegativeVolumeTetrahedra;
+   }
+   myMeanQuality = numberOfTetrahedra > 0 ? sumOfQualities / numberOfTetrahedra : 0;
+}
+
+
+//------------------------------------------------------------------------------
+// A face of a tetrahedron, identified by its vertices in increasing order (so the same face of two tetrahedra compares equal).
+struct QSimTetrahedronFace
+{
+   int  mySortedVertices[3];
+   int  myFace;   // 4 * tetrahedron + face of the tetrahedron.
+   bool  HasSameVertices( const QSimTetrahedronFace& other ) const  { return mySortedVertices[0] == other.mySortedVertices[0] && mySortedVertices[1] == other.mySortedVertices[1] && mySortedVertices[2] == other.mySortedVertices[2]; }
+   bool  operator<( const QSimTetrahedronFace& other ) const
+   {
+      if( mySortedVertices[0] != other.mySortedVertices[0] ) return mySortedVertices[0] < other.mySortedVertices[0];
+      if( mySortedVertices[1] != other.mySortedVertices[1] ) return mySortedVertices[1] < other.mySortedVertices[1];
+      return mySortedVertices[2] < other.mySortedVertices[2];
+   }
+};
+
+
+//------------------------------------------------------------------------------
+void  QSimTetrahedralMesh::FindBoundaryFaces()
+{
+   // Sorting all faces puts the faces shared by two tetrahedra next to each other, so a face that is alone is on the boundary.
+   const int numberOfFaces = 4 * this->GetNumberOfTetrahedra();
+   const int* indices = myTetrahedronVertexIndices.constData();
+   QVector<QSimTetrahedronFace> faces( numberOfFaces );
+   for( int f=0;  f < numberOfFaces;  f++ )
+   {
+      const int* faceVertices = QSimTetrahedronFaceVertices[ f % 4 ];
+      int a = indices[ 4*(f/4) + faceVertices[0] ],  b = indices[ 4*(f/4) + faceVertices[1] ],  c = indices[ 4*(f/4) + faceVertices[2] ];
+      if( a > b ) qSwap( a, b );
+      if( b > c ) qSwap( b, c );
+      if( a > b ) qSwap( a, b );
+      QSimTetrahedronFace& face = faces[f];
+      face.mySortedVertices[0] = a;  face.mySortedVertices[1] = b;  face.mySortedVertices[2] = c;
+      face.myFace = f;
+   }
+   std::sort( faces.begin(), faces.end() );
+   myBoundaryFaces.clear();
+   for( int i=0;  i < numberOfFaces; )
+   {
+      int j = i + 1;
+      while( j < numberOfFaces && faces[j].HasSameVertices( faces[i] ) ) ++j;
+      if( j == i + 1 ) myBoundaryFaces.append( faces[i].myFace );
+      i = j;
+   }
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTetrahedralMesh::SetPoorQualityThreshold( const qreal poorQualityThreshold )
+{
+   if( myPoorQualityThreshold == poorQualityThreshold ) return;
+   myPoorQualityThreshold = poorQualityThreshold;
+   if( this->GetNumberOfTetrahedra() == 0 ) return;
+   this->UpdateFacesGeometry();
+   QSimSceneNode* qsimSceneNode = QSimSceneNode::GetQSimSceneNodeForQGLSceneNodeOrNull( *this );
+   if( qsimSceneNode ) qsimSceneNode->SetGeometryWasChanged();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTetrahedralMesh::UpdateFacesGeometry()
+{
+   // Boundary faces of tetrahedra that are not poor, and every face of poor tetrahedra (which includes their boundary faces).
+   const int numberOfTetrahedra = this->GetNumberOfTetrahedra();
+   QVector<int> facesToDraw;
+   facesToDraw.reserve( myBoundaryFaces.count() );
+   for( int i=0;  i < myBoundaryFaces.count();  i++ ) if( !( qAbs( myQualities[ myBoundaryFaces[i] / 4 ] ) < myPoorQualityThreshold ) ) facesToDraw.append( myBoundaryFaces[i] );
+   for( int t=0;  t < numberOfTetrahedra && myPoorQualityThreshold > 0;  t++ )
+      if( qAbs( myQualities[t] ) < myPoorQualityThreshold ) for( int k=0;  k < 4;  k++ ) facesToDraw.append( 4*t + k );
+
+   // Each face has its own three vertices (with the face's normal and its tetrahedron's color), all in one buffer drawn with one call.
+   // A face of a tetrahedron with negative volume is reversed so it still faces out of the tetrahedron.
+   const int numberOfFacesToDraw = facesToDraw.count();
+   QVector3DArray positions,  normals;
+   QArray<QColor4ub> colors;
+   QGL::IndexArray indices;
+   positions.reserve( 3 * numberOfFacesToDraw );
+   normals.reserve( 3 * numberOfFacesToDraw );
+   colors.reserve( 3 * numberOfFacesToDraw );
+   indices.reserve( 3 * numberOfFacesToDraw );
+   for( int i=0;  i < numberOfFacesToDraw;  i++ )
+   {
+      const int t = facesToDraw[i] / 4;
+      const int* faceVertices = QSimTetrahedronFaceVertices[ facesToDraw[i] % 4 ];
+      const int* tetrahedronVertices = myTetrahedronVertexIndices.constData() + 4*t;
+      const bool isReversed = myVolumes[t] < 0;
+      const QVector3D& a = myVertices.at( tetrahedronVertices[ faceVertices[0] ] );
+      const QVector3D& b = myVertices.at( tetrahedronVertices[ faceVertices[isReversed ? 2 : 1] ] );
+      const QVector3D& c = myVertices.at( tetrahedronVertices[ faceVertices[isReversed ? 1 : 2] ] );
+      const QVector3D normal = QVector3D::crossProduct( b - a, c - a ).normalized();
+      const QColor4ub color = QSimTetrahedralMesh::GetColorForQuality( myQualities[t] );
+      const int firstIndex = positions.count();
+      positions.append( a, b, c );
+      normals.append( normal, normal, normal );
+      colors.append( color, color, color );
+      indices.append( firstIndex, firstIndex + 1, firstIndex + 2 );
+   }
+   QGeometryData geometry;
+   geometry.appendVertexArray( positions );
+   geometry.appendNormalArray( normals );
+   geometry.appendColorArray( colors );
+   geometry.appendIndices( indices );
+   this->setGeometry( geometry );
+   this->setStart( 0 );
+   this->setCount( indices.count() );
+   this->setDrawingMode( QGL::Triangles );
+}
+
+
+//------------------------------------------------------------------------------
+QColor4ub  QSimTetrahedralMesh::GetColorForQuality( const qreal quality )
+{
+   // Red to yellow as quality goes from 0 to 0.5, then yellow to green as it goes to 1.
+   const qreal q = qBound( (qreal)0, qAbs( quality ), (qreal)1 );
+   const int red   = q < 0.5 ? 255 : (int)( 255 * 2 * (1 - q) );
+   const int green = q < 0.5 ? (int)( 255 * 2 * q ) : 255;
+   return QColor4ub( red, green, 0 );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTetrahedralMesh::draw( QGLPainter* painter )
+{
+   // Per-vertex colors replace the material's color (while picking, the pick color is drawn as usual).
+   if( painter == NULL ) return;
+   if( !myIsColoredByQuality || painter->isPicking() ) { QGLSceneNode::draw( painter );  return; }
+   QGLAbstractEffect* previousUserEffect = painter->userEffect();
+   const QGL::StandardEffect previousStandardEffect = painter->standardEffect();
+   painter->setStandardEffect( QGL::LitPerVertexColor );
+   QGLSceneNode::draw( painter );
+   if( previousUserEffect ) painter->setUserEffect( previousUserEffect );
+   else                     painter->setStandardEffect( previousStandardEffect );
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
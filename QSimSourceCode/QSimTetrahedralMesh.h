@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// File:     QSimTetrahedralMesh.h
+// Class:    QSimTetrahedralMesh
+// Parents:  QGLSceneNode
+// Purpose:  Volume mesh of tetrahedra sharing vertices, drawn as its boundary faces (in one buffer) colored by element quality.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMTETRAHEDRALMESH_H__
+#define  QSIMTETRAHEDRALMESH_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "qglscenenode.h"
+#include "qglpainter.h"
+#include "qcolor4ub.h"
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+//------------------------------------------------------------------------------
+class QSimTetrahedralMesh : public QGLSceneNode
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimTetrahedralMesh( QObject* parent = NULL );
+  ~QSimTetrahedralMesh()  {;}
+
+   // Vertices are shared by tetrahedra, each of which is four consecutive indices into vertices.
+   // Calculates every element's volume and quality, finds the boundary faces, and builds the geometry that is drawn.
+   // Returns false (and leaves the mesh as it was) if there are no tetrahedra or an index is out of range.
+   bool  SetTetrahedralMesh( const QVector3DArray& vertices, const QVector<int>& tetrahedronVertexIndices );
+   const QVector3DArray&  GetVertices() const                  { return myVertices; }
+   const QVector<int>&    GetTetrahedronVertexIndices() const  { return myTetrahedronVertexIndices; }
+   int                    GetNumberOfVertices() const          { return myVertices.count(); }
+   int                    GetNumberOfTetrahedra() const        { return myTetrahedronVertexIndices.count() / 4; }
+
+   // Signed volume of each tetrahedron (as QGLTetrahedron::CalculateTetrahedronVolume, positive if vertices 0, 1, 2 are counter-clockwise from outside).
+   // Quality is 6*sqrt(2)*volume / (root-mean-square edge length)^3, which is 1 for a regular tetrahedron, near 0 for a sliver, and negative
+   // if the tetrahedron is inverted.  Unlike QGLTetrahedron::IsTetrahedron3DCheck it does not depend on the order of the vertices.
+   // Both are calculated for all elements in one pass over the shared arrays, split into ranges on worker threads.
+   const QVector<qreal>&  GetVolumes() const    { return myVolumes; }
+   const QVector<qreal>&  GetQualities() const  { return myQualities; }
+   qreal  GetTotalVolume() const                        { return myTotalVolume; }
+   qreal  GetMinimumQuality() const                     { return myMinimumQuality; }
+   qreal  GetMeanQuality() const                        { return myMeanQuality; }
+   int    GetNumberOfNegativeVolumeTetrahedra() const   { return myNumberOfNegativeVolumeTetrahedra; }
+
+   // Faces on the boundary (belonging to one tetrahedron) are drawn.  So are all faces of tetrahedra whose absolute quality is less than
+   // the poor quality threshold (default is 0, i.e., none), which shows poor elements inside the volume.
+   void   SetPoorQualityThreshold( const qreal poorQualityThreshold );
+   qreal  GetPoorQualityThreshold() const  { return myPoorQualityThreshold; }
+   int    GetNumberOfBoundaryFaces() const  { return myBoundaryFaces.count(); }
+   int    GetNumberOfDrawnFaces() const     { return this->count() / 3; }
+
+   // Faces are colored by their tetrahedron's absolute quality (red for 0, through yellow, to green for 1), or drawn with the object's material.
+   void  SetIsColoredByQuality( const bool isColoredByQuality )  { myIsColoredByQuality = isColoredByQuality; }
+   bool  GetIsColoredByQuality() const                          { return myIsColoredByQuality; }
+   static QColor4ub  GetColorForQuality( const qreal quality );
+
+   // Draws the faces (with per-vertex colors if colored by quality).
+   virtual void  draw( QGLPainter* painter );
+
+private:
+   void  CalculateVolumesAndQualities();
+   void  FindBoundaryFaces();
+   void  UpdateFacesGeometry();
+
+   // Shared arrays, and results for each tetrahedron.
+   QVector3DArray  myVertices;
+   QVector<int>    myTetrahedronVertexIndices;
+   QVector<qreal>  myVolumes;
+   QVector<qreal>  myQualities;
+   qreal           myTotalVolume;
+   qreal           myMinimumQuality;
+   qreal           myMeanQuality;
+   int             myNumberOfNegativeVolumeTetrahedra;
+
+   // Boundary faces (4 * tetrahedron + face of the tetrahedron), and how faces are drawn.
+   QVector<int>  myBoundaryFaces;
+   qreal         myPoorQualityThreshold;
+   bool          myIsColoredByQuality;
+
+   // Disable copying.
+   QSimTetrahedralMesh( const QSimTetrahedralMesh& );
+   QSimTetrahedralMesh&  operator=( const QSimTetrahedralMesh& );
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMTETRAHEDRALMESH_H__
+//--------------------------------------------------------------------------
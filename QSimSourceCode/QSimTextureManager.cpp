@@ -0,0 +1,360 @@
+//-----------------------------------------------------------------------------
+// File:     QSimTextureManager.cpp
+// Class:    QSimTextureManager
+// Parents:  QObject
+// Purpose:  Shares textures between scene nodes, decodes image files on worker threads (with mipmaps),
+//           uploads each texture once (compressed if supported), and keeps GPU texture memory within a budget.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimTextureManager.h"
+
+// S3TC formats may not be defined in older OpenGL headers.
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT   0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT  0x83F3
+#endif
+
+// glActiveTexture (OpenGL 1.3) is not in the OpenGL 1.1 headers, so get it from the driver.
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_TEXTURE0
+#define GL_TEXTURE0                       0x84C0
+#endif
+typedef void (APIENTRY *QSimGLActiveTexture)( GLenum texture );
+static QSimGLActiveTexture  qsimGLActiveTexture = NULL;
+static bool                 qsimGLActiveTextureIsResolved = false;
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+// Largest power of two that is less than or equal to sizeInPixels (and GetMaximumTextureSize).
+static int  GetPowerOfTwoTextureSize( const int sizeInPixels )
+{
+   int powerOfTwo = 1;
+   while( 2*powerOfTwo <= sizeInPixels && 2*powerOfTwo <= QSimTextureManager::GetMaximumTextureSize() ) powerOfTwo *= 2;
+   return powerOfTwo;
+}
+
+
+//------------------------------------------------------------------------------
+// Runs on a worker thread: decode the image file directly at a (power of two) texture size, then build all mipmap levels.
+static QSimDecodedTexture  DecodeImageFileWithMipmaps( const QString imageFilename )
+{
+   QSimDecodedTexture decodedTexture;
+   decodedTexture.myImageHasAlphaChannel = false;
+
+   // Scaling while decoding (rather than afterwards) is much faster and uses less memory for large photos.
+   QImageReader imageReader( imageFilename );
+   const QSize originalSize = imageReader.size();
+   if( originalSize.isValid() )
+      imageReader.setScaledSize( QSize( GetPowerOfTwoTextureSize( originalSize.width() ), GetPowerOfTwoTextureSize( originalSize.height() ) ) );
+   QImage image = imageReader.read();
+   if( image.isNull() ) return decodedTexture;
+
+   // Some image formats ignore the scaled size.
+   const QSize textureSize( GetPowerOfTwoTextureSize( image.width() ), GetPowerOfTwoTextureSize( image.height() ) );
+   if( image.size() != textureSize ) image = image.scaled( textureSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+   decodedTexture.myImageHasAlphaChannel = image.hasAlphaChannel();
+
+   // Each mipmap level is half the size of the previous level, down to 1x1.
+   while( true )
+   {
+      decodedTexture.myMipmapLevels.append( QGLWidget::convertToGLFormat( image ) );
+      if( image.width() == 1 && image.height() == 1 ) break;
+      image = image.scaled( qMax( 1, image.width()/2 ), qMax( 1, image.height()/2 ), Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+   }
+   return decodedTexture;
+}
+
+
+//------------------------------------------------------------------------------
+QSimTextureManager::QSimTextureManager() : QObject(NULL)
+{
+   // Entry 0 is a placeholder so that handle 0 can mean "no texture".
+   QSimTextureEntry noTextureEntry;
+   noTextureEntry.myImageHasAlphaChannel = false;
+   noTextureEntry.myDecodeWatcherOrNull = NULL;
+   noTextureEntry.myDecodeFailed = false;
+   noTextureEntry.myGLTextureId = 0;
+   noTextureEntry.myTextureMemoryInBytes = 0;
+   noTextureEntry.myLastFrameNumberUsed = 0;
+   noTextureEntry.myReferenceCount = 0;
+   myTextureEntries.append( noTextureEntry );
+
+   // Default budget is 128 MB of texture memory.
+   myTextureMemoryBudgetInBytes = 128 * 1024 * 1024;
+   myResidentTextureMemoryInBytes = 0;
+   myCurrentFrameNumber = 0;
+   myNumberOfUploadsInCurrentFrame = 0;
+   myDriverSupportsS3TCCompression = -1;
+}
+
+
+//------------------------------------------------------------------------------
+QSimTextureManager::~QSimTextureManager()
+{
+   // OpenGL textures are freed with the OpenGL context (which may not be current here).
+   // Decoding in progress finishes on its worker thread and the result is discarded.
+   const int numberOfEntries = myTextureEntries.count();
+   for( int i=1;  i < numberOfEntries;  i++ )
+      delete myTextureEntries[i].myDecodeWatcherOrNull;
+}
+
+
+//------------------------------------------------------------------------------
+QSimTextureHandle  QSimTextureManager::AcquireTexture( const QString& imageFilename )
+{
+   if( imageFilename.isEmpty() ) return 0;
+
+   // Objects that use the same image file share one texture.
+   QHash<QString, QSimTextureHandle>::const_iterator it = myHandlesForImageFilenames.constFind( imageFilename );
+   if( it != myHandlesForImageFilenames.constEnd() ) return this->AcquireTexture( it.value() );
+
+   // Reuse an entry that is no longer referenced, or add a new entry.
+   QSimTextureHandle handle;
+   if( !myFreeHandles.isEmpty() )
+   {
+      handle = myFreeHandles.last();
+      myFreeHandles.pop_back();
+   }
+   else
+   {
+      // Every handle is in use (handles are unsigned short), so the object gets no texture rather than a handle that wraps around to a live entry.
+      if( myTextureEntries.count() > 0xFFFF ) { qWarning( "QSimTextureManager: Too many textures to load %s", qPrintable( imageFilename ) );  return 0; }
+      QSimTextureEntry newEntry;
+      newEntry.myDecodeWatcherOrNull = NULL;
+      newEntry.myDecodeFailed = false;
+      newEntry.myGLTextureId = 0;
+      handle = (QSimTextureHandle)myTextureEntries.count();
+      myTextureEntries.append( newEntry );
+   }
+
+   QSimTextureEntry& entry = myTextureEntries[handle];
+   entry.myImageFilename = imageFilename;
+   entry.myImageHasAlphaChannel = false;
+   entry.myDecodeFailed = false;
+   entry.myTextureMemoryInBytes = 0;
+   entry.myLastFrameNumberUsed = myCurrentFrameNumber;
+   entry.myReferenceCount = 1;
+   myHandlesForImageFilenames.insert( imageFilename, handle );
+
+   // Decode the image file on a worker thread so the user interface does not stall.
+   entry.myDecodeWatcherOrNull = new QFutureWatcher<QSimDecodedTexture>( this );
+   QObject::connect( entry.myDecodeWatcherOrNull, SIGNAL(finished()), this, SLOT(DecodedTextureIsReadySlot()) );
+   entry.myDecodeWatcherOrNull->setFuture( QtConcurrent::run( DecodeImageFileWithMipmaps, imageFilename ) );
+   return handle;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTextureManager::ReleaseTexture( const QSimTextureHandle handle )
+{
+   if( handle == 0 ) return;
+   QSimTextureEntry& entry = myTextureEntries[handle];
+   if( entry.myReferenceCount == 0 || --(entry.myReferenceCount) > 0 ) return;
+
+   // No scene node uses this texture, so free its GPU and CPU memory and allow the entry to be reused.
+   // If the image is still being decoded, the result is discarded.
+   if( entry.myDecodeWatcherOrNull ) { entry.myDecodeWatcherOrNull->disconnect( this );  entry.myDecodeWatcherOrNull->deleteLater();  entry.myDecodeWatcherOrNull = NULL; }
+   this->EvictTexture( entry );
+   entry.myMipmapLevels.clear();
+   myHandlesForImageFilenames.remove( entry.myImageFilename );
+   entry.myImageFilename.clear();
+   myFreeHandles.append( handle );
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTextureManager::DecodedTextureIsReadySlot()
+{
+   // Collect the results of all decodes that have finished (the texture is uploaded when it is next drawn).
+   const int numberOfEntries = myTextureEntries.count();
+   for( int i=1;  i < numberOfEntries;  i++ )
+   {
+      QSimTextureEntry& entry = myTextureEntries[i];
+      if( entry.myDecodeWatcherOrNull == NULL || !entry.myDecodeWatcherOrNull->isFinished() ) continue;
+      const QSimDecodedTexture decodedTexture = entry.myDecodeWatcherOrNull->result();
+      entry.myMipmapLevels = decodedTexture.myMipmapLevels;
+      entry.myImageHasAlphaChannel = decodedTexture.myImageHasAlphaChannel;
+      entry.myDecodeWatcherOrNull->deleteLater();
+      entry.myDecodeWatcherOrNull = NULL;
+      entry.myDecodeFailed = entry.myMipmapLevels.isEmpty();
+      if( entry.myDecodeFailed ) qWarning( "QSimTextureManager: Cannot load %s", qPrintable( entry.myImageFilename ) );
+   }
+   emit TextureIsReadySignal();
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTextureManager::BeginTextureManagerFrame()
+{
+   ++myCurrentFrameNumber;
+   myNumberOfUploadsInCurrentFrame = 0;
+
+   // Delete OpenGL textures that were evicted or released since the last frame.
+   if( !myGLTextureIdsToDelete.isEmpty() )
+   {
+      glDeleteTextures( myGLTextureIdsToDelete.count(), myGLTextureIdsToDelete.constData() );
+      myGLTextureIdsToDelete.resize( 0 );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Select texture unit 0 (an effect drawn earlier may have left another unit active).  Without glActiveTexture, there is only unit 0.
+static void  SelectTextureUnit0()
+{
+   if( !qsimGLActiveTextureIsResolved )
+   {
+      const QGLContext* context = QGLContext::currentContext();
+      if( context == NULL ) return;
+      qsimGLActiveTexture = (QSimGLActiveTexture) context->getProcAddress( "glActiveTexture" );
+      qsimGLActiveTextureIsResolved = true;
+   }
+   if( qsimGLActiveTexture ) qsimGLActiveTexture( GL_TEXTURE0 );
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimTextureManager::BindTexture( const QSimTextureHandle handle )
+{
+   if( !this->IsTextureReady( handle ) ) return false;
+   SelectTextureUnit0();
+   QSimTextureEntry& entry = myTextureEntries[handle];
+   entry.myLastFrameNumberUsed = myCurrentFrameNumber;
+   if( entry.myGLTextureId == 0 && !this->MakeTextureResident( entry ) ) return false;
+   glBindTexture( GL_TEXTURE_2D, entry.myGLTextureId );
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+GLenum  QSimTextureManager::GetInternalFormatForUpload( const bool imageHasAlphaChannel )
+{
+   // Check the driver's extensions once (requires a current OpenGL context).
+   if( myDriverSupportsS3TCCompression == -1 )
+   {
+      const QByteArray extensions( (const char*)glGetString( GL_EXTENSIONS ) );
+      myDriverSupportsS3TCCompression = extensions.contains( "GL_EXT_texture_compression_s3tc" ) ? 1 : 0;
+   }
+
+   // The driver compresses the RGBA data as it is uploaded (4 or 8 bits per pixel rather than 32).
+   if( myDriverSupportsS3TCCompression == 1 ) return imageHasAlphaChannel ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+   return GL_RGBA;
+}
+
+
+//------------------------------------------------------------------------------
+qint64  QSimTextureManager::GetTextureMemoryInBytes( const QSimTextureEntry& entry, const GLenum internalFormat ) const
+{
+   // Sum the memory for all mipmap levels (S3TC stores each 4x4 block of pixels in 8 bytes for DXT1 or 16 bytes for DXT5).
+   qint64 textureMemoryInBytes = 0;
+   const int numberOfLevels = entry.myMipmapLevels.count();
+   for( int level=0;  level < numberOfLevels;  level++ )
+   {
+      const QImage& image = entry.myMipmapLevels[level];
+      const qint64 numberOfBlocks = (qint64)( (image.width()+3)/4 ) * ( (image.height()+3)/4 );
+      if( internalFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT )        textureMemoryInBytes += 8 * numberOfBlocks;
+      else if( internalFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT )  textureMemoryInBytes += 16 * numberOfBlocks;
+      else                                                           textureMemoryInBytes += (qint64)image.width() * image.height() * 4;
+   }
+   return textureMemoryInBytes;
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimTextureManager::MakeTextureResident( QSimTextureEntry& entry )
+{
+   if( entry.myMipmapLevels.isEmpty() ) return false;
+
+   // Make room for this texture.
+   const GLenum internalFormat = this->GetInternalFormatForUpload( entry.myImageHasAlphaChannel );
+   entry.myTextureMemoryInBytes = this->GetTextureMemoryInBytes( entry, internalFormat );
+   this->EvictTexturesToFitInBudget( entry.myTextureMemoryInBytes );
+
+   // Upload every mipmap level (built on the worker thread) and use trilinear filtering so minified textures do not shimmer.
+   glGenTextures( 1, &entry.myGLTextureId );
+   glBindTexture( GL_TEXTURE_2D, entry.myGLTextureId );
+   glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+   glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+   glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+   glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+   const int numberOfLevels = entry.myMipmapLevels.count();
+   for( int level=0;  level < numberOfLevels;  level++ )
+   {
+      const QImage& image = entry.myMipmapLevels[level];
+      glTexImage2D( GL_TEXTURE_2D, level, internalFormat, image.width(), image.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, image.constBits() );
+   }
+
+   myResidentTextureMemoryInBytes += entry.myTextureMemoryInBytes;
+   ++myNumberOfUploadsInCurrentFrame;
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTextureManager::EvictTexture( QSimTextureEntry& entry )
+{
+   if( entry.myGLTextureId == 0 ) return;
+   myGLTextureIdsToDelete.append( entry.myGLTextureId );
+   entry.myGLTextureId = 0;
+   myResidentTextureMemoryInBytes -= entry.myTextureMemoryInBytes;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimTextureManager::EvictTexturesToFitInBudget( const qint64 additionalBytesNeeded )
+{
+   // Evict the least recently used resident texture until there is room (textures used in the current frame are not evicted).
+   // The number of textures is small (tens), so a linear search for the oldest texture is fast.
+   const int numberOfEntries = myTextureEntries.count();
+   while( myResidentTextureMemoryInBytes + additionalBytesNeeded > myTextureMemoryBudgetInBytes )
+   {
+      QSimTextureEntry* leastRecentlyUsedEntry = NULL;
+      for( int i=1;  i < numberOfEntries;  i++ )
+      {
+         QSimTextureEntry& entry = myTextureEntries[i];
+         if( entry.myGLTextureId == 0 || entry.myLastFrameNumberUsed == myCurrentFrameNumber ) continue;
+         if( leastRecentlyUsedEntry == NULL || entry.myLastFrameNumberUsed < leastRecentlyUsedEntry->myLastFrameNumberUsed ) leastRecentlyUsedEntry = &entry;
+      }
+      if( leastRecentlyUsedEntry == NULL ) break;
+      this->EvictTexture( *leastRecentlyUsedEntry );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
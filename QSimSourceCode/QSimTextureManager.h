@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------------
+// File:     QSimTextureManager.h
+// Class:    QSimTextureManager
+// Parents:  QObject
+// Purpose:  Shares textures between scene nodes, decodes image files on worker threads (with mipmaps),
+//           uploads each texture once (compressed if supported), and keeps GPU texture memory within a budget.
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMTEXTUREMANAGER_H__
+#define  QSIMTEXTUREMANAGER_H__
+#include <QtCore>
+#include <QtGui>
+#include <QtOpenGL>
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+// Scene nodes refer to textures by a handle.  Handle 0 means the scene node has no texture.
+typedef unsigned short  QSimTextureHandle;
+
+// Result of decoding an image file on a worker thread: all mipmap levels (largest first) in OpenGL's RGBA format.
+struct QSimDecodedTexture
+{
+   QList<QImage>  myMipmapLevels;
+   bool           myImageHasAlphaChannel;
+};
+
+
+//------------------------------------------------------------------------------
+class QSimTextureManager : public QObject
+{
+   Q_OBJECT
+
+public:
+   // Constructors and destructors.
+   QSimTextureManager();
+  ~QSimTextureManager();
+
+   // Get a handle to the texture for this image file, sharing the texture if the same file is already in use.
+   // The file is decoded on a worker thread, so the texture is not ready immediately (TextureIsReadySignal is emitted when it is).
+   // Each acquired handle holds one reference, which must be released when no longer needed.
+   // Returns 0 (no texture) if the filename is empty or every handle is in use.
+   QSimTextureHandle  AcquireTexture( const QString& imageFilename );
+   QSimTextureHandle  AcquireTexture( const QSimTextureHandle handle )  { if( handle ) ++(myTextureEntries[handle].myReferenceCount);  return handle; }
+   void               ReleaseTexture( const QSimTextureHandle handle );
+
+   // Image file of the texture (e.g., to save it in a scene file).  Handle 0 (no texture) has no filename.
+   QString  GetTextureImageFilename( const QSimTextureHandle handle ) const  { return handle ? myTextureEntries[handle].myImageFilename : QString(); }
+
+   // Whether the texture has been decoded and can be bound (objects whose texture is not yet ready are drawn without it).
+   bool  IsTextureReady( const QSimTextureHandle handle ) const  { return handle != 0 && ( myTextureEntries[handle].myGLTextureId != 0 || !myTextureEntries[handle].myMipmapLevels.isEmpty() ); }
+
+   // Whether the image file could not be read or decoded (the texture never becomes ready, and objects that use it are drawn without it).
+   bool  HasTextureDecodeFailed( const QSimTextureHandle handle ) const  { return handle != 0 && myTextureEntries[handle].myDecodeFailed; }
+
+   // Call once at the start of each frame with the OpenGL context current (used to decide which textures were least recently used).
+   void  BeginTextureManagerFrame();
+
+   // Bind the texture to texture unit 0 of the current OpenGL context, first uploading it if it is not resident on the GPU.
+   // Uploading may evict least recently used textures (not used in the current frame) to stay within the memory budget.
+   bool  BindTexture( const QSimTextureHandle handle );
+
+   // Budget (in bytes) for textures resident on the GPU.  A texture that is used in the current frame is never evicted, so the budget may be exceeded temporarily.
+   void    SetTextureMemoryBudgetInBytes( const qint64 budgetInBytes )  { myTextureMemoryBudgetInBytes = budgetInBytes;  this->EvictTexturesToFitInBudget( 0 ); }
+   qint64  GetTextureMemoryBudgetInBytes() const                        { return myTextureMemoryBudgetInBytes; }
+
+   // Statistics (helpful for profiling).
+   qint64        GetResidentTextureMemoryInBytes() const          { return myResidentTextureMemoryInBytes; }
+   unsigned int  GetNumberOfTextures() const                      { return myTextureEntries.count() - 1 - myFreeHandles.count(); }
+   unsigned int  GetNumberOfUploadsInCurrentFrame() const         { return myNumberOfUploadsInCurrentFrame; }
+
+   // Decoded images are scaled down (to a power of two) so their width and height are no larger than this.
+   static int  GetMaximumTextureSize()  { return 2048; }
+
+signals:
+   void  TextureIsReadySignal();
+
+private slots:
+   void  DecodedTextureIsReadySlot();
+
+private:
+   // Each entry keeps its decoded mipmap levels in CPU memory so an evicted texture can be uploaded again when it is next drawn.
+   // myGLTextureId is 0 when the texture is not resident on the GPU.
+   // myDecodeWatcherOrNull is not NULL while the image file is being decoded on a worker thread.
+   struct QSimTextureEntry
+   {
+      QString                              myImageFilename;
+      QList<QImage>                        myMipmapLevels;
+      bool                                 myImageHasAlphaChannel;
+      QFutureWatcher<QSimDecodedTexture>*  myDecodeWatcherOrNull;
+      bool                                 myDecodeFailed;
+      GLuint                               myGLTextureId;
+      qint64                               myTextureMemoryInBytes;
+      unsigned int                         myLastFrameNumberUsed;
+      unsigned int                         myReferenceCount;
+   };
+   QVector<QSimTextureEntry>          myTextureEntries;
+   QVector<QSimTextureHandle>         myFreeHandles;
+   QHash<QString, QSimTextureHandle>  myHandlesForImageFilenames;
+
+   // Upload or remove a texture from the GPU.
+   bool    MakeTextureResident( QSimTextureEntry& entry );
+   void    EvictTexture( QSimTextureEntry& entry );
+   void    EvictTexturesToFitInBudget( const qint64 additionalBytesNeeded );
+   qint64  GetTextureMemoryInBytes( const QSimTextureEntry& entry, const GLenum internalFormat ) const;
+
+   // OpenGL textures are only deleted at the start of a frame (when the OpenGL context is known to be current).
+   QVector<GLuint>  myGLTextureIdsToDelete;
+
+   // Whether the OpenGL driver can compress textures as they are uploaded (-1 means not yet determined).
+   int     myDriverSupportsS3TCCompression;
+   GLenum  GetInternalFormatForUpload( const bool imageHasAlphaChannel );
+
+   // Residency and statistics.
+   qint64        myTextureMemoryBudgetInBytes;
+   qint64        myResidentTextureMemoryInBytes;
+   unsigned int  myCurrentFrameNumber;
+   unsigned int  myNumberOfUploadsInCurrentFrame;
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMTEXTUREMANAGER_H__
+//--------------------------------------------------------------------------
@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------------
+// File:     QSimThumbnailCache.cpp
+// Class:    QSimThumbnailCache
+// Parents:  QObject
+// Purpose:  Makes small preview images of image files on worker threads and caches them on disk (keyed by path and modification time).
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#include "QSimThumbnailCache.h"
+#include "QSimResourcePack.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+QSimThumbnailCache&  QSimThumbnailCache::GetQSimThumbnailCache()  { static QSimThumbnailCache thumbnailCache;  return thumbnailCache; }
+
+
+//------------------------------------------------------------------------------
+QSimThumbnailCache::QSimThumbnailCache() : QObject(NULL)
+{
+   // Thumbnails are stored in the platform's cache directory (if it is not available, thumbnails are only cached in memory).
+   const QString cacheLocation = QDesktopServices::storageLocation( QDesktopServices::CacheLocation );
+   if( !cacheLocation.isEmpty() && QDir().mkpath( cacheLocation + "/Thumbnails" ) )
+      myDiskCacheDirectory = cacheLocation + "/Thumbnails";
+}
+
+
+//------------------------------------------------------------------------------
+QString  QSimThumbnailCache::GetDiskCacheFilename( const QString& imageFilename ) const
+{
+   if( myDiskCacheDirectory.isEmpty() ) return QString();
+
+   // Built-in images (in the resource pack, e.g., ":/TextureGraphics/...") change only when the resource pack changes.
+   QFileInfo imageFileInfo( imageFilename );
+   const QSimResourcePack& resourcePack = QSimResourcePack::GetQSimResourcePack();
+   const QDateTime lastModified = !imageFilename.startsWith( ":" ) ? imageFileInfo.lastModified() : resourcePack.IsResourcePackOpen() ? resourcePack.GetResourcePackLastModified() : QFileInfo( QCoreApplication::applicationFilePath() ).lastModified();
+
+   // The key is a hash of the path, modification time, and thumbnail size, so a changed image gets a new thumbnail.
+   QByteArray key = imageFileInfo.absoluteFilePath().toUtf8();
+   key += '|' + lastModified.toString( Qt::ISODate ).toUtf8() + '|' + QByteArray::number( QSimThumbnailCache::GetThumbnailSize() );
+   return myDiskCacheDirectory + "/" + QCryptographicHash::hash( key, QCryptographicHash::Md5 ).toHex() + ".png";
+}
+
+
+//------------------------------------------------------------------------------
+bool  QSimThumbnailCache::RequestThumbnail( const QString& imageFilename )
+{
+   // Thumbnails that are already in memory are ready immediately.
+   QHash<QString, QImage>::const_iterator it = myThumbnailsInMemory.constFind( imageFilename );
+   if( it != myThumbnailsInMemory.constEnd() ) { emit ThumbnailIsReadySignal( imageFilename, it.value() );  return true; }
+
+   // Only check that the image file is readable (this reads the file header, not the whole image).
+   if( !QImageReader( imageFilename ).canRead() ) return false;
+
+   // Do not start a second worker for an image that is already being processed.
+   if( myImageFilenamesForPendingThumbnails.key( imageFilename, NULL ) != NULL ) return true;
+
+   // Make (or read) the thumbnail on a worker thread so the user interface does not stall.
+   QFutureWatcher<QImage>* watcher = new QFutureWatcher<QImage>( this );
+   myImageFilenamesForPendingThumbnails.insert( watcher, imageFilename );
+   QObject::connect( watcher, SIGNAL(finished()), this, SLOT(ThumbnailIsReadySlot()) );
+   watcher->setFuture( QtConcurrent::run( QSimThumbnailCache::GetThumbnailFromDiskCacheOrImageFile, imageFilename, this->GetDiskCacheFilename( imageFilename ) ) );
+   return true;
+}
+
+
+//------------------------------------------------------------------------------
+void  QSimThumbnailCache::ThumbnailIsReadySlot()
+{
+   QFutureWatcher<QImage>* watcher = static_cast< QFutureWatcher<QImage>* >( this->sender() );
+   const QString imageFilename = myImageFilenamesForPendingThumbnails.take( watcher );
+   const QImage thumbnail = watcher->result();
+   watcher->deleteLater();
+
+   if( thumbnail.isNull() ) return;
+   myThumbnailsInMemory.insert( imageFilename, thumbnail );
+   emit ThumbnailIsReadySignal( imageFilename, thumbnail );
+}
+
+
+//------------------------------------------------------------------------------
+QImage  QSimThumbnailCache::GetThumbnailFromDiskCacheOrImageFile( const QString imageFilename, const QString diskCacheFilename )
+{
+   // Use the thumbnail in the disk cache, if there is one.
+   QImage thumbnail;
+   if( !diskCacheFilename.isEmpty() && thumbnail.load( diskCacheFilename ) ) return thumbnail;
+
+   // Otherwise decode the image directly at thumbnail size (much faster than decoding at full size and scaling, especially for JPEG).
+   const int thumbnailSize = QSimThumbnailCache::GetThumbnailSize();
+   QImageReader imageReader( imageFilename );
+   const QSize originalSize = imageReader.size();
+   if( originalSize.isValid() && ( originalSize.width() > thumbnailSize || originalSize.height() > thumbnailSize ) )
+      imageReader.setScaledSize( originalSize.scaled( thumbnailSize, thumbnailSize, Qt::KeepAspectRatio ) );
+   thumbnail = imageReader.read();
+   if( thumbnail.isNull() ) return thumbnail;
+
+   // Some image formats ignore the scaled size.
+   if( thumbnail.width() > thumbnailSize || thumbnail.height() > thumbnailSize )
+      thumbnail = thumbnail.scaled( thumbnailSize, thumbnailSize, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+
+   // Save it for next time (if this fails, the thumbnail is still used).
+   if( !diskCacheFilename.isEmpty() ) thumbnail.save( diskCacheFilename, "PNG" );
+   return thumbnail;
+}
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
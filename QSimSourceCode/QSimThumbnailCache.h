@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+// File:     QSimThumbnailCache.h
+// Class:    QSimThumbnailCache
+// Parents:  QObject
+// Purpose:  Makes small preview images of image files on worker threads and caches them on disk (keyed by path and modification time).
+/* ---------------------------------------------------------------------------- *
+* QSim was developed with support from Simbios (NIH Center for Physics-Based    *
+* Simulation of Biological Structures at Stanford) under NIH Roadmap for        *
+* Medical Research grant U54 GM072970 and NCSRR (National Center for Simulation *
+* in Rehabilitation Research) NIH research infrastructure grant R24 HD065690.   *
+*                                                                               *
+* To the extent possible under law, the author(s) and contributor(s) have       *
+* dedicated all copyright and related and neighboring rights to this software   *
+* to the public domain worldwide. This software is distributed without warranty.*
+*                                                                               *
+* Authors: Paul Mitiguy (2011)                                                  *
+* Contributors: Ayman Habib, Michael Sherman                                    *
+*                                                                               *
+* Permission is granted, free of charge, to any person obtaining a copy of this *
+* software and associated documentation files (the "Software"), to deal in the  *
+* Software without restriction, including without limitation the rights to use, *
+* copy, modify, merge, publish, distribute, sublicense, and/or sell copies of   *
+* the Software and to permit persons to whom the Software is furnished to do so.*
+*                                                                               *
+* Include this sentence, the above public domain and permission notices, and the*
+* following disclaimer in all copies or substantial portions of the Software.   *
+*                                                                               *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR    *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,      *
+* FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE  *
+* AUTHORS OR CONTRIBUTORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,  *
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR  *
+* IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. *
+* ----------------------------------------------------------------------------- */
+#ifndef  QSIMTHUMBNAILCACHE_H__
+#define  QSIMTHUMBNAILCACHE_H__
+#include <QtCore>
+#include <QtGui>
+#include "CppStandardHeaders.h"
+
+
+//------------------------------------------------------------------------------
+namespace QSim {
+
+
+//------------------------------------------------------------------------------
+class QSimThumbnailCache : public QObject
+{
+   Q_OBJECT
+
+public:
+   // There is one thumbnail cache that is shared by all image viewer dialogs (it is only used from the GUI thread).
+   static QSimThumbnailCache&  GetQSimThumbnailCache();
+
+   // Request a thumbnail for an image file.  ThumbnailIsReadySignal is emitted when it is ready (immediately if it is already in memory).
+   // Returns false if the image file cannot be read.
+   bool  RequestThumbnail( const QString& imageFilename );
+
+   // Thumbnails fit in a square of this size (in pixels).
+   static int  GetThumbnailSize()  { return 96; }
+
+signals:
+   void  ThumbnailIsReadySignal( const QString& imageFilename, const QImage& thumbnail );
+
+private slots:
+   void  ThumbnailIsReadySlot();
+
+private:
+   // Constructors and destructors (use GetQSimThumbnailCache).
+   QSimThumbnailCache();
+  ~QSimThumbnailCache()  {;}
+
+   // Runs on a worker thread: read the thumbnail from the disk cache, or make it from the image file and add it to the disk cache.
+   static QImage  GetThumbnailFromDiskCacheOrImageFile( const QString imageFilename, const QString diskCacheFilename );
+
+   // Name of the file in the disk cache for this image file (changes when the image file changes).
+   QString  GetDiskCacheFilename( const QString& imageFilename ) const;
+   QString  myDiskCacheDirectory;
+
+   // Thumbnails that are ready, and thumbnails being made on worker threads.
+   QHash<QString, QImage>                   myThumbnailsInMemory;
+   QHash<QFutureWatcher<QImage>*, QString>  myImageFilenamesForPendingThumbnails;
+};
+
+
+//------------------------------------------------------------------------------
+}  // End of namespace QSim
+//--------------------------------------------------------------------------
+#endif  // QSIMTHUMBNAILCACHE_H__
+//--------------------------------------------------------------------------